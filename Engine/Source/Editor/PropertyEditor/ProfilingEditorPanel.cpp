@@ -1,6 +1,8 @@
 #include "ProfilingEditorPanel.h"
 
 #include "World.h"
+#include "Actors/Player.h"
+#include "Engine/FLoaderOBJ.h"
 #include "Engine/Octree/Octree.h"
 #include "Container/String.h"
 #include "ImGUI/imgui.h"
@@ -33,11 +35,10 @@ void ProfilingEditorPanel::Render()
         ImGui::Text("FPS (1s): %.2f", Stats.FPS_1Sec);
         ImGui::Text("FPS (5s): %.2f", Stats.FPS_5Sec);
 
-        float& firstLOD = GEngineLoop.firstLOD;
-        float& secondLOD = GEngineLoop.SecondLOD;
-        
-        ImGui::SliderFloat("First LOD", &firstLOD, 1.0f, 100.0f, "%.1f");
-        ImGui::SliderFloat("Second LOD", &secondLOD, 1.0f, 100.0f, "%.1f");
+        // 노드 경계 구의 투영 반지름(픽셀) 기준
+        ImGui::SliderFloat("LOD1 Screen Radius", &GLOD1ScreenRadius, 10.0f, 1000.0f, "%.0f px");
+        ImGui::SliderFloat("LOD2 Screen Radius", &GLOD2ScreenRadius, 1.0f, GLOD1ScreenRadius, "%.0f px");
+        ImGui::SliderFloat("LOD Hysteresis", &GLODHysteresis, 0.0f, 0.5f, "%.2f");
         //ImGui::SliderInt("VertexBuffer Depth Min", &GRenderDepthMin, 0, 5);
         //ImGui::SliderInt("VertexBuffer Depth Max", &GRenderDepthMax, 0, 5);
         ImGui::SliderInt("Depth Min", &GRenderDepthMin, 0, 5);
@@ -47,7 +48,20 @@ void ProfilingEditorPanel::Render()
         //if (ImGui::Checkbox("UseKD",&GEngineLoop.GetWorld()->SceneOctree->bUseKD));
         //if (ImGui::Checkbox("Material Sorting",&FEngineLoop::renderer.bMaterialSort));
         if (ImGui::Checkbox("Debug OctreeAABB",&FEngineLoop::renderer.bDebugOctreeAABB));
+        if (ImGui::Checkbox("Linear Octree", &GEngineLoop.GetWorld()->SceneOctree->bUseLinearOctree));
+        if (ImGui::Checkbox("Parallel Octree Build", &GEngineLoop.GetWorld()->SceneOctree->bParallelBuild));
+        // 값 변경이 끝났을 때만 재빌드 (드래그 중 매 프레임 BuildFull 방지)
+        ImGui::SliderFloat("Octree Looseness", &GEngineLoop.GetWorld()->SceneOctree->Looseness, 1.0f, 3.0f, "%.2f");
+        if (ImGui::IsItemDeactivatedAfterEdit())
+            GEngineLoop.GetWorld()->SceneOctree->BuildFull();
         if (ImGui::Checkbox("Occlusion Culling", &FEngineLoop::renderer.bOcclusionCulling));
+        if (ImGui::Checkbox("Software Occlusion", &FEngineLoop::renderer.bSoftwareOcclusion));
+        if (ImGui::Checkbox("Cluster Culling", &FEngineLoop::renderer.bClusterCulling));
+        if (ImGui::Checkbox("BVH Picking", &GEngineLoop.GetWorld()->bUseBVHPicking));
+        if (ImGui::Button("Packet Picking Benchmark"))
+            GEngineLoop.GetWorld()->GetEditorPlayer()->BenchmarkPacketPicking();
+        if (ImGui::Button("Validate Vertex Quantization"))
+            FManagerOBJ::ValidateVertexQuantization();
 
         // 드롭다운으로 StatMap 표시
         if (ImGui::CollapsingHeader("Stat Timings (ms)", ImGuiTreeNodeFlags_DefaultOpen))
@@ -65,6 +79,16 @@ void ProfilingEditorPanel::Render()
                 ImGui::Text("%s: %.3f ms", GetData(NameString), Ms);
             }
         }
+        if (ImGui::CollapsingHeader("Stat Counters", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            for (const auto& Pair : FStatRegistry::GetCounterMap())
+            {
+                FName StatName(Pair.Key);
+                FString NameString = StatName.ToString();
+
+                ImGui::Text("%s: %lld", GetData(NameString), static_cast<long long>(Pair.Value));
+            }
+        }
     }
     ImGui::End();
     ImGui::PopStyleColor();
@@ -56,6 +56,20 @@ void FSceneMgr::ParseSceneData(const FString& jsonStr)
         }
         // Primitives 처리 (C++14 스타일)
         auto primitives = j["Primitives"];
+
+        // 씬이 쓰는 OBJ를 먼저 모아 한 번에 불러옴 (파싱과 LOD 생성이 워커 풀에서 동시에 진행)
+        TArray<FString> MeshPaths;
+        for (auto it = primitives.begin(); it != primitives.end(); ++it)
+        {
+            const json& value = it.value();
+            if (value.contains("Type") && value["Type"].get<std::string>() == "StaticMeshComp")
+            {
+                std::string Path = value["ObjStaticMeshAsset"].get<std::string>();
+                MeshPaths.AddUnique("Assets/" + FString(Path.substr(Path.find_last_of("/\\") + 1)));
+            }
+        }
+        FManagerOBJ::LoadObjStaticMeshAssets(MeshPaths);
+
         for (auto it = primitives.begin(); it != primitives.end(); ++it)
         {
             int id = std::stoi(it.key());  // Key는 문자열, 숫자로 변환
@@ -0,0 +1,95 @@
+// Async/ParallelFor.cpp
+#include "ParallelFor.h"
+
+// 워커 스레드이거나 작업 실행 중인 스레드. 중첩 ParallelFor는 직렬로 처리
+static thread_local bool GIsInsideParallelFor = false;
+
+FTaskPool& FTaskPool::GetInstance()
+{
+    static FTaskPool Instance;
+    return Instance;
+}
+
+FTaskPool::FTaskPool()
+{
+    // 호출 스레드도 작업에 참여하므로 코어 수 - 1개만 생성
+    const uint32 NumCores = std::thread::hardware_concurrency();
+    const int32 NumWorkers = NumCores > 1 ? static_cast<int32>(NumCores) - 1 : 0;
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        Workers.Emplace([this]() { WorkerLoop(); });
+    }
+}
+
+FTaskPool::~FTaskPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bStop = true;
+    }
+    WakeCondition.notify_all();
+    for (std::thread& Worker : Workers)
+    {
+        if (Worker.joinable())
+            Worker.join();
+    }
+}
+
+void FTaskPool::ParallelFor(int32 Num, const std::function<void(int32)>& Body)
+{
+    if (Num <= 0) return;
+
+    if (Workers.IsEmpty() || Num == 1 || GIsInsideParallelFor)
+    {
+        for (int32 i = 0; i < Num; ++i)
+            Body(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> DispatchLock(DispatchMutex);
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        JobBody = &Body;
+        JobNum = Num;
+        NextIndex = 0;
+        ActiveWorkers = Workers.Num();
+        ++JobGeneration;
+    }
+    WakeCondition.notify_all();
+
+    RunJob();
+
+    std::unique_lock<std::mutex> Lock(Mutex);
+    DoneCondition.wait(Lock, [this]() { return ActiveWorkers == 0; });
+    JobBody = nullptr;
+}
+
+void FTaskPool::WorkerLoop()
+{
+    uint64 SeenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            WakeCondition.wait(Lock, [&]() { return bStop || JobGeneration != SeenGeneration; });
+            if (bStop) return;
+            SeenGeneration = JobGeneration;
+        }
+
+        RunJob();
+
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if (--ActiveWorkers == 0)
+            DoneCondition.notify_one();
+    }
+}
+
+void FTaskPool::RunJob()
+{
+    GIsInsideParallelFor = true;
+    for (int32 Index = NextIndex.fetch_add(1); Index < JobNum; Index = NextIndex.fetch_add(1))
+    {
+        (*JobBody)(Index);
+    }
+    GIsInsideParallelFor = false;
+}
@@ -0,0 +1,59 @@
+// Async/ParallelFor.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Core/Container/Array.h"
+
+// 엔진 전체가 공유하는 고정 크기 워커 풀. 작업은 인덱스 단위로 나눠 가져가므로
+// Body가 인덱스별로 서로 다른 곳에만 쓰면 결과는 실행 순서와 무관하게 같다.
+class FTaskPool
+{
+public:
+    static FTaskPool& GetInstance();
+    ~FTaskPool();
+
+    FTaskPool(const FTaskPool&) = delete;
+    FTaskPool& operator=(const FTaskPool&) = delete;
+
+    int32 GetNumWorkers() const { return Workers.Num(); }
+
+    //[0, Num) 범위의 Body를 워커들과 호출 스레드가 나눠 실행하고 모두 끝날 때까지 대기.
+    //작업 안에서 다시 호출하면(중첩) 그 자리에서 직렬로 실행
+    void ParallelFor(int32 Num, const std::function<void(int32)>& Body);
+
+private:
+    FTaskPool();
+    void WorkerLoop();
+    void RunJob();
+
+    TArray<std::thread> Workers;
+
+    std::mutex DispatchMutex; // 동시에 하나의 ParallelFor만 배포
+    std::mutex Mutex;
+    std::condition_variable WakeCondition;
+    std::condition_variable DoneCondition;
+
+    const std::function<void(int32)>* JobBody = nullptr;
+    int32 JobNum = 0;
+    std::atomic<int32> NextIndex = 0;
+    int32 ActiveWorkers = 0;
+    uint64 JobGeneration = 0;
+    bool bStop = false;
+};
+
+//bSingleThread면 호출 스레드에서 순서대로 실행 (직렬 빌드와 비교할 때 사용)
+inline void ParallelFor(int32 Num, const std::function<void(int32)>& Body, bool bSingleThread = false)
+{
+    if (bSingleThread)
+    {
+        for (int32 i = 0; i < Num; ++i)
+            Body(i);
+        return;
+    }
+    FTaskPool::GetInstance().ParallelFor(Num, Body);
+}
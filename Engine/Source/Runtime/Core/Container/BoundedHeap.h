@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+
+#include "Core/HAL/PlatformType.h"
+
+
+/**
+ * 호출하는 쪽이 준 버퍼 위에서 동작하는 고정 용량 이진 힙입니다.
+ * 버퍼를 빌려 쓰므로 질의마다 할당이 없습니다 (스택 배열이나 결과 배열을 그대로 사용).
+ *
+ * @tparam T 원소 타입
+ * @tparam PredicateType std::push_heap과 같은 비교자. std::less면 가장 큰 값이 Top (최대 힙)
+ */
+template <typename T, typename PredicateType = std::less<T>>
+class TBoundedHeap
+{
+public:
+    TBoundedHeap(T* InData, int32 InCapacity, PredicateType InPredicate = PredicateType())
+        : Data(InData)
+        , Capacity(InCapacity)
+        , Predicate(InPredicate)
+    {
+    }
+
+    int32 Num() const { return Count; }
+    int32 GetCapacity() const { return Capacity; }
+    bool IsEmpty() const { return Count == 0; }
+    bool IsFull() const { return Count >= Capacity; }
+
+    const T& Top() const { return Data[0]; }
+    T* GetData() { return Data; }
+    const T* GetData() const { return Data; }
+
+    /** 가득 차 있으면 false를 반환하고 아무것도 하지 않습니다 */
+    bool Push(const T& Item)
+    {
+        if (IsFull())
+            return false;
+        Data[Count++] = Item;
+        std::push_heap(Data, Data + Count, Predicate);
+        return true;
+    }
+
+    /**
+     * 가득 차 있으면 Item이 Top보다 앞설 때만 Top을 밀어내고 들어갑니다.
+     * 최대 힙이면 가장 작은 Capacity개를 유지 (k-NN 결과 집합)
+     * @return Item이 힙에 들어갔는지 여부
+     */
+    bool PushBounded(const T& Item)
+    {
+        if (!IsFull())
+            return Push(Item);
+        if (Capacity == 0 || !Predicate(Item, Data[0]))
+            return false;
+
+        std::pop_heap(Data, Data + Count, Predicate);
+        Data[Count - 1] = Item;
+        std::push_heap(Data, Data + Count, Predicate);
+        return true;
+    }
+
+    T Pop()
+    {
+        std::pop_heap(Data, Data + Count, Predicate);
+        return Data[--Count];
+    }
+
+    /** 힙 구조를 풀어 Predicate 순서로 정렬합니다. 이후에는 Push/Pop하지 않아야 합니다 */
+    void Sort()
+    {
+        std::sort_heap(Data, Data + Count, Predicate);
+    }
+
+private:
+    T* Data;
+    int32 Capacity;
+    int32 Count = 0;
+    PredicateType Predicate;
+};
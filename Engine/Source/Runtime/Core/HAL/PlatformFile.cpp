@@ -0,0 +1,73 @@
+#include "PlatformFile.h"
+
+bool FPlatformFile::GetFileStamp(const wchar_t* FilePath, uint64& OutTimestamp, uint64& OutSize)
+{
+    WIN32_FILE_ATTRIBUTE_DATA Attributes;
+    if (!GetFileAttributesExW(FilePath, GetFileExInfoStandard, &Attributes))
+    {
+        return false;
+    }
+    OutTimestamp = (static_cast<uint64>(Attributes.ftLastWriteTime.dwHighDateTime) << 32) | Attributes.ftLastWriteTime.dwLowDateTime;
+    OutSize = (static_cast<uint64>(Attributes.nFileSizeHigh) << 32) | Attributes.nFileSizeLow;
+    return true;
+}
+
+bool FMappedFile::Open(const wchar_t* FilePath)
+{
+    Close();
+
+    FileHandle = CreateFileW(FilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (FileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(FileHandle, &FileSize))
+    {
+        Close();
+        return false;
+    }
+    Size = static_cast<uint64>(FileSize.QuadPart);
+
+    // 크기 0인 파일은 매핑을 만들 수 없음
+    if (Size == 0)
+    {
+        return true;
+    }
+
+    MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (MappingHandle == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    Data = static_cast<const uint8*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (Data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void FMappedFile::Close()
+{
+    if (Data)
+    {
+        UnmapViewOfFile(Data);
+        Data = nullptr;
+    }
+    if (MappingHandle)
+    {
+        CloseHandle(MappingHandle);
+        MappingHandle = nullptr;
+    }
+    if (FileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(FileHandle);
+        FileHandle = INVALID_HANDLE_VALUE;
+    }
+    Size = 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Core/HAL/PlatformType.h"
+
+struct FPlatformFile
+{
+    // 마지막 수정 시각(FILETIME)과 크기. 파일이 없으면 false
+    static bool GetFileStamp(const wchar_t* FilePath, uint64& OutTimestamp, uint64& OutSize);
+};
+
+/**
+ * 파일 전체를 읽기 전용으로 메모리 매핑
+ *
+ * @note 빈 파일은 Open이 성공하지만 GetData()는 nullptr입니다.
+ */
+class FMappedFile
+{
+public:
+    FMappedFile() = default;
+    ~FMappedFile() { Close(); }
+
+    FMappedFile(const FMappedFile&) = delete;
+    FMappedFile& operator=(const FMappedFile&) = delete;
+
+    bool Open(const wchar_t* FilePath);
+    void Close();
+
+    bool IsOpen() const { return FileHandle != INVALID_HANDLE_VALUE; }
+    const uint8* GetData() const { return Data; }
+    uint64 GetSize() const { return Size; }
+
+private:
+    HANDLE FileHandle = INVALID_HANDLE_VALUE;
+    HANDLE MappingHandle = nullptr;
+    const uint8* Data = nullptr;
+    uint64 Size = 0;
+};
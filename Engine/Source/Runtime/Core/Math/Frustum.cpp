@@ -4,6 +4,10 @@
 #include "Define.h"
 #include "MathUtility.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 void FFrustum::ConstructFrustum(const FMatrix& VP)
 {
     // VP = View * Projection 행렬
@@ -96,6 +100,21 @@ void FFrustum::ConstructFrustum(const FMatrix& VP)
     }
 }
 
+void FFrustum::ConstructFrustumFromScreenRect(const FMatrix& VP, float MinNdcX, float MinNdcY, float MaxNdcX, float MaxNdcY)
+{
+    // 사각형을 NDC 전체(-1~1)로 늘리는 행렬을 뒤에 곱함. clip' = (a*x + b*w, c*y + d*w, z, w)
+    const float Width = FMath::Max(MaxNdcX - MinNdcX, KINDA_SMALL_NUMBER);
+    const float Height = FMath::Max(MaxNdcY - MinNdcY, KINDA_SMALL_NUMBER);
+
+    FMatrix RectToNDC = FMatrix::Identity;
+    RectToNDC.M[0][0] = 2.0f / Width;
+    RectToNDC.M[3][0] = -(MaxNdcX + MinNdcX) / Width;
+    RectToNDC.M[1][1] = 2.0f / Height;
+    RectToNDC.M[3][1] = -(MaxNdcY + MinNdcY) / Height;
+
+    ConstructFrustum(VP * RectToNDC);
+}
+
 // 안씀
 bool FFrustumPlane::IntersectAABB(const FBoundingBox& AABB) const
 {
@@ -154,3 +173,264 @@ EFrustumContainment FFrustum::CheckContainment(const FBoundingBox& AABB) const
 
     return bAllInside ? EFrustumContainment::Contains : EFrustumContainment::Intersects;
 }
+
+EFrustumContainment FFrustum::CheckContainment(const FBoundingBox& AABB, uint8& InOutPlaneMask, uint8& InOutOutsidePlane) const
+{
+    FVector Center = (AABB.min + AABB.max) * 0.5f;
+    FVector Extents = (AABB.max - AABB.min) * 0.5f;
+
+    // 지난 프레임에 거부한 평면부터 검사. 카메라가 조금만 움직였다면 대부분 여기서 끝남
+    const int FirstPlane = InOutOutsidePlane < (int)EFrustumPlane::Count ? InOutOutsidePlane : 0;
+    for (int Step = 0; Step < (int)EFrustumPlane::Count; ++Step)
+    {
+        const int i = (FirstPlane + Step) % (int)EFrustumPlane::Count;
+        if (!(InOutPlaneMask & (1 << i)))
+            continue;
+
+        const FFrustumPlane& Plane = Planes[i];
+        float Radius =
+            Extents.x * FMath::Abs(Plane.Normal.x) +
+            Extents.y * FMath::Abs(Plane.Normal.y) +
+            Extents.z * FMath::Abs(Plane.Normal.z);
+
+        float DistanceToCenter = Plane.Normal.Dot(Center) + Plane.Distance;
+
+        if (DistanceToCenter + Radius < 0)
+        {
+            InOutOutsidePlane = static_cast<uint8>(i);
+            return EFrustumContainment::Outside;
+        }
+        if (DistanceToCenter - Radius >= 0)
+        {
+            InOutPlaneMask &= ~(1 << i); // 이 평면 안쪽에 완전히 포함. 자식도 검사 불필요
+        }
+    }
+
+    InOutOutsidePlane = NoPlane;
+    return InOutPlaneMask ? EFrustumContainment::Intersects : EFrustumContainment::Contains;
+}
+
+bool FFrustum::IsOutsidePlane(const FBoundingBox& AABB, int PlaneIndex) const
+{
+    const FFrustumPlane& Plane = Planes[PlaneIndex];
+
+    FVector Center = (AABB.min + AABB.max) * 0.5f;
+    FVector Extents = (AABB.max - AABB.min) * 0.5f;
+
+    float Radius =
+        Extents.x * FMath::Abs(Plane.Normal.x) +
+        Extents.y * FMath::Abs(Plane.Normal.y) +
+        Extents.z * FMath::Abs(Plane.Normal.z);
+
+    return Plane.Normal.Dot(Center) + Plane.Distance + Radius < 0;
+}
+
+bool FFrustum::IsSameAs(const FFrustum& Other) const
+{
+    for (int i = 0; i < (int)EFrustumPlane::Count; ++i)
+    {
+        const FFrustumPlane& A = Planes[i];
+        const FFrustumPlane& B = Other.Planes[i];
+        if (A.Normal.x != B.Normal.x || A.Normal.y != B.Normal.y || A.Normal.z != B.Normal.z || A.Distance != B.Distance)
+            return false;
+    }
+    return true;
+}
+
+// 커널이 평면별로 모은 레인 비트를 결과로 변환. 한 평면이라도 완전히 밖이면 Outside,
+// 걸친 평면이 남아 있으면 Intersects. 남은 평면 마스크는 자식 검사에 그대로 넘긴다
+static void ResolveLanes(int LaneCount, uint8 PlaneMask, int OutsideBits, const int IntersectBits[], const uint8 OutsidePlanes[],
+                         EFrustumContainment* OutResults, uint8* OutPlaneMasks, uint8* OutOutsidePlanes)
+{
+    for (int Lane = 0; Lane < LaneCount; ++Lane)
+    {
+        uint8 LaneMask = 0;
+        for (int i = 0; i < (int)EFrustumPlane::Count; ++i)
+        {
+            if ((PlaneMask & (1 << i)) && (IntersectBits[i] & (1 << Lane)))
+                LaneMask |= static_cast<uint8>(1 << i);
+        }
+
+        if (OutsideBits & (1 << Lane))
+            OutResults[Lane] = EFrustumContainment::Outside;
+        else
+            OutResults[Lane] = LaneMask ? EFrustumContainment::Intersects : EFrustumContainment::Contains;
+
+        if (OutPlaneMasks)
+            OutPlaneMasks[Lane] = LaneMask;
+        if (OutOutsidePlanes)
+            OutOutsidePlanes[Lane] = OutsidePlanes[Lane];
+    }
+}
+
+void FFrustum::CheckContainment4(const SIMD::FAABB4SoA& AABBs, EFrustumContainment OutResults[4],
+                                 uint8 PlaneMask, uint8* OutPlaneMasks, uint8* OutOutsidePlanes) const
+{
+    const __m128 Half = _mm_set1_ps(0.5f);
+    const __m128 Zero = _mm_setzero_ps();
+
+    const __m128 MinX = _mm_load_ps(AABBs.MinX);
+    const __m128 MinY = _mm_load_ps(AABBs.MinY);
+    const __m128 MinZ = _mm_load_ps(AABBs.MinZ);
+    const __m128 MaxX = _mm_load_ps(AABBs.MaxX);
+    const __m128 MaxY = _mm_load_ps(AABBs.MaxY);
+    const __m128 MaxZ = _mm_load_ps(AABBs.MaxZ);
+
+    // AABB의 중심과 반경 (CheckContainment와 같은 연산 순서)
+    const __m128 CenterX = _mm_mul_ps(_mm_add_ps(MinX, MaxX), Half);
+    const __m128 CenterY = _mm_mul_ps(_mm_add_ps(MinY, MaxY), Half);
+    const __m128 CenterZ = _mm_mul_ps(_mm_add_ps(MinZ, MaxZ), Half);
+    const __m128 ExtentX = _mm_mul_ps(_mm_sub_ps(MaxX, MinX), Half);
+    const __m128 ExtentY = _mm_mul_ps(_mm_sub_ps(MaxY, MinY), Half);
+    const __m128 ExtentZ = _mm_mul_ps(_mm_sub_ps(MaxZ, MinZ), Half);
+
+    int OutsideBits = 0;
+    int IntersectBits[(int)EFrustumPlane::Count] = {};
+    uint8 OutsidePlanes[4] = {NoPlane, NoPlane, NoPlane, NoPlane};
+    for (int i = 0; i < (int)EFrustumPlane::Count; ++i)
+    {
+        // 부모가 이미 완전히 안쪽에 있는 평면은 건너뜀
+        if (!(PlaneMask & (1 << i)))
+            continue;
+
+        const FFrustumPlane& Plane = Planes[i];
+
+        const __m128 Radius = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(ExtentX, _mm_set1_ps(FMath::Abs(Plane.Normal.x))),
+            _mm_mul_ps(ExtentY, _mm_set1_ps(FMath::Abs(Plane.Normal.y)))),
+            _mm_mul_ps(ExtentZ, _mm_set1_ps(FMath::Abs(Plane.Normal.z))));
+
+        const __m128 DistanceToCenter = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(CenterX, _mm_set1_ps(Plane.Normal.x)),
+            _mm_mul_ps(CenterY, _mm_set1_ps(Plane.Normal.y))),
+            _mm_mul_ps(CenterZ, _mm_set1_ps(Plane.Normal.z))),
+            _mm_set1_ps(Plane.Distance));
+
+        const int NewOutsideBits = _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(DistanceToCenter, Radius), Zero)) & ~OutsideBits;
+        IntersectBits[i] = _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(DistanceToCenter, Radius), Zero));
+
+        if (NewOutsideBits)
+        {
+            OutsideBits |= NewOutsideBits;
+            for (int Lane = 0; Lane < 4; ++Lane)
+            {
+                if (NewOutsideBits & (1 << Lane))
+                    OutsidePlanes[Lane] = static_cast<uint8>(i);
+            }
+            // 4개 모두 밖이면 나머지 평면은 볼 필요 없음
+            if (OutsideBits == 0xF)
+                break;
+        }
+    }
+
+    ResolveLanes(4, PlaneMask, OutsideBits, IntersectBits, OutsidePlanes, OutResults, OutPlaneMasks, OutOutsidePlanes);
+}
+
+#if defined(__AVX__)
+void FFrustum::CheckContainment8(const SIMD::FAABB8SoA& AABBs, EFrustumContainment OutResults[8],
+                                 uint8 PlaneMask, uint8* OutPlaneMasks, uint8* OutOutsidePlanes) const
+{
+    const __m256 Half = _mm256_set1_ps(0.5f);
+    const __m256 Zero = _mm256_setzero_ps();
+
+    const __m256 MinX = _mm256_load_ps(AABBs.MinX);
+    const __m256 MinY = _mm256_load_ps(AABBs.MinY);
+    const __m256 MinZ = _mm256_load_ps(AABBs.MinZ);
+    const __m256 MaxX = _mm256_load_ps(AABBs.MaxX);
+    const __m256 MaxY = _mm256_load_ps(AABBs.MaxY);
+    const __m256 MaxZ = _mm256_load_ps(AABBs.MaxZ);
+
+    const __m256 CenterX = _mm256_mul_ps(_mm256_add_ps(MinX, MaxX), Half);
+    const __m256 CenterY = _mm256_mul_ps(_mm256_add_ps(MinY, MaxY), Half);
+    const __m256 CenterZ = _mm256_mul_ps(_mm256_add_ps(MinZ, MaxZ), Half);
+    const __m256 ExtentX = _mm256_mul_ps(_mm256_sub_ps(MaxX, MinX), Half);
+    const __m256 ExtentY = _mm256_mul_ps(_mm256_sub_ps(MaxY, MinY), Half);
+    const __m256 ExtentZ = _mm256_mul_ps(_mm256_sub_ps(MaxZ, MinZ), Half);
+
+    int OutsideBits = 0;
+    int IntersectBits[(int)EFrustumPlane::Count] = {};
+    uint8 OutsidePlanes[8] = {NoPlane, NoPlane, NoPlane, NoPlane, NoPlane, NoPlane, NoPlane, NoPlane};
+    for (int i = 0; i < (int)EFrustumPlane::Count; ++i)
+    {
+        if (!(PlaneMask & (1 << i)))
+            continue;
+
+        const FFrustumPlane& Plane = Planes[i];
+
+        const __m256 Radius = _mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(ExtentX, _mm256_set1_ps(FMath::Abs(Plane.Normal.x))),
+            _mm256_mul_ps(ExtentY, _mm256_set1_ps(FMath::Abs(Plane.Normal.y)))),
+            _mm256_mul_ps(ExtentZ, _mm256_set1_ps(FMath::Abs(Plane.Normal.z))));
+
+        const __m256 DistanceToCenter = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(CenterX, _mm256_set1_ps(Plane.Normal.x)),
+            _mm256_mul_ps(CenterY, _mm256_set1_ps(Plane.Normal.y))),
+            _mm256_mul_ps(CenterZ, _mm256_set1_ps(Plane.Normal.z))),
+            _mm256_set1_ps(Plane.Distance));
+
+        const int NewOutsideBits = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(DistanceToCenter, Radius), Zero, _CMP_LT_OQ)) & ~OutsideBits;
+        IntersectBits[i] = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_sub_ps(DistanceToCenter, Radius), Zero, _CMP_LT_OQ));
+
+        if (NewOutsideBits)
+        {
+            OutsideBits |= NewOutsideBits;
+            for (int Lane = 0; Lane < 8; ++Lane)
+            {
+                if (NewOutsideBits & (1 << Lane))
+                    OutsidePlanes[Lane] = static_cast<uint8>(i);
+            }
+            if (OutsideBits == 0xFF)
+                break;
+        }
+    }
+
+    ResolveLanes(8, PlaneMask, OutsideBits, IntersectBits, OutsidePlanes, OutResults, OutPlaneMasks, OutOutsidePlanes);
+}
+#endif
+
+void FFrustum::CheckContainmentBatch(const FBoundingBox* AABBs, int32 Count, EFrustumContainment* OutResults,
+                                     uint8 PlaneMask, uint8* OutPlaneMasks, uint8* OutOutsidePlanes) const
+{
+#if USE_SIMD
+#if defined(__AVX__)
+    constexpr int32 Width = 8;
+    SIMD::FAABB8SoA SoA;
+#else
+    constexpr int32 Width = 4;
+    SIMD::FAABB4SoA SoA;
+#endif
+    for (int32 i = 0; i < Count; i += Width)
+    {
+        const int32 LaneCount = FMath::Min(Width, Count - i);
+        SIMD::ConvertAABBToSoA(AABBs + i, LaneCount, SoA);
+
+        EFrustumContainment Results[Width];
+        uint8 PlaneMasks[Width];
+        uint8 OutsidePlanes[Width];
+#if defined(__AVX__)
+        CheckContainment8(SoA, Results, PlaneMask, PlaneMasks, OutsidePlanes);
+#else
+        CheckContainment4(SoA, Results, PlaneMask, PlaneMasks, OutsidePlanes);
+#endif
+        for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+        {
+            OutResults[i + Lane] = Results[Lane];
+            if (OutPlaneMasks)
+                OutPlaneMasks[i + Lane] = PlaneMasks[Lane];
+            if (OutOutsidePlanes)
+                OutOutsidePlanes[i + Lane] = OutsidePlanes[Lane];
+        }
+    }
+#else
+    for (int32 i = 0; i < Count; ++i)
+    {
+        uint8 Mask = PlaneMask;
+        uint8 OutsidePlane = NoPlane;
+        OutResults[i] = CheckContainment(AABBs[i], Mask, OutsidePlane);
+        if (OutPlaneMasks)
+            OutPlaneMasks[i] = Mask;
+        if (OutOutsidePlanes)
+            OutOutsidePlanes[i] = OutsidePlane;
+    }
+#endif
+}
@@ -3,6 +3,7 @@
 
 #include "Math.h"
 #include "Vector.h"
+#include "SIMD/SimdUtility.h"
 
 struct FMatrix;
 struct FBoundingBox;
@@ -39,11 +40,44 @@ public:
     /** ViewProjection 행렬로부터 6개의 평면을 생성합니다 */
     void ConstructFrustum(const FMatrix& ViewProjectionMatrix); 
 
+    /** 화면 사각형(NDC, -1~1)만 덮는 부분 프러스텀을 생성합니다. 마퀴 선택에 사용 */
+    void ConstructFrustumFromScreenRect(const FMatrix& ViewProjectionMatrix, float MinNdcX, float MinNdcY, float MaxNdcX, float MaxNdcY);
+
     /** AABB가 프러스텀에 속해있는지 확인합니다 */
     bool Intersect(const FBoundingBox& AABB) const; // 안씀
 
     EFrustumContainment CheckContainment(const FBoundingBox& AABB) const;
 
+    /**
+     * 평면 마스크를 쓰는 검사. InOutPlaneMask의 평면만 검사하고, 완전히 안쪽인 평면은 마스크에서 지웁니다 (자식에 그대로 전달).
+     * InOutOutsidePlane(지난 프레임에 거부한 평면)부터 검사하고, Outside면 거부한 평면으로 갱신합니다.
+     */
+    EFrustumContainment CheckContainment(const FBoundingBox& AABB, uint8& InOutPlaneMask, uint8& InOutOutsidePlane) const;
+
+    /** 평면 하나에 대해 완전히 밖인지 확인합니다 */
+    bool IsOutsidePlane(const FBoundingBox& AABB, int PlaneIndex) const;
+
+    /** 평면이 모두 같은지 (카메라가 그대로인지) 확인합니다 */
+    bool IsSameAs(const FFrustum& Other) const;
+
+    /**
+     * AABB Count개를 한 번에 검사. SSE는 4개, AVX는 8개 단위로 PlaneMask의 평면을 동시에 검사합니다.
+     * OutPlaneMasks에는 각 박스가 아직 걸쳐 있는 평면, OutOutsidePlanes에는 거부한 평면(없으면 NoPlane)을 기록합니다.
+     */
+    void CheckContainmentBatch(const FBoundingBox* AABBs, int32 Count, EFrustumContainment* OutResults,
+                               uint8 PlaneMask = AllPlanesMask, uint8* OutPlaneMasks = nullptr, uint8* OutOutsidePlanes = nullptr) const;
+
+    /** SoA로 정리된 AABB 4개 검사. 결과는 CheckContainment와 같습니다 */
+    void CheckContainment4(const SIMD::FAABB4SoA& AABBs, EFrustumContainment OutResults[4],
+                           uint8 PlaneMask = AllPlanesMask, uint8* OutPlaneMasks = nullptr, uint8* OutOutsidePlanes = nullptr) const;
+#if defined(__AVX__)
+    void CheckContainment8(const SIMD::FAABB8SoA& AABBs, EFrustumContainment OutResults[8],
+                           uint8 PlaneMask = AllPlanesMask, uint8* OutPlaneMasks = nullptr, uint8* OutOutsidePlanes = nullptr) const;
+#endif
+
+    static constexpr uint8 AllPlanesMask = (1 << static_cast<int>(EFrustumPlane::Count)) - 1;
+    static constexpr uint8 NoPlane = 0xFF;
+
 private:
     FFrustumPlane Planes[static_cast<int>(EFrustumPlane::Count)];
 };
@@ -51,6 +51,13 @@ FRay FRay::GetRayFromViewport(std::shared_ptr<FEditorViewportClient> ViewportCli
     float ndcX = 2.0f * localX / ViewRect.width - 1.0f;
     float ndcY = -2.0f * localY / ViewRect.height + 1.0f;
 
+    return GetRayFromNDC(ViewportClient, ndcX, ndcY);
+}
+
+FRay FRay::GetRayFromNDC(std::shared_ptr<FEditorViewportClient> ViewportClient, float ndcX, float ndcY)
+{
+    FRay OutRay;
+
     FVector ndcNear(ndcX, ndcY, 0.0f);
     FVector ndcFar (ndcX, ndcY, 1.0f);
 
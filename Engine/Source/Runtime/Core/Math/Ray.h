@@ -35,9 +35,19 @@ struct FRay
     }
     void InitFromScreen(const FVector& ScreenSpace, std::shared_ptr<FEditorViewportClient> ActiveViewport, const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, bool bIsOrtho);
     static FRay GetRayFromViewport(std::shared_ptr<FEditorViewportClient> ViewportClient, const FRect& ViewRect);
+    //뷰포트 NDC 좌표 (-1~1, y 위쪽)를 지나는 레이. 여러 레이를 한 번에 만들 때 사용
+    static FRay GetRayFromNDC(std::shared_ptr<FEditorViewportClient> ViewportClient, float ndcX, float ndcY);
 
 
 };
+
+// 레이캐스트 한 번의 순회 비용. 피킹 비용이 씬 크기에 비례하는지 확인용
+struct FRaycastStats
+{
+    int32 NodesVisited = 0;     // 경계 검사를 통과해 들어간 노드 수
+    int32 PrimitivesTested = 0; // 교차 검사한 컴포넌트 수
+};
+
 // Ray가 AABB와 교차하는지 여부 반환 (Slab 방식)
 inline bool RayIntersectsAABB(const FRay& Ray, const FBoundingBox& Box, float& OutHitDistance)
 {
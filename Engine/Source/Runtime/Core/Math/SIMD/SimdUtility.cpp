@@ -3,6 +3,7 @@
 
 #include "Core/Math/Vector.h"
 #include "Core/Math/Vector4.h"
+#include "Define.h"
 
 __m128 SIMD::LoadVec3(const FVector& v)
 {
@@ -65,3 +66,30 @@ void SIMD::ConvertSoAToAoS(const FVector4SoA& src, FVector4* dst)
         dst[i].a = src.w[i];
     }
 }
+
+template <int Width, typename SoAType>
+static void ConvertAABBToSoAImpl(const FBoundingBox* src, int count, SoAType& dst)
+{
+    for (int i = 0; i < Width; ++i)
+    {
+        const FBoundingBox& Box = src[i < count ? i : count - 1];
+        dst.MinX[i] = Box.min.x;
+        dst.MinY[i] = Box.min.y;
+        dst.MinZ[i] = Box.min.z;
+        dst.MaxX[i] = Box.max.x;
+        dst.MaxY[i] = Box.max.y;
+        dst.MaxZ[i] = Box.max.z;
+    }
+}
+
+void SIMD::ConvertAABBToSoA(const FBoundingBox* src, int count, FAABB4SoA& dst)
+{
+    ConvertAABBToSoAImpl<4>(src, count, dst);
+}
+
+#if defined(__AVX__)
+void SIMD::ConvertAABBToSoA(const FBoundingBox* src, int count, FAABB8SoA& dst)
+{
+    ConvertAABBToSoAImpl<8>(src, count, dst);
+}
+#endif
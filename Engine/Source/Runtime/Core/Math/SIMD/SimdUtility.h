@@ -7,6 +7,7 @@
 
 struct FVector;
 struct FVector4;
+struct FBoundingBox;
 
 namespace SIMD
 {
@@ -151,5 +152,26 @@ namespace SIMD
     // SoA -> AoS 변환
     void ConvertSoAToAoS(const FVector4SoA& src, FVector4* dst);
 
+    // AABB 4개의 SoA 구조체 (프러스텀 컬링용)
+    struct alignas(16) FAABB4SoA
+    {
+        float MinX[4], MinY[4], MinZ[4];
+        float MaxX[4], MaxY[4], MaxZ[4];
+    };
+
+    // AABB 배열 -> SoA 변환. count가 4보다 작으면 남는 레인은 마지막 박스로 채움
+    void ConvertAABBToSoA(const FBoundingBox* src, int count, FAABB4SoA& dst);
+
+#if defined(__AVX__)
+    // AABB 8개의 SoA 구조체 (AVX)
+    struct alignas(32) FAABB8SoA
+    {
+        float MinX[8], MinY[8], MinZ[8];
+        float MaxX[8], MaxY[8], MaxZ[8];
+    };
+
+    void ConvertAABBToSoA(const FBoundingBox* src, int count, FAABB8SoA& dst);
+#endif
+
 
 }
\ No newline at end of file
@@ -61,6 +61,18 @@ double FStatRegistry::GetLastMilliseconds(const TStatId& StatId)
 	}
 	return 0.0;
 }
+void FStatRegistry::SetCounter(const TStatId& StatId, int64 Value)
+{
+	CounterMap[StatId.GetId()] = Value;
+}
+int64 FStatRegistry::GetCounter(const TStatId& StatId)
+{
+	if (int64* Value = CounterMap.Find(StatId.GetId()))
+	{
+		return *Value;
+	}
+	return 0;
+}
 double FStatRegistry::GetFPS(const TStatId& StatId)
 {
 	static TStatId Stat_Frame(StatId);
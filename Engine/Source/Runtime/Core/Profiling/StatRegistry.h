@@ -38,8 +38,14 @@ public:
     static void SetMainFrameStat(const TStatId& StatId);
     static int TotalPickCount;
     static double TotalPickTime;
+
+    // 시간 대신 횟수로 보는 통계 (피킹 노드 방문 수 등). 마지막 값만 유지
+    static void SetCounter(const TStatId& StatId, int64 Value);
+    static int64 GetCounter(const TStatId& StatId);
+    static const TMap<uint32, int64>& GetCounterMap() { return CounterMap; }
 private:
     inline static TMap<uint32, double> StatMap; // ← GetDisplayIndex 기반으로 저장
+    inline static TMap<uint32, int64> CounterMap;
 	inline static FStatFPSRecord MainFrameRecord;
 	inline static uint32 MainFrameKey = 0; // 최초 설정 이후 고정
 };
\ No newline at end of file
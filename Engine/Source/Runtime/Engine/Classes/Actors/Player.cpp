@@ -8,9 +8,11 @@
 #include "BaseGizmos/TransformGizmo.h"
 #include "Camera/CameraComponent.h"
 #include "Components/LightComponent.h"
+#include "KDTree/BVH.h"
 #include "KDTree/KDTree.h"
 #include "KDTree/KDTreeSystem.h"
 #include "LevelEditor/SLevelEditor.h"
+#include "Math/Frustum.h"
 #include "Math/JungleMath.h"
 #include "Math/MathUtility.h"
 #include "Math/Ray.h"
@@ -43,7 +45,16 @@ void AEditorPlayer::Input()
         if (!bLeftMouseDown)
         {
             bLeftMouseDown = true;
-            HandleLeftClick();
+            // Ctrl + 드래그는 마퀴 선택. 놓을 때 사각형으로 질의
+            if (GetAsyncKeyState(VK_CONTROL) & 0x8000)
+            {
+                bMarqueeSelecting = true;
+                GetMousePositionClient(MarqueeStartX, MarqueeStartY);
+            }
+            else
+            {
+                HandleLeftClick();
+            }
             /*
             POINT mousePos;
             GetCursorPos(&mousePos);
@@ -68,7 +79,7 @@ void AEditorPlayer::Input()
             if (!res) PickActor(pickPosition);
             */
         }
-        else
+        else if (!bMarqueeSelecting)
         {
             PickedObjControl();
         }
@@ -79,6 +90,13 @@ void AEditorPlayer::Input()
         {
             bLeftMouseDown = false; // ���콺 ������ ��ư�� ���� ���� �ʱ�ȭ
             GetWorld()->SetPickingGizmo(nullptr);
+            if (bMarqueeSelecting)
+            {
+                bMarqueeSelecting = false;
+                int32 EndX, EndY;
+                GetMousePositionClient(EndX, EndY);
+                SelectActorInMarquee(MarqueeStartX, MarqueeStartY, EndX, EndY);
+            }
         }
     }
     if (GetAsyncKeyState(VK_SPACE) & 0x8000)
@@ -180,7 +198,10 @@ void AEditorPlayer::TryPickActor()
     ++FStatRegistry::TotalPickCount;
 
     float ClosestDistance = FLT_MAX;
-    UPrimitiveComponent* Closest = GetEngine().GetWorld()->SceneOctree->Raycast(Ray, ClosestDistance);
+    UWorld* World = GetEngine().GetWorld();
+    UPrimitiveComponent* Closest = (World->bUseBVHPicking && World->SceneBVH)
+        ? World->SceneBVH->Raycast(Ray, ClosestDistance)
+        : World->SceneOctree->Raycast(Ray, ClosestDistance);
     //UPrimitiveComponent* Closest = GetEngine().GetWorld()->SceneKDTreeSystem->Raycast(Ray, ClosestDistance);
 
     if (Closest)
@@ -192,6 +213,128 @@ void AEditorPlayer::TryPickActor()
     GetWorld()->SetHighlightedComponent(dynamic_cast<UStaticMeshComponent*>(Closest));
 }
 
+void AEditorPlayer::QueryActorsInScreenRect(int32 StartX, int32 StartY, int32 EndX, int32 EndY, TArray<AActor*>& OutActors)
+{
+    std::shared_ptr<FEditorViewportClient> ViewportClient = GetEngine().GetLevelEditor()->GetActiveViewportClient();
+    const D3D11_VIEWPORT Viewport = ViewportClient->GetD3DViewport();
+    if (Viewport.Width <= 0.0f || Viewport.Height <= 0.0f)
+        return;
+
+    // 클라이언트 좌표 → NDC. 화면 y는 아래로 증가하므로 뒤집힘
+    auto ToNdcX = [&](int32 X) { return FMath::Clamp(2.0f * (X - Viewport.TopLeftX) / Viewport.Width - 1.0f, -1.0f, 1.0f); };
+    auto ToNdcY = [&](int32 Y) { return FMath::Clamp(1.0f - 2.0f * (Y - Viewport.TopLeftY) / Viewport.Height, -1.0f, 1.0f); };
+    const float NdcX0 = ToNdcX(StartX), NdcX1 = ToNdcX(EndX);
+    const float NdcY0 = ToNdcY(StartY), NdcY1 = ToNdcY(EndY);
+
+    FFrustum RectFrustum;
+    RectFrustum.ConstructFrustumFromScreenRect(ViewportClient->GetViewMatrix() * ViewportClient->GetProjectionMatrix(),
+                                               FMath::Min(NdcX0, NdcX1), FMath::Min(NdcY0, NdcY1),
+                                               FMath::Max(NdcX0, NdcX1), FMath::Max(NdcY0, NdcY1));
+
+    FScopeCycleCounter QueryCounter("MarqueeQuery");
+    TArray<UPrimitiveComponent*> Components;
+    GetWorld()->SceneOctree->QueryFrustum(RectFrustum, Components);
+
+    // 한 액터의 컴포넌트 여러 개가 걸릴 수 있으므로 정렬 후 중복 제거
+    const int32 StartIndex = OutActors.Num();
+    for (UPrimitiveComponent* Comp : Components)
+    {
+        if (AActor* Owner = Comp->GetOwner())
+            OutActors.Add(Owner);
+    }
+    std::sort(OutActors.begin() + StartIndex, OutActors.end());
+    OutActors.SetNum(static_cast<int32>(std::unique(OutActors.begin() + StartIndex, OutActors.end()) - OutActors.begin()));
+    FStatRegistry::RegisterResult(QueryCounter);
+}
+
+void AEditorPlayer::SelectActorInMarquee(int32 StartX, int32 StartY, int32 EndX, int32 EndY)
+{
+    // 몇 픽셀 안쪽의 드래그는 손떨림으로 보고 무시
+    if (FMath::Abs(EndX - StartX) < 4 || FMath::Abs(EndY - StartY) < 4)
+        return;
+
+    TArray<AActor*> Actors;
+    QueryActorsInScreenRect(StartX, StartY, EndX, EndY, Actors);
+
+    // 선택은 한 액터만 가능하므로 사각형 안에서 카메라에 가장 가까운 액터를 고름
+    const FVector CameraLocation = GetEngine().GetLevelEditor()->GetActiveViewportClient()->GetCameraWorldPosition();
+    AActor* Nearest = nullptr;
+    float NearestDistSq = FLT_MAX;
+    for (AActor* Actor : Actors)
+    {
+        const FVector Delta = Actor->GetActorLocation() - CameraLocation;
+        const float DistSq = Delta.Dot(Delta);
+        if (DistSq < NearestDistSq)
+        {
+            NearestDistSq = DistSq;
+            Nearest = Actor;
+        }
+    }
+
+    GetWorld()->SetPickedActor(Nearest);
+    GetWorld()->SetHighlightedComponent(Nearest ? Nearest->GetComponentByClass<UStaticMeshComponent>() : nullptr);
+}
+
+void AEditorPlayer::BenchmarkPacketPicking(int32 GridSize)
+{
+    UWorld* World = GetEngine().GetWorld();
+    if (!World->SceneBVH || GridSize <= 0) return;
+
+    // 행 우선으로 채우므로 한 패킷의 레이는 가로로 이웃한 픽셀 (방향이 거의 같음)
+    std::shared_ptr<FEditorViewportClient> ViewportClient = GetEngine().GetLevelEditor()->GetActiveViewportClient();
+    const int32 NumRays = GridSize * GridSize;
+    TArray<FRay> Rays;
+    Rays.Reserve(NumRays);
+    for (int32 y = 0; y < GridSize; ++y)
+    {
+        for (int32 x = 0; x < GridSize; ++x)
+        {
+            const float NdcX = (x + 0.5f) / GridSize * 2.0f - 1.0f;
+            const float NdcY = 1.0f - (y + 0.5f) / GridSize * 2.0f;
+            Rays.Add(FRay::GetRayFromNDC(ViewportClient, NdcX, NdcY));
+        }
+    }
+
+    TArray<UPrimitiveComponent*> OctreeHits;
+    TArray<UStaticMeshComponent*> SingleHits;
+    TArray<UStaticMeshComponent*> PacketHits;
+    TArray<float> OctreeDistances, SingleDistances, PacketDistances;
+    OctreeHits.SetNum(NumRays);
+    SingleHits.SetNum(NumRays);
+    PacketHits.SetNum(NumRays);
+    OctreeDistances.Init(FLT_MAX, NumRays);
+    SingleDistances.Init(FLT_MAX, NumRays);
+    PacketDistances.Init(FLT_MAX, NumRays);
+
+    {
+        FScopeCycleCounter Timer("PickBenchOctree");
+        for (int32 i = 0; i < NumRays; ++i)
+            OctreeHits[i] = World->SceneOctree->Raycast(Rays[i], OctreeDistances[i]);
+        FStatRegistry::RegisterResult(Timer);
+    }
+    {
+        FScopeCycleCounter Timer("PickBenchBVHSingle");
+        for (int32 i = 0; i < NumRays; ++i)
+            SingleHits[i] = World->SceneBVH->Raycast(Rays[i], SingleDistances[i]);
+        FStatRegistry::RegisterResult(Timer);
+    }
+    {
+        FScopeCycleCounter Timer("PickBenchBVHPacket");
+        World->SceneBVH->RaycastPacket(Rays.GetData(), NumRays, PacketHits.GetData(), PacketDistances.GetData());
+        FStatRegistry::RegisterResult(Timer);
+    }
+
+    // 패킷 결과는 같은 BVH의 단일 레이 결과와 같아야 함
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < NumRays; ++i)
+    {
+        if (SingleHits[i] != PacketHits[i])
+            ++Mismatches;
+    }
+    FStatRegistry::SetCounter("PickBenchRays", NumRays);
+    FStatRegistry::SetCounter("PickBenchMismatches", Mismatches);
+}
+
 
 bool AEditorPlayer::PickGizmo(FVector& pickPosition)
 {
@@ -458,6 +601,23 @@ void AEditorPlayer::PickedObjControl()
         default:
             break;
         }
+
+        // 움직인 액터의 컴포넌트만 옥트리에 반영 (전체 BuildFull 없이)
+        if (deltaX != 0 || deltaY != 0)
+        {
+            for (UActorComponent* Component : PickedActor->GetComponents())
+            {
+                if (UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(Component))
+                    GetWorld()->SceneOctree->UpdateComponent(PrimComp);
+                if (UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component))
+                {
+                    if (GetWorld()->SceneKDTreeSystem)
+                        GetWorld()->SceneKDTreeSystem->UpdateComponent(MeshComp);
+                }
+            }
+            if (GetWorld()->SceneBVH)
+                GetWorld()->SceneBVH->MarkDirty();
+        }
         m_LastMousePos = currentMousePos;
     }
 }
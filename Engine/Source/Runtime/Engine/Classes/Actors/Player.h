@@ -18,6 +18,12 @@ class AEditorPlayer : public AActor
     void Input();
     void HandleLeftClick();
     void TryPickActor();
+    //뷰포트를 GridSize x GridSize 레이로 덮어 단일 레이(옥트리/BVH)와 BVH 패킷 피킹 시간을 비교해 StatMap에 기록
+    void BenchmarkPacketPicking(int32 GridSize = 64);
+    //활성 뷰포트의 클라이언트 좌표 사각형(마퀴) 안에 보이는 액터들. 사각형 부분 프러스텀으로 SceneOctree 한 번 순회
+    void QueryActorsInScreenRect(int32 StartX, int32 StartY, int32 EndX, int32 EndY, TArray<AActor*>& OutActors);
+    //Ctrl + 좌클릭 드래그로 그린 마퀴 안에서 카메라에 가장 가까운 액터를 선택
+    void SelectActorInMarquee(int32 StartX, int32 StartY, int32 EndX, int32 EndY);
 
     bool PickGizmo(FVector& rayOrigin);
     void PickActor(const FVector& pickPosition);
@@ -37,6 +43,9 @@ private:
     bool bLeftMouseDown = false;
     bool bRightMouseDown = false;
     bool bSpaceDown = false;
+    bool bMarqueeSelecting = false;
+    int32 MarqueeStartX = 0;
+    int32 MarqueeStartY = 0;
 
     POINT m_LastMousePos;
     ControlMode cMode = CM_TRANSLATION;
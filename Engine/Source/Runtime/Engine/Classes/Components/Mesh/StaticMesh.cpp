@@ -43,12 +43,14 @@ void UStaticMesh::GetUsedMaterials(TArray<UMaterial*>& Out) const
 void UStaticMesh::SetData(OBJ::FStaticMeshRenderData* renderData)
 {
     staticMeshRenderData = renderData;
+    LODRenderData = {renderData};
 
     uint32 verticeNum = staticMeshRenderData->Vertices.Num();
     if (verticeNum <= 0) return;
     //staticMeshRenderData->VertexBuffer = GetEngine().renderer.CreateVertexBuffer(staticMeshRenderData->Vertices, verticeNum * sizeof(FVertexSimple));
     
     uint32 indexNum = staticMeshRenderData->Indices.Num();
+    PickingBVH.Build(staticMeshRenderData->Vertices, staticMeshRenderData->Indices);
     //if (indexNum > 0)
     //    staticMeshRenderData->IndexBuffer = GetEngine().renderer.CreateIndexBuffer(staticMeshRenderData->Indices, indexNum * sizeof(uint32));
 
@@ -4,6 +4,7 @@
 #include "Components/Material/Material.h"
 #include "Define.h"
 #include "Engine/FLoaderOBJ.h"
+#include "KDTree/MeshBVH.h"
 #include "Octree/Octree.h"
 
 struct FManagerOBJ;
@@ -19,26 +20,29 @@ public:
     const TArray<FStaticMaterial*>& GetMaterials() const { return materials; }
     uint32 GetMaterialIndex(FName MaterialSlotName) const;
     void GetUsedMaterials(TArray<UMaterial*>& Out) const;
+    //체인보다 깊은 LOD를 요청하면 가장 단순한 LOD 반환
+    OBJ::FStaticMeshRenderData* GetRenderData(int32 LODIndex) const
+    {
+        return LODRenderData[FMath::Clamp(LODIndex, 0, LODRenderData.Num() - 1)];
+    }
     OBJ::FStaticMeshRenderData* GetRenderData(ELODLevel LODLevel) const
     {
-        if (LODLevel == ELODLevel::LOD0)
-            return staticMeshRenderData;
-        else if (LODLevel == ELODLevel::LOD1)
-        {
-            return FManagerOBJ::GetStaticMesh(staticMeshRenderData->ObjectName + L"X5")->GetRenderData();
-        }
-        else if (LODLevel == ELODLevel::LOD2)
-        {
-            return FManagerOBJ::GetStaticMesh(staticMeshRenderData->ObjectName + L"X1")->GetRenderData();
-        }
+        return GetRenderData(static_cast<int32>(LODLevel));
     }
     OBJ::FStaticMeshRenderData* GetRenderData() const
     {
             return staticMeshRenderData;
     }
     void SetData(OBJ::FStaticMeshRenderData* renderData);
+    //0번은 SetData로 준 원본이어야 함
+    void SetLODData(const TArray<OBJ::FStaticMeshRenderData*>& InLODs) { LODRenderData = InLODs; }
+    int32 GetNumLODs() const { return LODRenderData.Num(); }
+    //피킹용 로컬 공간 삼각형 BVH. SetData에서 한 번 빌드
+    const FMeshBVH& GetPickingBVH() const { return PickingBVH; }
 
 private:
     OBJ::FStaticMeshRenderData* staticMeshRenderData = nullptr;
+    TArray<OBJ::FStaticMeshRenderData*> LODRenderData;
+    FMeshBVH PickingBVH;
     TArray<FStaticMaterial*> materials;
 };
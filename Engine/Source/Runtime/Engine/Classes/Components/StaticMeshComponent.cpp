@@ -2,6 +2,7 @@
 
 #include "World.h"
 #include "Launch/EngineLoop.h"
+#include "Math/JungleMath.h"
 #include "Math/Ray.h"
 #include "UObject/ObjectFactory.h"
 #include "UnrealEd/PrimitiveBatch.h"
@@ -106,13 +107,33 @@ int UStaticMeshComponent::CheckRayIntersection(const FVector& rayOrigin, const F
     // StaticMesh 없는 경우 바로 반환
     if (!staticMesh) return 0;
 
-    // 월드 스페이스 구와 레이의 교차 판정
-    float hitDist = 0.f;
-    if (IntersectRaySphere(rayOrigin, rayDirection, BoundingSphere, hitDist))
+    const FMeshBVH& MeshBVH = staticMesh->GetPickingBVH();
+    if (MeshBVH.IsEmpty())
     {
-        pfNearHitDistance = hitDist;
-        return 1;
+        // 삼각형이 없으면 월드 스페이스 구와 레이의 교차 판정
+        float hitDist = 0.f;
+        if (IntersectRaySphere(rayOrigin, rayDirection, BoundingSphere, hitDist))
+        {
+            pfNearHitDistance = hitDist;
+            return 1;
+        }
+        return 0;
     }
 
-    return 0;
+    // 역행렬 계산 전에 월드 AABB로 먼저 거름
+    float BoxDist = 0.f;
+    if (!WorldAABB.Intersect(rayOrigin, rayDirection, BoxDist)) return 0;
+
+    // 레이를 메시 로컬 공간으로 옮겨 공유 삼각형 BVH로 검사.
+    // 방향을 다시 정규화하지 않으므로 로컬 t가 그대로 월드 거리 (rayDirection이 정규화되어 있을 때)
+    const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(GetWorldLocation(), GetWorldRotation(), GetWorldScale());
+    const FMatrix InvModel = FMatrix::Inverse(ModelMatrix);
+    const FVector LocalOrigin = InvModel.TransformPosition(rayOrigin);
+    const FVector LocalDirection = FMatrix::TransformVector(rayDirection, InvModel);
+
+    float HitDist = FLT_MAX;
+    if (!MeshBVH.Raycast(LocalOrigin, LocalDirection, HitDist)) return 0;
+
+    pfNearHitDistance = HitDist;
+    return 1;
 }
@@ -2,111 +2,625 @@
 #include "UObject/ObjectFactory.h"
 #include "Components/Material/Material.h"
 #include "Components/Mesh/StaticMesh.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFile.h"
+#include "MeshCluster.h"
+#include "MeshOptimizer.h"
+#include "QuantizedVertex.h"
+#include "StaticMeshCache.h"
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
+namespace
+{
+    bool IsObjSpace(char C)
+    {
+        return C == ' ' || C == '\t' || C == '\r' || C == '\v' || C == '\f';
+    }
+
+    // 매핑된 OBJ 텍스트를 훑는 커서. 토큰과 숫자는 현재 줄 안에서만 읽고 NextLine으로 다음 줄로 넘어감
+    struct FObjScanner
+    {
+        const char* Cursor;
+        const char* End;
+
+        bool IsAtEnd() const { return Cursor >= End; }
+
+        void SkipSpaces()
+        {
+            while (Cursor < End && IsObjSpace(*Cursor))
+                ++Cursor;
+        }
+
+        void NextLine()
+        {
+            const void* NewLine = std::memchr(Cursor, '\n', End - Cursor);
+            Cursor = NewLine ? static_cast<const char*>(NewLine) + 1 : End;
+        }
+
+        // 줄 끝이면 빈 토큰
+        std::string_view ReadToken()
+        {
+            SkipSpaces();
+            const char* Begin = Cursor;
+            while (Cursor < End && *Cursor != '\n' && !IsObjSpace(*Cursor))
+                ++Cursor;
+            return std::string_view(Begin, Cursor - Begin);
+        }
+
+        // 읽지 못하면 0 (커서는 그대로)
+        float ReadFloat()
+        {
+            SkipSpaces();
+            if (Cursor < End && *Cursor == '+')
+                ++Cursor;
+            float Value = 0.0f;
+            Cursor = std::from_chars(Cursor, End, Value).ptr;
+            return Value;
+        }
+    };
+
+    // std::stoi처럼 앞쪽 부호와 숫자만 읽음
+    int32 ParseObjInt(const char* Cursor, const char* End)
+    {
+        bool bNegative = false;
+        if (Cursor < End && (*Cursor == '-' || *Cursor == '+'))
+        {
+            bNegative = *Cursor == '-';
+            ++Cursor;
+        }
+        int32 Value = 0;
+        while (Cursor < End && *Cursor >= '0' && *Cursor <= '9')
+        {
+            Value = Value * 10 + (*Cursor - '0');
+            ++Cursor;
+        }
+        return bNegative ? -Value : Value;
+    }
+
+    // "v", "v/vt", "v//vn", "v/vt/vn". OBJ 인덱스는 1부터 시작하므로 -1로 변환. 없는 vt/vn은 UINT32_MAX
+    void ParseFaceCorner(std::string_view Corner, uint32& OutVertex, uint32& OutTexture, uint32& OutNormal)
+    {
+        uint32 Values[3] = {0, UINT32_MAX, UINT32_MAX};
+        const char* Cursor = Corner.data();
+        const char* End = Cursor + Corner.size();
+        for (int32 Piece = 0; Piece < 3; ++Piece)
+        {
+            const char* PieceEnd = Cursor;
+            while (PieceEnd < End && *PieceEnd != '/')
+                ++PieceEnd;
+            if (PieceEnd != Cursor)
+                Values[Piece] = static_cast<uint32>(ParseObjInt(Cursor, PieceEnd) - 1);
+            if (PieceEnd == End)
+                break;
+            Cursor = PieceEnd + 1;
+        }
+        OutVertex = Values[0];
+        OutTexture = Values[1];
+        OutNormal = Values[2];
+    }
+}
+
+bool FLoaderOBJ::ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo)
+{
+    const std::wstring WidePath = ObjFilePath.ToWideString();
+    FMappedFile File;
+    if (!File.Open(WidePath.c_str()))
+    {
+        return false;
+    }
+
+    OutObjInfo.PathName = WidePath.substr(0, WidePath.find_last_of(L"\\/") + 1);
+    OutObjInfo.ObjectName = WidePath.substr(WidePath.find_last_of(L"\\/") + 1);
+    // ObjectName은 wstring 타입이므로, 이를 string으로 변환 (간단한 ASCII 변환의 경우)
+    std::wstring wideName = OutObjInfo.ObjectName;
+    std::string fileName(wideName.begin(), wideName.end());
+
+    // 마지막 '.'을 찾아 확장자를 제거
+    size_t dotPos = fileName.find_last_of('.');
+    if (dotPos != std::string::npos) {
+        OutObjInfo.DisplayName = fileName.substr(0, dotPos);
+    } else {
+        OutObjInfo.DisplayName = fileName;
+    }
+
+    const char* Begin = reinterpret_cast<const char*>(File.GetData());
+    const char* End = Begin + File.GetSize();
+
+    // 1. 개수만 세어 배열을 한 번씩만 할당
+    int32 NumVertices = 0, NumNormals = 0, NumUVs = 0, NumIndices = 0;
+    for (FObjScanner Scanner{Begin, End}; !Scanner.IsAtEnd(); Scanner.NextLine())
+    {
+        const std::string_view Token = Scanner.ReadToken();
+        if (Token == "v") ++NumVertices;
+        else if (Token == "vn") ++NumNormals;
+        else if (Token == "vt") ++NumUVs;
+        else if (Token == "f")
+        {
+            int32 NumCorners = 0;
+            while (!Scanner.ReadToken().empty())
+                ++NumCorners;
+            NumIndices += NumCorners == 4 ? 6 : NumCorners == 3 ? 3 : 0;
+        }
+    }
+    OutObjInfo.Vertices.Reserve(OutObjInfo.Vertices.Num() + NumVertices);
+    OutObjInfo.Normals.Reserve(OutObjInfo.Normals.Num() + NumNormals);
+    OutObjInfo.UVs.Reserve(OutObjInfo.UVs.Num() + NumUVs);
+    OutObjInfo.VertexIndices.Reserve(OutObjInfo.VertexIndices.Num() + NumIndices);
+    OutObjInfo.TextureIndices.Reserve(OutObjInfo.TextureIndices.Num() + NumIndices);
+    OutObjInfo.NormalIndices.Reserve(OutObjInfo.NormalIndices.Num() + NumIndices);
+
+    // 2. 채우기. 쿼드는 0-1-2, 0-2-3 두 삼각형으로 나누고 3, 4각형이 아닌 면은 버림
+    constexpr int32 QuadCorners[6] = {0, 1, 2, 0, 2, 3};
+    for (FObjScanner Scanner{Begin, End}; !Scanner.IsAtEnd(); Scanner.NextLine())
+    {
+        const std::string_view Token = Scanner.ReadToken();
+        if (Token == "v") // Vertex
+        {
+            const float x = Scanner.ReadFloat();
+            const float y = Scanner.ReadFloat();
+            const float z = Scanner.ReadFloat();
+            OutObjInfo.Vertices.Add(FVector(x, y, z));
+        }
+        else if (Token == "vn") // Normal
+        {
+            const float nx = Scanner.ReadFloat();
+            const float ny = Scanner.ReadFloat();
+            const float nz = Scanner.ReadFloat();
+            OutObjInfo.Normals.Add(FVector(nx, ny, nz));
+        }
+        else if (Token == "vt") // Texture
+        {
+            const float u = Scanner.ReadFloat();
+            const float v = Scanner.ReadFloat();
+            OutObjInfo.UVs.Add(FVector2D(u, v));
+        }
+        else if (Token == "f")
+        {
+            uint32 FaceVertexIndices[4], FaceTextureIndices[4], FaceNormalIndices[4];
+            int32 NumCorners = 0;
+            for (std::string_view Corner = Scanner.ReadToken(); !Corner.empty(); Corner = Scanner.ReadToken())
+            {
+                if (NumCorners < 4)
+                    ParseFaceCorner(Corner, FaceVertexIndices[NumCorners], FaceTextureIndices[NumCorners], FaceNormalIndices[NumCorners]);
+                ++NumCorners;
+            }
+
+            const int32 NumFaceIndices = NumCorners == 4 ? 6 : NumCorners == 3 ? 3 : 0;
+            for (int32 i = 0; i < NumFaceIndices; ++i)
+            {
+                const int32 Corner = QuadCorners[i];
+                OutObjInfo.VertexIndices.Add(FaceVertexIndices[Corner]);
+                OutObjInfo.TextureIndices.Add(FaceTextureIndices[Corner]);
+                OutObjInfo.NormalIndices.Add(FaceNormalIndices[Corner]);
+            }
+        }
+        else if (Token == "mtllib")
+        {
+            OutObjInfo.MatName = std::string(Scanner.ReadToken());
+        }
+        else if (Token == "usemtl")
+        {
+            const FString MatName(std::string(Scanner.ReadToken()));
+
+            if (!OutObjInfo.MaterialSubsets.IsEmpty())
+            {
+                FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
+                LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
+            }
+
+            FMaterialSubset MaterialSubset;
+            MaterialSubset.MaterialName = MatName;
+            MaterialSubset.IndexStart = OutObjInfo.VertexIndices.Num();
+            MaterialSubset.IndexCount = 0;
+            OutObjInfo.MaterialSubsets.Add(MaterialSubset);
+        }
+        else if (Token == "g" || Token == "o")
+        {
+            OutObjInfo.GroupName.Add(std::string(Scanner.ReadToken()));
+            OutObjInfo.NumOfGroup++;
+        }
+    }
+
+    if (!OutObjInfo.MaterialSubsets.IsEmpty())
+    {
+        FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
+        LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
+    }
+
+    return true;
+}
+
+
+namespace
+{
+    // WeldEpsilon 격자 칸 좌표. 0이면 float 비트 그대로 써서 값이 정확히 같은 정점만 같은 칸에 들어감
+    int64 GetWeldCell(float Value, float WeldEpsilon)
+    {
+        if (WeldEpsilon > 0.0f)
+            return static_cast<int64>(std::floor(Value / WeldEpsilon));
+        const float Normalized = Value + 0.0f; // -0 -> +0
+        uint32 Bits;
+        memcpy(&Bits, &Normalized, sizeof(Bits));
+        return Bits;
+    }
+
+    uint64 HashWeldCell(int64 X, int64 Y, int64 Z, uint16 U, uint16 V)
+    {
+        uint64 Hash = 0xcbf29ce484222325ull;
+        for (const uint64 Value : {static_cast<uint64>(X), static_cast<uint64>(Y), static_cast<uint64>(Z), (static_cast<uint64>(U) << 16) | V})
+        {
+            Hash = (Hash ^ Value) * 0x100000001b3ull;
+        }
+        return Hash;
+    }
+}
+
+bool FLoaderOBJ::ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh, float WeldEpsilon, FVertexWeldStats* OutStats)
+{
+    OutStaticMesh.ObjectName = RawData.ObjectName;
+    OutStaticMesh.PathName = RawData.PathName;
+    OutStaticMesh.DisplayName = RawData.DisplayName;
+
+    const int32 NumCorners = RawData.VertexIndices.Num();
+    OutStaticMesh.Indices.SetNum(NumCorners);
+
+    // 1. 같은 v/vt 조합은 같은 FVertexCompact이므로 값 비교 없이 재사용 (법선은 FVertexCompact에 없으므로 vn은 무시)
+    std::unordered_map<uint64, uint32> CornerMap;
+    CornerMap.reserve(NumCorners);
+
+    // 2. 처음 보는 조합은 값으로 용접. 칸 해시 -> 정점 체인(NextInCell)으로 주변 칸의 후보만 비교
+    std::unordered_map<uint64, uint32> CellHeads;
+    CellHeads.reserve(NumCorners);
+    TArray<uint32> NextInCell;
+    const int32 NeighborRange = WeldEpsilon > 0.0f ? 1 : 0;
+
+    for (int32 i = 0; i < NumCorners; ++i)
+    {
+        const uint32 vIdx = RawData.VertexIndices[i];
+        const uint32 tIdx = RawData.TextureIndices[i];
+
+        const uint64 CornerKey = (static_cast<uint64>(vIdx) << 32) | tIdx;
+        if (const auto It = CornerMap.find(CornerKey); It != CornerMap.end())
+        {
+            OutStaticMesh.Indices[i] = It->second;
+            continue;
+        }
+
+        FVertexCompact vertex {};
+        vertex.x = RawData.Vertices[vIdx].x;
+        vertex.y = RawData.Vertices[vIdx].y;
+        vertex.z = RawData.Vertices[vIdx].z;
+
+        if (tIdx != UINT32_MAX && tIdx < RawData.UVs.Num())
+        {
+            float u = RawData.UVs[tIdx].x;
+            float v = -RawData.UVs[tIdx].y;
+
+            u = u * 0.5f + 0.5f;
+            v = v * 0.5f + 0.5f;
+            vertex.u = static_cast<uint16>(FMath::Clamp(u, 0.0f, 1.0f) * 65535.0f + 0.5f);
+            vertex.v = static_cast<uint16>(FMath::Clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+
+        const int64 CellX = GetWeldCell(vertex.x, WeldEpsilon);
+        const int64 CellY = GetWeldCell(vertex.y, WeldEpsilon);
+        const int64 CellZ = GetWeldCell(vertex.z, WeldEpsilon);
+
+        uint32 index = UINT32_MAX;
+        for (int64 dx = -NeighborRange; dx <= NeighborRange && index == UINT32_MAX; ++dx)
+        for (int64 dy = -NeighborRange; dy <= NeighborRange && index == UINT32_MAX; ++dy)
+        for (int64 dz = -NeighborRange; dz <= NeighborRange && index == UINT32_MAX; ++dz)
+        {
+            const auto Head = CellHeads.find(HashWeldCell(CellX + dx, CellY + dy, CellZ + dz, vertex.u, vertex.v));
+            if (Head == CellHeads.end())
+                continue;
+            // 해시 충돌로 다른 칸의 정점이 섞여 있어도 값 비교로 걸러짐
+            for (uint32 Candidate = Head->second; Candidate != UINT32_MAX; Candidate = NextInCell[Candidate])
+            {
+                const FVertexCompact& Other = OutStaticMesh.Vertices[Candidate];
+                if (Other.u == vertex.u && Other.v == vertex.v &&
+                    std::abs(Other.x - vertex.x) <= WeldEpsilon && std::abs(Other.y - vertex.y) <= WeldEpsilon && std::abs(Other.z - vertex.z) <= WeldEpsilon)
+                {
+                    index = Candidate;
+                    break;
+                }
+            }
+        }
+
+        if (index == UINT32_MAX)
+        {
+            index = OutStaticMesh.Vertices.Add(vertex);
+            uint32& Head = CellHeads.try_emplace(HashWeldCell(CellX, CellY, CellZ, vertex.u, vertex.v), UINT32_MAX).first->second;
+            NextInCell.Add(Head);
+            Head = index;
+        }
+
+        CornerMap.emplace(CornerKey, index);
+        OutStaticMesh.Indices[i] = index;
+    }
+
+    if (OutStats)
+    {
+        OutStats->NumCorners = NumCorners;
+        OutStats->NumVertices = OutStaticMesh.Vertices.Num();
+    }
+
+    // Calculate StaticMesh BoundingBox
+    ComputeBoundingBox(OutStaticMesh.Vertices, OutStaticMesh.BoundingBoxMin, OutStaticMesh.BoundingBoxMax);
+
+    return true;
+}
 
 OBJ::FStaticMeshRenderData* FManagerOBJ::LoadObjStaticMeshAsset(const FString& PathFileName)
 {
-    OBJ::FStaticMeshRenderData* NewStaticMesh = new OBJ::FStaticMeshRenderData();
-        
     if ( const auto It = ObjStaticMeshMap.Find(PathFileName))
     {
         return *It;
     }
-        
-    FWString BinaryPath = (PathFileName + ".bin").ToWideString();
-    if (std::ifstream(BinaryPath).good())
-    {/*
-            if (LoadStaticMeshFromBinary(BinaryPath, *NewStaticMesh))
-            {
-                ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
-                return NewStaticMesh;
-            }*/
+
+    LoadObjStaticMeshAssets({PathFileName});
+
+    const auto It = ObjStaticMeshMap.Find(PathFileName);
+    return It ? *It : nullptr;
+}
+
+void FManagerOBJ::LoadObjStaticMeshAssets(const TArray<FString>& PathFileNames, const std::function<void(int32, int32)>& OnProgress)
+{
+    struct FImportJob
+    {
+        FString PathFileName;
+        FObjInfo ObjInfo;
+        TArray<OBJ::FStaticMeshRenderData*> LODs;
+        TArray<FWString> Textures;
+        TArray<FMeshOptimizeStats> OptimizeStats; // LOD별. 캐시에서 읽은 메시는 비어 있음
+        TArray<FVector2D> QuantizationErrors;     // LOD별 (Pos16, Packed8) 왕복 오차. bLogVertexQuantization일 때만
+        FVertexWeldStats WeldStats;                // LOD0
+        bool bFromBinary = false;
+        bool bValid = false;
+    };
+
+    TArray<FString> NewPaths;
+    for (const FString& PathFileName : PathFileNames)
+    {
+        if (ObjStaticMeshMap.Find(PathFileName) == nullptr)
+        {
+            NewPaths.AddUnique(PathFileName);
+        }
+    }
+    if (NewPaths.Num() == 0)
+    {
+        return;
     }
-        
-    // Parse OBJ
-    FObjInfo NewObjInfo;
-    bool Result = FLoaderOBJ::ParseOBJ(PathFileName, NewObjInfo);
-    wchar_t buffer[256];  // 메시지를 저장할 버퍼
 
-    if (!Result)
+    TArray<FImportJob> Jobs;
+    Jobs.SetNum(NewPaths.Num());
+    for (int32 i = 0; i < NewPaths.Num(); ++i)
     {
-        delete NewStaticMesh;
-        return nullptr;
+        Jobs[i].PathFileName = NewPaths[i];
     }
 
-    // Material
-    if (NewObjInfo.MaterialSubsets.Num() > 0)
+    // 진행도 단위: 메시마다 로드 1 + LOD 빌드 NumLODs. 캐시에서 읽거나 실패한 메시는 LOD 몫까지 한 번에 완료
+    const int32 NumLODs = LODErrorThresholds.Num();
+    const int32 NumTotal = Jobs.Num() * (1 + NumLODs);
+    int32 NumCompleted = 0;
+    std::mutex ProgressMutex;
+    auto ReportProgress = [&](int32 Count)
     {
-        Result = FLoaderOBJ::ParseMaterial(NewObjInfo, *NewStaticMesh);
-        if (!Result)
+        if (!OnProgress) return;
+        std::lock_guard<std::mutex> Lock(ProgressMutex);
+        NumCompleted += Count;
+        OnProgress(NumCompleted, NumTotal);
+    };
+
+    // 1. .bin 캐시 또는 OBJ 파싱 (워커)
+    ParallelFor(Jobs.Num(), [&](int32 JobIndex)
+    {
+        FImportJob& Job = Jobs[JobIndex];
+        const FWString BinaryPath = (Job.PathFileName + ".bin").ToWideString();
+        if (ReadStaticMeshBinary(BinaryPath, Job.LODs, Job.Textures))
+        {
+            Job.bFromBinary = true;
+            Job.bValid = true;
+            ReportProgress(1 + NumLODs);
+            return;
+        }
+
+        OBJ::FStaticMeshRenderData* BaseLOD = new OBJ::FStaticMeshRenderData();
+        Job.bValid = FLoaderOBJ::ParseOBJ(Job.PathFileName, Job.ObjInfo) && FLoaderOBJ::ConvertToStaticMesh(Job.ObjInfo, *BaseLOD, VertexWeldEpsilon, &Job.WeldStats);
+        if (Job.bValid)
         {
-            delete NewStaticMesh;
-            return nullptr;
+            Job.LODs.Add(BaseLOD);
         }
-        CombineMaterialIndex(*NewStaticMesh);
-        for (int materialIndex = 0; materialIndex < NewStaticMesh->Materials.Num(); materialIndex++) {
-            CreateMaterial(NewStaticMesh->Materials[materialIndex]);
+        else
+        {
+            delete BaseLOD;
+        }
+        ReportProgress(Job.bValid ? 1 : 1 + NumLODs);
+    });
+
+    // 2. 머티리얼과 텍스처는 UObject 생성과 D3D 디바이스 컨텍스트를 쓰므로 호출 스레드에서
+    for (FImportJob& Job : Jobs)
+    {
+        if (!Job.bValid)
+            continue;
+
+        if (Job.bFromBinary)
+        {
+            LoadTextures(Job.Textures);
+            continue;
+        }
+
+        OBJ::FStaticMeshRenderData* BaseLOD = Job.LODs[0];
+        if (Job.ObjInfo.MaterialSubsets.Num() > 0)
+        {
+            if (!FLoaderOBJ::ParseMaterial(Job.ObjInfo, *BaseLOD))
+            {
+                delete BaseLOD;
+                Job.LODs.Empty();
+                Job.bValid = false;
+                ReportProgress(NumLODs);
+                continue;
+            }
+            CombineMaterialIndex(*BaseLOD);
+            for (int materialIndex = 0; materialIndex < BaseLOD->Materials.Num(); materialIndex++) {
+                CreateMaterial(BaseLOD->Materials[materialIndex]);
+            }
+        }
+        Job.LODs.SetNum(1 + NumLODs);
+        Job.OptimizeStats.SetNum(1 + NumLODs);
+        if (bLogVertexQuantization)
+        {
+            Job.QuantizationErrors.SetNum(1 + NumLODs);
         }
     }
-        
-    // Convert FStaticMeshRenderData
-    Result = FLoaderOBJ::ConvertToStaticMesh(NewObjInfo, *NewStaticMesh);
-    if (!Result)
+
+    // 3. 메시 x LOD 단위로 단순화하고 정점 캐시 순서 최적화 (워커). 각 LOD는 원본 FObjInfo에서 독립적으로 단순화하므로 서로 기다리지 않음.
+    //    레벨 0은 LOD0 최적화와 클러스터 분할만 함. 다른 레벨은 LOD0의 정점/인덱스를 읽지 않으므로 동시에 바꿔도 됨.
+    //    정점은 클러스터 분할 전에 캐시 레이아웃으로 반올림해서 첫 임포트와 .bin 로드가 같은 정점/클러스터를 갖게 함
+    TArray<int32> LODJobs; // 작업 인덱스 * (NumLODs + 1) + LOD 레벨
+    for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
     {
-        delete NewStaticMesh;
-        return nullptr;
+        if (!Jobs[JobIndex].bValid || Jobs[JobIndex].bFromBinary)
+            continue;
+        for (int32 Level = 0; Level <= NumLODs; ++Level)
+        {
+            LODJobs.Add(JobIndex * (NumLODs + 1) + Level);
+        }
     }
-    ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
+    auto FinalizeLOD = [](FImportJob& Job, int32 Level)
+    {
+        OBJ::FStaticMeshRenderData& LOD = *Job.LODs[Level];
+        const FVertexQuantizationBounds Bounds = FVertexQuantizationBounds::FromMesh(LOD);
+        if (!Job.QuantizationErrors.IsEmpty())
+        {
+            Job.QuantizationErrors[Level] = FVector2D(MeasureRoundTripError<FVertexPos16>(LOD.Vertices, Bounds), MeasureRoundTripError<FVertexPacked8>(LOD.Vertices, Bounds));
+        }
+#ifdef _DEBUG
+        // 바운드가 정점을 다 덮지 못하거나 코덱이 바뀌어 오차가 한도를 넘으면 캐시와 메모리의 정점이 조용히 틀어짐
+        check(IsRoundTripErrorWithinTolerance<FMeshCacheVertex>(LOD.Vertices, Bounds));
+#endif
+        QuantizeVertices<FMeshCacheVertex>(LOD.Vertices, Bounds);
+        FMeshClusterBuilder::Build(LOD);
+    };
+    ParallelFor(LODJobs.Num(), [&](int32 LODJobIndex)
+    {
+        FImportJob& Job = Jobs[LODJobs[LODJobIndex] / (NumLODs + 1)];
+        const int32 Level = LODJobs[LODJobIndex] % (NumLODs + 1);
+        if (Level == 0)
+        {
+            Job.OptimizeStats[0] = FMeshOptimizer::Optimize(*Job.LODs[0], bOptimizeOverdraw);
+            FinalizeLOD(Job, 0);
+            return;
+        }
+        const OBJ::FStaticMeshRenderData& BaseLOD = *Job.LODs[0];
+        const float MaxError = LODErrorThresholds[Level - 1] * (BaseLOD.BoundingBoxMax - BaseLOD.BoundingBoxMin).Magnitude();
+        Job.LODs[Level] = BuildSimplifiedLOD(Job.ObjInfo, BaseLOD, MaxError * MaxError, Level);
+        Job.OptimizeStats[Level] = FMeshOptimizer::Optimize(*Job.LODs[Level], bOptimizeOverdraw);
+        FinalizeLOD(Job, Level);
+        ReportProgress(1);
+    });
 
-    OBJ::FStaticMeshRenderData* DowngradeX5 = new OBJ::FStaticMeshRenderData();
-    FObjInfo DowngradeX5Obj = NewObjInfo;
-    QEMSimplifier::Simplify(DowngradeX5Obj, DowngradeX5Obj.Vertices.Num() * 0.5);
-    DowngradeX5Obj.ObjectName = DowngradeX5Obj.ObjectName + L"X5";
-    DowngradeX5Obj.MaterialSubsets[0].IndexCount = DowngradeX5Obj.VertexIndices.Num();
-    if (DowngradeX5Obj.MaterialSubsets.Num() > 0)
+    // 4. 새로 만든 체인은 .bin으로 캐시 (워커)
+    ParallelFor(Jobs.Num(), [&](int32 JobIndex)
     {
-        Result = FLoaderOBJ::ParseMaterial(DowngradeX5Obj, *DowngradeX5);
-        if (!Result)
+        const FImportJob& Job = Jobs[JobIndex];
+        if (Job.bValid && !Job.bFromBinary)
+        {
+            SaveStaticMeshToBinary((Job.PathFileName + ".bin").ToWideString(), Job.LODs);
+        }
+    });
+
+    for (const FImportJob& Job : Jobs)
+    {
+        if (!Job.bValid)
+            continue;
+        if (!Job.bFromBinary)
+        {
+            UE_LOG(LogLevel::Display, "%s vertex weld: %d corners -> %d vertices (%.2fx)", *Job.LODs[0]->DisplayName,
+                   Job.WeldStats.NumCorners, Job.WeldStats.NumVertices, Job.WeldStats.GetCompressionRatio());
+        }
+        if (!Job.QuantizationErrors.IsEmpty())
         {
-            delete DowngradeX5;
-            return nullptr;
+            // 전체 LOD 기준 레이아웃별 정점/인덱스 메모리와 왕복 오차 (바운드 대각선 대비, 반올림 전 정점 기준)
+            uint64 NumVertices = 0, IndexBytes = 0, CacheIndexBytes = 0;
+            float Pos16Error = 0.0f, Packed8Error = 0.0f;
+            for (int32 Level = 0; Level < Job.LODs.Num(); ++Level)
+            {
+                const OBJ::FStaticMeshRenderData* LOD = Job.LODs[Level];
+                NumVertices += LOD->Vertices.Num();
+                IndexBytes += LOD->Indices.Num() * sizeof(UINT);
+                CacheIndexBytes += LOD->Indices.Num() * MeshCache::GetIndexStride(LOD->Vertices.Num());
+                Pos16Error = FMath::Max(Pos16Error, Job.QuantizationErrors[Level].x);
+                Packed8Error = FMath::Max(Packed8Error, Job.QuantizationErrors[Level].y);
+            }
+            UE_LOG(LogLevel::Display, "%s vertex memory: %s %.1f KB, %s %.1f KB (error %.1e), %s %.1f KB (error %.1e), indices %.1f KB -> %.1f KB, cache uses %s",
+                   *Job.LODs[0]->DisplayName,
+                   TVertexCodec<FVertexCompact>::Name, NumVertices * sizeof(FVertexCompact) / 1024.0,
+                   TVertexCodec<FVertexPos16>::Name, NumVertices * sizeof(FVertexPos16) / 1024.0, Pos16Error,
+                   TVertexCodec<FVertexPacked8>::Name, NumVertices * sizeof(FVertexPacked8) / 1024.0, Packed8Error,
+                   IndexBytes / 1024.0, CacheIndexBytes / 1024.0, TVertexCodec<FMeshCacheVertex>::Name);
         }
-        CombineMaterialIndex(*DowngradeX5);
-        for (int materialIndex = 0; materialIndex < DowngradeX5->Materials.Num(); materialIndex++) {
-            CreateMaterial(DowngradeX5->Materials[materialIndex]);
+        for (int32 Level = 0; Level < Job.OptimizeStats.Num(); ++Level)
+        {
+            const FMeshOptimizeStats& Stats = Job.OptimizeStats[Level];
+            UE_LOG(LogLevel::Display, "%s LOD%d vertex cache: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %d clusters", *Job.LODs[0]->DisplayName, Level,
+                   Stats.Before.ACMR, Stats.After.ACMR, Stats.Before.ATVR, Stats.After.ATVR, Job.LODs[Level]->Clusters.Num());
         }
+        ObjStaticMeshMap.Add(Job.PathFileName, Job.LODs[0]);
+        ObjStaticMeshLODMap.Add(Job.PathFileName, Job.LODs);
     }
-    FLoaderOBJ::ConvertToStaticMesh(DowngradeX5Obj, *DowngradeX5);
-    ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
-    UStaticMesh* staticMeshDowngradeX5 = FObjectFactory::ConstructObject<UStaticMesh>();
-    staticMeshDowngradeX5->SetData(DowngradeX5);
-    staticMeshMap.Add(DowngradeX5->ObjectName, staticMeshDowngradeX5);
+}
 
-    
-    OBJ::FStaticMeshRenderData* DowngradeX1 = new OBJ::FStaticMeshRenderData();
-    FObjInfo DowngradeX1Obj = NewObjInfo;
-    QEMSimplifier::Simplify(DowngradeX1Obj, DowngradeX1Obj.Vertices.Num() * 0.1);
-    DowngradeX1Obj.ObjectName = DowngradeX1Obj.ObjectName + L"X1";
-    DowngradeX1Obj.MaterialSubsets[0].IndexCount = DowngradeX1Obj.VertexIndices.Num();
-    if (DowngradeX1Obj.MaterialSubsets.Num() > 0)
+bool FManagerOBJ::ValidateVertexQuantization()
+{
+    // 불러온 LOD는 이미 캐시 레이아웃 격자 위에 있으므로 그 레이아웃으로 다시 왕복해도 한도 안이어야 하고,
+    // 다른 레이아웃도 바운드 기준 한도를 지켜야 함
+    int32 NumChecked = 0;
+    int32 NumFailed = 0;
+    for (const auto& Pair : ObjStaticMeshLODMap)
     {
-        Result = FLoaderOBJ::ParseMaterial(DowngradeX1Obj, *DowngradeX1);
-        if (!Result)
+        for (const OBJ::FStaticMeshRenderData* LOD : Pair.Value)
         {
-            delete DowngradeX1;
-            return nullptr;
-        }
-        CombineMaterialIndex(*DowngradeX1);
-        for (int materialIndex = 0; materialIndex < DowngradeX1->Materials.Num(); materialIndex++) {
-            CreateMaterial(DowngradeX1->Materials[materialIndex]);
+            if (!LOD) continue;
+            const FVertexQuantizationBounds Bounds = FVertexQuantizationBounds::FromMesh(*LOD);
+            const bool bPos16 = IsRoundTripErrorWithinTolerance<FVertexPos16>(LOD->Vertices, Bounds);
+            const bool bPacked8 = IsRoundTripErrorWithinTolerance<FVertexPacked8>(LOD->Vertices, Bounds);
+            ++NumChecked;
+            if (bPos16 && bPacked8) continue;
+
+            ++NumFailed;
+            UE_LOG(LogLevel::Error, "%s vertex quantization out of tolerance: %s %.1e (max %.1e), %s %.1e (max %.1e)", *LOD->DisplayName,
+                   TVertexCodec<FVertexPos16>::Name, MeasureRoundTripError<FVertexPos16>(LOD->Vertices, Bounds), TVertexCodec<FVertexPos16>::MaxRelativeError,
+                   TVertexCodec<FVertexPacked8>::Name, MeasureRoundTripError<FVertexPacked8>(LOD->Vertices, Bounds), TVertexCodec<FVertexPacked8>::MaxRelativeError);
         }
     }
-    FLoaderOBJ::ConvertToStaticMesh(DowngradeX1Obj, *DowngradeX1);
-    ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
-    UStaticMesh* staticMeshDowngradeX1 = FObjectFactory::ConstructObject<UStaticMesh>();
-    staticMeshDowngradeX1->SetData(DowngradeX1);
-    staticMeshMap.Add(DowngradeX1->ObjectName, staticMeshDowngradeX1);
-    return NewStaticMesh;
+    UE_LOG(NumFailed ? LogLevel::Error : LogLevel::Display, "vertex quantization check: %d / %d LODs within tolerance", NumChecked - NumFailed, NumChecked);
+    return NumFailed == 0;
+}
+
+OBJ::FStaticMeshRenderData* FManagerOBJ::BuildSimplifiedLOD(const FObjInfo& BaseObjInfo, const OBJ::FStaticMeshRenderData& BaseLOD, float MaxError, int32 LODIndex)
+{
+    // 정점 수 목표 없이 오차 한도까지만 축소
+    FObjInfo SimplifiedObjInfo = BaseObjInfo;
+    QEMSimplifier::Simplify(SimplifiedObjInfo, 3, MaxError);
+
+    OBJ::FStaticMeshRenderData* NewLOD = new OBJ::FStaticMeshRenderData();
+    FLoaderOBJ::ConvertToStaticMesh(SimplifiedObjInfo, *NewLOD, VertexWeldEpsilon);
+    NewLOD->ObjectName = BaseLOD.ObjectName + L"_LOD" + std::to_wstring(LODIndex);
+
+    // 단순화 후에는 면 순서가 서브셋 구간과 맞지 않으므로 첫 머티리얼 하나로 전체를 그림 (기존 X5/X1과 동일)
+    NewLOD->Materials = BaseLOD.Materials;
+    if (BaseLOD.MaterialSubsets.Num() > 0)
+    {
+        FMaterialSubset Subset = BaseLOD.MaterialSubsets[0];
+        Subset.IndexStart = 0;
+        Subset.IndexCount = NewLOD->Indices.Num();
+        NewLOD->MaterialSubsets.Add(Subset);
+    }
+    return NewLOD;
 }
 
 void FManagerOBJ::CombineMaterialIndex(OBJ::FStaticMeshRenderData& OutFStaticMesh)
@@ -125,182 +639,468 @@ void FManagerOBJ::CombineMaterialIndex(OBJ::FStaticMeshRenderData& OutFStaticMes
     }
 }
 
-bool FManagerOBJ::SaveStaticMeshToBinary(const FWString& FilePath, const OBJ::FStaticMeshRenderData& StaticMesh)
+namespace
 {
+    // .bin 캐시를 메모리에서 조립한 뒤 한 번에 씀
+    struct FMeshCacheWriter
+    {
+        TArray<uint8> Bytes;
+        TArray<MeshCache::FChunk> Chunks;
+
+        void WriteBytes(const void* Data, uint64 Size)
+        {
+            const int32 Offset = Bytes.Num();
+            Bytes.SetNum(Offset + static_cast<int32>(Size));
+            if (Size > 0)
+                memcpy(Bytes.GetData() + Offset, Data, Size);
+        }
+
+        template <typename T>
+        void Write(const T& Value) { WriteBytes(&Value, sizeof(T)); }
+
+        void WriteString(const FString& String)
+        {
+            const uint32 Length = String.Len();
+            Write(Length);
+            WriteBytes(GetData(String), Length * sizeof(FString::ElementType));
+        }
+
+        void WriteWString(const FWString& String)
+        {
+            const uint32 Length = static_cast<uint32>(String.length());
+            Write(Length);
+            WriteBytes(String.c_str(), Length * sizeof(wchar_t));
+        }
+
+        void Align()
+        {
+            const uint64 Padding = (MeshCache::ChunkAlignment - Bytes.Num() % MeshCache::ChunkAlignment) % MeshCache::ChunkAlignment;
+            Bytes.SetNum(Bytes.Num() + static_cast<int32>(Padding));
+        }
+
+        void BeginChunk(MeshCache::EChunkType Type, uint32 LODIndex)
+        {
+            Align();
+            Chunks.Add({Type, LODIndex, static_cast<uint64>(Bytes.Num()), 0});
+        }
+
+        void EndChunk()
+        {
+            Chunks.Last().Size = Bytes.Num() - Chunks.Last().Offset;
+        }
+    };
+
+    // 매핑된 청크를 앞에서부터 읽음. 범위를 넘으면 bValid가 false가 되고 이후 읽기는 무시
+    struct FMeshCacheReader
+    {
+        const uint8* Cursor;
+        const uint8* End;
+        bool bValid = true;
+
+        bool ReadBytes(void* Out, uint64 Size)
+        {
+            if (!bValid || Size > static_cast<uint64>(End - Cursor))
+            {
+                bValid = false;
+                return false;
+            }
+            if (Size > 0)
+                memcpy(Out, Cursor, Size);
+            Cursor += Size;
+            return true;
+        }
+
+        template <typename T>
+        void Read(T& Out) { ReadBytes(&Out, sizeof(T)); }
+
+        // 임시 버퍼 없이 매핑된 바이트에서 바로 문자열 생성
+        void ReadString(FString& Out)
+        {
+            uint32 Length = 0;
+            Read(Length);
+            const uint64 Size = static_cast<uint64>(Length) * sizeof(FString::ElementType);
+            if (!bValid || Size > static_cast<uint64>(End - Cursor))
+            {
+                bValid = false;
+                return;
+            }
+            Out = std::basic_string<FString::ElementType>(reinterpret_cast<const FString::ElementType*>(Cursor), Length);
+            Cursor += Size;
+        }
+
+        void ReadWString(FWString& Out)
+        {
+            uint32 Length = 0;
+            Read(Length);
+            Out.resize(Length);
+            ReadBytes(Out.data(), static_cast<uint64>(Length) * sizeof(wchar_t));
+        }
+    };
+
+    // .bin 경로에서 원본 OBJ 경로 ("Foo.obj.bin" -> "Foo.obj")
+    FWString GetCacheSourcePath(const FWString& CachePath)
+    {
+        const FWString Extension = L".bin";
+        if (CachePath.size() > Extension.size() && CachePath.compare(CachePath.size() - Extension.size(), Extension.size(), Extension) == 0)
+        {
+            return CachePath.substr(0, CachePath.size() - Extension.size());
+        }
+        return CachePath;
+    }
+
+    void WriteMeshInfo(FMeshCacheWriter& Writer, const OBJ::FStaticMeshRenderData& StaticMesh)
+    {
+        Writer.WriteWString(StaticMesh.ObjectName);
+        Writer.WriteWString(StaticMesh.PathName);
+        Writer.WriteString(StaticMesh.DisplayName);
+
+        // Materials
+        Writer.Write(static_cast<uint32>(StaticMesh.Materials.Num()));
+        for (const FObjMaterialInfo& Material : StaticMesh.Materials)
+        {
+            Writer.WriteString(Material.MTLName);
+            Writer.Write(Material.bHasTexture);
+            Writer.Write(Material.bTransparent);
+            Writer.Write(Material.Diffuse);
+            Writer.Write(Material.Specular);
+            Writer.Write(Material.Ambient);
+            Writer.Write(Material.Emissive);
+            Writer.Write(Material.SpecularScalar);
+            Writer.Write(Material.DensityScalar);
+            Writer.Write(Material.TransparencyScalar);
+            Writer.Write(Material.IlluminanceModel);
+
+            Writer.WriteString(Material.DiffuseTextureName);
+            Writer.WriteWString(Material.DiffuseTexturePath);
+            Writer.WriteString(Material.AmbientTextureName);
+            Writer.WriteWString(Material.AmbientTexturePath);
+            Writer.WriteString(Material.SpecularTextureName);
+            Writer.WriteWString(Material.SpecularTexturePath);
+            Writer.WriteString(Material.BumpTextureName);
+            Writer.WriteWString(Material.BumpTexturePath);
+            Writer.WriteString(Material.AlphaTextureName);
+            Writer.WriteWString(Material.AlphaTexturePath);
+        }
+
+        // Material Subsets
+        Writer.Write(static_cast<uint32>(StaticMesh.MaterialSubsets.Num()));
+        for (const FMaterialSubset& Subset : StaticMesh.MaterialSubsets)
+        {
+            Writer.WriteString(Subset.MaterialName);
+            Writer.Write(Subset.IndexStart);
+            Writer.Write(Subset.IndexCount);
+            Writer.Write(Subset.MaterialIndex);
+        }
+
+        // Bounding Box
+        Writer.Write(StaticMesh.BoundingBoxMin);
+        Writer.Write(StaticMesh.BoundingBoxMax);
+    }
+
+    void ReadMeshInfo(FMeshCacheReader& Reader, OBJ::FStaticMeshRenderData& OutStaticMesh, TArray<FWString>& OutTextures)
+    {
+        Reader.ReadWString(OutStaticMesh.ObjectName);
+        Reader.ReadWString(OutStaticMesh.PathName);
+        Reader.ReadString(OutStaticMesh.DisplayName);
+
+        // Materials
+        uint32 MaterialCount = 0;
+        Reader.Read(MaterialCount);
+        if (!Reader.bValid || MaterialCount > static_cast<uint64>(Reader.End - Reader.Cursor))
+        {
+            Reader.bValid = false;
+            return;
+        }
+        OutStaticMesh.Materials.SetNum(MaterialCount);
+        for (FObjMaterialInfo& Material : OutStaticMesh.Materials)
+        {
+            Reader.ReadString(Material.MTLName);
+            Reader.Read(Material.bHasTexture);
+            Reader.Read(Material.bTransparent);
+            Reader.Read(Material.Diffuse);
+            Reader.Read(Material.Specular);
+            Reader.Read(Material.Ambient);
+            Reader.Read(Material.Emissive);
+            Reader.Read(Material.SpecularScalar);
+            Reader.Read(Material.DensityScalar);
+            Reader.Read(Material.TransparencyScalar);
+            Reader.Read(Material.IlluminanceModel);
+
+            Reader.ReadString(Material.DiffuseTextureName);
+            Reader.ReadWString(Material.DiffuseTexturePath);
+            Reader.ReadString(Material.AmbientTextureName);
+            Reader.ReadWString(Material.AmbientTexturePath);
+            Reader.ReadString(Material.SpecularTextureName);
+            Reader.ReadWString(Material.SpecularTexturePath);
+            Reader.ReadString(Material.BumpTextureName);
+            Reader.ReadWString(Material.BumpTexturePath);
+            Reader.ReadString(Material.AlphaTextureName);
+            Reader.ReadWString(Material.AlphaTexturePath);
+
+            for (const FWString* TexturePath : {&Material.DiffuseTexturePath, &Material.AmbientTexturePath, &Material.SpecularTexturePath,
+                                                &Material.BumpTexturePath, &Material.AlphaTexturePath})
+            {
+                if (!TexturePath->empty())
+                {
+                    OutTextures.AddUnique(*TexturePath);
+                }
+            }
+        }
+
+        // Material Subsets
+        uint32 SubsetCount = 0;
+        Reader.Read(SubsetCount);
+        if (!Reader.bValid || SubsetCount > static_cast<uint64>(Reader.End - Reader.Cursor))
+        {
+            Reader.bValid = false;
+            return;
+        }
+        OutStaticMesh.MaterialSubsets.SetNum(SubsetCount);
+        for (FMaterialSubset& Subset : OutStaticMesh.MaterialSubsets)
+        {
+            Reader.ReadString(Subset.MaterialName);
+            Reader.Read(Subset.IndexStart);
+            Reader.Read(Subset.IndexCount);
+            Reader.Read(Subset.MaterialIndex);
+        }
+
+        // Bounding Box
+        Reader.Read(OutStaticMesh.BoundingBoxMin);
+        Reader.Read(OutStaticMesh.BoundingBoxMax);
+    }
+}
+
+bool FManagerOBJ::SaveStaticMeshToBinary(const FWString& FilePath, const TArray<OBJ::FStaticMeshRenderData*>& LODs)
+{
+    MeshCache::FHeader Header = {};
+    Header.Magic = MeshCache::Magic;
+    Header.Version = MeshCache::Version;
+    Header.VertexStride = sizeof(FMeshCacheVertex);
+    Header.NumLODs = LODs.Num();
+    FPlatformFile::GetFileStamp(GetCacheSourcePath(FilePath).c_str(), Header.SourceTimestamp, Header.SourceSize);
+
+    FMeshCacheWriter Writer;
+    Writer.Write(Header);
+
+    // LOD 체인 생성에 쓴 임계값. 바뀌면 Load에서 버리고 다시 생성
+    Writer.BeginChunk(MeshCache::EChunkType::LODThresholds, 0);
+    Writer.WriteBytes(LODErrorThresholds.GetData(), LODErrorThresholds.Num() * sizeof(float));
+    Writer.EndChunk();
+
+    Writer.BeginChunk(MeshCache::EChunkType::ImportSettings, 0);
+    Writer.Write(MeshCache::FImportSettings{VertexWeldEpsilon});
+    Writer.EndChunk();
+
+    for (int32 LODIndex = 0; LODIndex < LODs.Num(); ++LODIndex)
+    {
+        const OBJ::FStaticMeshRenderData& StaticMesh = *LODs[LODIndex];
+
+        Writer.BeginChunk(MeshCache::EChunkType::MeshInfo, LODIndex);
+        WriteMeshInfo(Writer, StaticMesh);
+        Writer.EndChunk();
+
+        // 정점은 LOD 자신의 바운드 기준으로 양자화. 임포트 때 같은 기준으로 이미 반올림했으므로 값이 그대로 저장됨
+        const int32 NumVertices = StaticMesh.Vertices.Num();
+        const MeshCache::FVertexChunkHeader VertexHeader = {FVertexQuantizationBounds::FromMesh(StaticMesh), static_cast<uint32>(NumVertices), 0};
+        TArray<FMeshCacheVertex> EncodedVertices;
+        EncodedVertices.SetNum(NumVertices);
+        EncodeVertices(StaticMesh.Vertices.GetData(), NumVertices, VertexHeader.Bounds, EncodedVertices.GetData());
+
+        Writer.BeginChunk(MeshCache::EChunkType::Vertices, LODIndex);
+        Writer.Write(VertexHeader);
+        Writer.WriteBytes(EncodedVertices.GetData(), NumVertices * sizeof(FMeshCacheVertex));
+        Writer.EndChunk();
+
+        Writer.BeginChunk(MeshCache::EChunkType::Indices, LODIndex);
+        if (MeshCache::GetIndexStride(NumVertices) == sizeof(uint16))
+        {
+            TArray<uint16> ShortIndices;
+            ShortIndices.SetNum(StaticMesh.Indices.Num());
+            for (int32 i = 0; i < StaticMesh.Indices.Num(); ++i)
+            {
+                ShortIndices[i] = static_cast<uint16>(StaticMesh.Indices[i]);
+            }
+            Writer.WriteBytes(ShortIndices.GetData(), ShortIndices.Num() * sizeof(uint16));
+        }
+        else
+        {
+            Writer.WriteBytes(StaticMesh.Indices.GetData(), StaticMesh.Indices.Num() * sizeof(UINT));
+        }
+        Writer.EndChunk();
+
+        Writer.BeginChunk(MeshCache::EChunkType::Clusters, LODIndex);
+        Writer.WriteBytes(StaticMesh.Clusters.GetData(), StaticMesh.Clusters.Num() * sizeof(FMeshCluster));
+        Writer.EndChunk();
+    }
+
+    Writer.Align();
+    Header.ChunkTableOffset = Writer.Bytes.Num();
+    Header.NumChunks = Writer.Chunks.Num();
+    Writer.WriteBytes(Writer.Chunks.GetData(), Writer.Chunks.Num() * sizeof(MeshCache::FChunk));
+
+    Header.Checksum = MeshCache::ComputeChecksum(Writer.Bytes.GetData() + sizeof(Header), Writer.Bytes.Num() - sizeof(Header));
+    memcpy(Writer.Bytes.GetData(), &Header, sizeof(Header));
+
     std::ofstream File(FilePath, std::ios::binary);
     if (!File.is_open())
     {
-        assert("CAN'T SAVE STATIC MESH BINARY FILE");
         return false;
     }
+    File.write(reinterpret_cast<const char*>(Writer.Bytes.GetData()), Writer.Bytes.Num());
+    return File.good();
+}
 
-    // Object Name
-    Serializer::WriteFWString(File, StaticMesh.ObjectName);
-
-    // Path Name
-    Serializer::WriteFWString(File, StaticMesh.PathName);
-
-    // Display Name
-    Serializer::WriteFString(File, StaticMesh.DisplayName);
-
-    // Vertices
-    uint32 VertexCount = StaticMesh.Vertices.Num();
-    File.write(reinterpret_cast<const char*>(&VertexCount), sizeof(VertexCount));
-    File.write(reinterpret_cast<const char*>(StaticMesh.Vertices.GetData()), VertexCount * sizeof(FVertexCompact));
-
-    // Indices
-    uint32 IndexCount = StaticMesh.Indices.Num();
-    File.write(reinterpret_cast<const char*>(&IndexCount), sizeof(IndexCount));
-    File.write(reinterpret_cast<const char*>(StaticMesh.Indices.GetData()), IndexCount * sizeof(UINT));
-
-    // Materials
-    uint32 MaterialCount = StaticMesh.Materials.Num();
-    File.write(reinterpret_cast<const char*>(&MaterialCount), sizeof(MaterialCount));
-    for (const FObjMaterialInfo& Material : StaticMesh.Materials)
-    {
-        Serializer::WriteFString(File, Material.MTLName);
-        File.write(reinterpret_cast<const char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
-        File.write(reinterpret_cast<const char*>(&Material.bTransparent), sizeof(Material.bTransparent));
-        File.write(reinterpret_cast<const char*>(&Material.Diffuse), sizeof(Material.Diffuse));
-        File.write(reinterpret_cast<const char*>(&Material.Specular), sizeof(Material.Specular));
-        File.write(reinterpret_cast<const char*>(&Material.Ambient), sizeof(Material.Ambient));
-        File.write(reinterpret_cast<const char*>(&Material.Emissive), sizeof(Material.Emissive));
-        File.write(reinterpret_cast<const char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
-        File.write(reinterpret_cast<const char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
-        File.write(reinterpret_cast<const char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
-        File.write(reinterpret_cast<const char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
-
-        Serializer::WriteFString(File, Material.DiffuseTextureName);
-        Serializer::WriteFWString(File, Material.DiffuseTexturePath);
-        Serializer::WriteFString(File, Material.AmbientTextureName);
-        Serializer::WriteFWString(File, Material.AmbientTexturePath);
-        Serializer::WriteFString(File, Material.SpecularTextureName);
-        Serializer::WriteFWString(File, Material.SpecularTexturePath);
-        Serializer::WriteFString(File, Material.BumpTextureName);
-        Serializer::WriteFWString(File, Material.BumpTexturePath);
-        Serializer::WriteFString(File, Material.AlphaTextureName);
-        Serializer::WriteFWString(File, Material.AlphaTexturePath);
-    }
-
-    // Material Subsets
-    uint32 SubsetCount = StaticMesh.MaterialSubsets.Num();
-    File.write(reinterpret_cast<const char*>(&SubsetCount), sizeof(SubsetCount));
-    for (const FMaterialSubset& Subset : StaticMesh.MaterialSubsets)
-    {
-        Serializer::WriteFString(File, Subset.MaterialName);
-        File.write(reinterpret_cast<const char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
-        File.write(reinterpret_cast<const char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
-        File.write(reinterpret_cast<const char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
-    }
-
-    // Bounding Box
-    File.write(reinterpret_cast<const char*>(&StaticMesh.BoundingBoxMin), sizeof(FVector));
-    File.write(reinterpret_cast<const char*>(&StaticMesh.BoundingBoxMax), sizeof(FVector));
-        
-    File.close();
+bool FManagerOBJ::LoadStaticMeshFromBinary(const FWString& FilePath, TArray<OBJ::FStaticMeshRenderData*>& OutLODs)
+{
+    TArray<FWString> Textures;
+    if (!ReadStaticMeshBinary(FilePath, OutLODs, Textures))
+    {
+        return false;
+    }
+    LoadTextures(Textures);
     return true;
 }
 
-bool FManagerOBJ::LoadStaticMeshFromBinary(const FWString& FilePath, OBJ::FStaticMeshRenderData& OutStaticMesh)
+bool FManagerOBJ::ReadStaticMeshBinary(const FWString& FilePath, TArray<OBJ::FStaticMeshRenderData*>& OutLODs, TArray<FWString>& OutTextures)
 {
-    std::ifstream File(FilePath, std::ios::binary);
-    if (!File.is_open())
+    FMappedFile File;
+    if (!File.Open(FilePath.c_str()) || File.GetSize() < sizeof(MeshCache::FHeader))
     {
-        assert("CAN'T OPEN STATIC MESH BINARY FILE");
         return false;
     }
+    const uint8* Data = File.GetData();
+    const uint64 Size = File.GetSize();
 
-    TArray<FWString> Textures;
-
-    // Object Name
-    Serializer::ReadFWString(File, OutStaticMesh.ObjectName);
+    MeshCache::FHeader Header;
+    memcpy(&Header, Data, sizeof(Header));
+    if (Header.Magic != MeshCache::Magic || Header.Version != MeshCache::Version || Header.VertexStride != sizeof(FMeshCacheVertex) ||
+        Header.NumLODs != static_cast<uint32>(LODErrorThresholds.Num() + 1) ||
+        Header.ChunkTableOffset % MeshCache::ChunkAlignment != 0 || Header.ChunkTableOffset > Size ||
+        Header.NumChunks > (Size - Header.ChunkTableOffset) / sizeof(MeshCache::FChunk))
+    {
+        return false;
+    }
 
-    // Path Name
-    Serializer::ReadFWString(File, OutStaticMesh.PathName);
+    // 원본 OBJ가 캐시 이후에 바뀌었으면 다시 생성. 원본 없이 캐시만 있는 경우는 그대로 사용
+    uint64 SourceTimestamp = 0, SourceSize = 0;
+    if (FPlatformFile::GetFileStamp(GetCacheSourcePath(FilePath).c_str(), SourceTimestamp, SourceSize) &&
+        (SourceTimestamp != Header.SourceTimestamp || SourceSize != Header.SourceSize))
+    {
+        return false;
+    }
 
-    // Display Name
-    Serializer::ReadFString(File, OutStaticMesh.DisplayName);
+    if (MeshCache::ComputeChecksum(Data + sizeof(Header), Size - sizeof(Header)) != Header.Checksum)
+    {
+        return false;
+    }
 
-    // Vertices
-    uint32 VertexCount = 0;
-    File.read(reinterpret_cast<char*>(&VertexCount), sizeof(VertexCount));
-    OutStaticMesh.Vertices.SetNum(VertexCount);
-    File.read(reinterpret_cast<char*>(OutStaticMesh.Vertices.GetData()), VertexCount * sizeof(FVertexCompact));
+    const MeshCache::FChunk* Chunks = reinterpret_cast<const MeshCache::FChunk*>(Data + Header.ChunkTableOffset);
+    auto FindChunk = [&](MeshCache::EChunkType Type, uint32 LODIndex) -> const MeshCache::FChunk*
+    {
+        for (uint32 i = 0; i < Header.NumChunks; ++i)
+        {
+            const MeshCache::FChunk& Chunk = Chunks[i];
+            if (Chunk.Type == Type && Chunk.LODIndex == LODIndex)
+            {
+                const bool bInBounds = Chunk.Offset >= sizeof(Header) && Chunk.Offset <= Header.ChunkTableOffset && Chunk.Size <= Header.ChunkTableOffset - Chunk.Offset;
+                return bInBounds ? &Chunk : nullptr;
+            }
+        }
+        return nullptr;
+    };
 
-    // Indices
-    uint32 IndexCount = 0;
-    File.read(reinterpret_cast<char*>(&IndexCount), sizeof(IndexCount));
-    OutStaticMesh.Indices.SetNum(IndexCount);
-    File.read(reinterpret_cast<char*>(OutStaticMesh.Indices.GetData()), IndexCount * sizeof(UINT));
+    const MeshCache::FChunk* Thresholds = FindChunk(MeshCache::EChunkType::LODThresholds, 0);
+    if (!Thresholds || Thresholds->Size != LODErrorThresholds.Num() * sizeof(float) ||
+        (Thresholds->Size > 0 && memcmp(Data + Thresholds->Offset, LODErrorThresholds.GetData(), Thresholds->Size) != 0))
+    {
+        return false;
+    }
 
-    // Material
-    uint32 MaterialCount = 0;
-    File.read(reinterpret_cast<char*>(&MaterialCount), sizeof(MaterialCount));
-    OutStaticMesh.Materials.SetNum(MaterialCount);
-    for (FObjMaterialInfo& Material : OutStaticMesh.Materials)
+    const MeshCache::FChunk* Settings = FindChunk(MeshCache::EChunkType::ImportSettings, 0);
+    MeshCache::FImportSettings ImportSettings;
+    if (!Settings || Settings->Size != sizeof(ImportSettings))
+    {
+        return false;
+    }
+    memcpy(&ImportSettings, Data + Settings->Offset, sizeof(ImportSettings));
+    if (ImportSettings.VertexWeldEpsilon != VertexWeldEpsilon)
     {
-        Serializer::ReadFString(File, Material.MTLName);
-        File.read(reinterpret_cast<char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
-        File.read(reinterpret_cast<char*>(&Material.bTransparent), sizeof(Material.bTransparent));
-        File.read(reinterpret_cast<char*>(&Material.Diffuse), sizeof(Material.Diffuse));
-        File.read(reinterpret_cast<char*>(&Material.Specular), sizeof(Material.Specular));
-        File.read(reinterpret_cast<char*>(&Material.Ambient), sizeof(Material.Ambient));
-        File.read(reinterpret_cast<char*>(&Material.Emissive), sizeof(Material.Emissive));
-        File.read(reinterpret_cast<char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
-        File.read(reinterpret_cast<char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
-        File.read(reinterpret_cast<char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
-        File.read(reinterpret_cast<char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
-        Serializer::ReadFString(File, Material.DiffuseTextureName);
-        Serializer::ReadFWString(File, Material.DiffuseTexturePath);
-        Serializer::ReadFString(File, Material.AmbientTextureName);
-        Serializer::ReadFWString(File, Material.AmbientTexturePath);
-        Serializer::ReadFString(File, Material.SpecularTextureName);
-        Serializer::ReadFWString(File, Material.SpecularTexturePath);
-        Serializer::ReadFString(File, Material.BumpTextureName);
-        Serializer::ReadFWString(File, Material.BumpTexturePath);
-        Serializer::ReadFString(File, Material.AlphaTextureName);
-        Serializer::ReadFWString(File, Material.AlphaTexturePath);
+        return false;
+    }
 
-        if (!Material.DiffuseTexturePath.empty())
+    bool bValid = true;
+    for (uint32 LODIndex = 0; bValid && LODIndex < Header.NumLODs; ++LODIndex)
+    {
+        const MeshCache::FChunk* MeshInfo = FindChunk(MeshCache::EChunkType::MeshInfo, LODIndex);
+        const MeshCache::FChunk* Vertices = FindChunk(MeshCache::EChunkType::Vertices, LODIndex);
+        const MeshCache::FChunk* Indices = FindChunk(MeshCache::EChunkType::Indices, LODIndex);
+        const MeshCache::FChunk* Clusters = FindChunk(MeshCache::EChunkType::Clusters, LODIndex);
+        if (!MeshInfo || !Vertices || !Indices || !Clusters || Vertices->Size < sizeof(MeshCache::FVertexChunkHeader) || Clusters->Size % sizeof(FMeshCluster) != 0)
         {
-            Textures.AddUnique(Material.DiffuseTexturePath);
+            bValid = false;
+            break;
         }
-        if (!Material.AmbientTexturePath.empty())
+        MeshCache::FVertexChunkHeader VertexHeader;
+        memcpy(&VertexHeader, Data + Vertices->Offset, sizeof(VertexHeader));
+        const uint32 IndexStride = MeshCache::GetIndexStride(VertexHeader.NumVertices);
+        if (Vertices->Size != sizeof(VertexHeader) + static_cast<uint64>(VertexHeader.NumVertices) * sizeof(FMeshCacheVertex) || Indices->Size % IndexStride != 0)
         {
-            Textures.AddUnique(Material.AmbientTexturePath);
+            bValid = false;
+            break;
         }
-        if (!Material.SpecularTexturePath.empty())
+
+        OBJ::FStaticMeshRenderData* LOD = new OBJ::FStaticMeshRenderData();
+        OutLODs.Add(LOD);
+
+        FMeshCacheReader Reader{Data + MeshInfo->Offset, Data + MeshInfo->Offset + MeshInfo->Size};
+        ReadMeshInfo(Reader, *LOD, OutTextures);
+        bValid = Reader.bValid;
+
+        // 정렬된 청크에서 바로 디코딩. 32비트 인덱스는 한 번에 복사
+        LOD->Vertices.SetNum(static_cast<int32>(VertexHeader.NumVertices));
+        DecodeVertices(reinterpret_cast<const FMeshCacheVertex*>(Data + Vertices->Offset + sizeof(VertexHeader)), LOD->Vertices.Num(), VertexHeader.Bounds, LOD->Vertices.GetData());
+        LOD->Indices.SetNum(static_cast<int32>(Indices->Size / IndexStride));
+        if (IndexStride == sizeof(uint16))
         {
-            Textures.AddUnique(Material.SpecularTexturePath);
+            const uint16* ShortIndices = reinterpret_cast<const uint16*>(Data + Indices->Offset);
+            for (int32 i = 0; i < LOD->Indices.Num(); ++i)
+            {
+                LOD->Indices[i] = ShortIndices[i];
+            }
         }
-        if (!Material.BumpTexturePath.empty())
+        else if (Indices->Size > 0)
         {
-            Textures.AddUnique(Material.BumpTexturePath);
+            memcpy(LOD->Indices.GetData(), Data + Indices->Offset, Indices->Size);
         }
-        if (!Material.AlphaTexturePath.empty())
+
+        LOD->Clusters.SetNum(static_cast<int32>(Clusters->Size / sizeof(FMeshCluster)));
+        if (Clusters->Size > 0)
+            memcpy(LOD->Clusters.GetData(), Data + Clusters->Offset, Clusters->Size);
+        for (const FMeshCluster& Cluster : LOD->Clusters)
         {
-            Textures.AddUnique(Material.AlphaTexturePath);
+            if (static_cast<uint64>(Cluster.IndexStart) + Cluster.IndexCount > static_cast<uint64>(LOD->Indices.Num()))
+            {
+                bValid = false;
+                break;
+            }
         }
     }
 
-    // Material Subset
-    uint32 SubsetCount = 0;
-    File.read(reinterpret_cast<char*>(&SubsetCount), sizeof(SubsetCount));
-    OutStaticMesh.MaterialSubsets.SetNum(SubsetCount);
-    for (FMaterialSubset& Subset : OutStaticMesh.MaterialSubsets)
+    if (!bValid)
     {
-        Serializer::ReadFString(File, Subset.MaterialName);
-        File.read(reinterpret_cast<char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
-        File.read(reinterpret_cast<char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
-        File.read(reinterpret_cast<char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
+        for (OBJ::FStaticMeshRenderData* LOD : OutLODs)
+        {
+            delete LOD;
+        }
+        OutLODs.Empty();
+        return false;
     }
 
-    // Bounding Box
-    File.read(reinterpret_cast<char*>(&OutStaticMesh.BoundingBoxMin), sizeof(FVector));
-    File.read(reinterpret_cast<char*>(&OutStaticMesh.BoundingBoxMax), sizeof(FVector));
-        
-    File.close();
+    return true;
+}
 
+void FManagerOBJ::LoadTextures(const TArray<FWString>& Textures)
+{
     // Texture Load
     if (Textures.Num() > 0)
     {
@@ -312,8 +1112,6 @@ bool FManagerOBJ::LoadStaticMeshFromBinary(const FWString& FilePath, OBJ::FStati
             }
         }
     }
-        
-    return true;
 }
 
 UMaterial* FManagerOBJ::CreateMaterial(FObjMaterialInfo materialInfo)
@@ -346,11 +1144,368 @@ UStaticMesh* FManagerOBJ::CreateStaticMesh(FString filePath)
 
     staticMesh = FObjectFactory::ConstructObject<UStaticMesh>();
     staticMesh->SetData(staticMeshRenderData);
+    if (const TArray<OBJ::FStaticMeshRenderData*>* LODs = ObjStaticMeshLODMap.Find(filePath))
+    {
+        staticMesh->SetLODData(*LODs);
+    }
 
     staticMeshMap.Add(staticMeshRenderData->ObjectName, staticMesh);
+    return staticMesh;
+}
+
+void FManagerOBJ::CreateStaticMeshes(const TArray<FString>& FilePaths, const std::function<void(int32, int32)>& OnProgress)
+{
+    LoadObjStaticMeshAssets(FilePaths, OnProgress);
+    for (const FString& FilePath : FilePaths)
+    {
+        CreateStaticMesh(FilePath);
+    }
 }
 
 UStaticMesh* FManagerOBJ::GetStaticMesh(FWString name)
 {
     return staticMeshMap[name];
 }
+
+namespace
+{
+    // 단순화 중의 삼각형. 코너마다 위치/법선/UV 인덱스를 따로 가짐 (OBJ와 같은 구성)
+    struct FQEMFace
+    {
+        uint32 V[3];
+        uint32 N[3];
+        uint32 T[3];
+        bool bRemoved = false;
+    };
+
+    struct FQEMVertex
+    {
+        Quadric Q;
+        TArray<uint32> Faces;   // 이 정점을 쓰는 삼각형 (제거된 것은 축소 때 정리)
+        uint32 Stamp = 0;       // 축소될 때마다 증가. 큐 원소의 Stamp와 다르면 낡은 후보
+        bool bRemoved = false;
+    };
+
+    // 큐에서 꺼낼 때 두 정점의 Stamp를 비교해 낡은 후보는 버림 (지연 삭제)
+    struct FQEMCollapse
+    {
+        float Cost;
+        uint32 Keep;
+        uint32 Remove;
+        uint32 KeepStamp;
+        uint32 RemoveStamp;
+        FVector Position;
+
+        bool operator>(const FQEMCollapse& Other) const { return Cost > Other.Cost; }
+    };
+
+    // 경계/UV 이음매 엣지를 붙잡아 두는 수직 평면의 가중치
+    constexpr double BoundaryWeight = 1000.0;
+
+    uint64 MakeEdgeKey(uint32 A, uint32 B)
+    {
+        return A < B ? (static_cast<uint64>(A) << 32) | B : (static_cast<uint64>(B) << 32) | A;
+    }
+
+    FVector ComputeFaceNormal(const FVector& P0, const FVector& P1, const FVector& P2)
+    {
+        return (P1 - P0).Cross(P2 - P0);
+    }
+
+    FQEMCollapse ComputeCollapse(const TArray<FVector>& Positions, const TArray<FQEMVertex>& Vertices, uint32 Keep, uint32 Remove)
+    {
+        Quadric Q = Vertices[Keep].Q;
+        Q.Add(Vertices[Remove].Q);
+
+        FQEMCollapse Collapse;
+        Collapse.Keep = Keep;
+        Collapse.Remove = Remove;
+        Collapse.KeepStamp = Vertices[Keep].Stamp;
+        Collapse.RemoveStamp = Vertices[Remove].Stamp;
+
+        // 4x4 이차식의 최소점. 특이 행렬(평면, 직선 위)이면 두 끝점과 중점 중 최소
+        if (!Q.Solve(Collapse.Position))
+        {
+            const FVector Candidates[3] = {Positions[Keep], Positions[Remove], (Positions[Keep] + Positions[Remove]) * 0.5f};
+            double BestCost = DBL_MAX;
+            for (const FVector& Candidate : Candidates)
+            {
+                const double Cost = Q.Evaluate(Candidate);
+                if (Cost < BestCost)
+                {
+                    BestCost = Cost;
+                    Collapse.Position = Candidate;
+                }
+            }
+        }
+        Collapse.Cost = static_cast<float>(FMath::Max(Q.Evaluate(Collapse.Position), 0.0));
+        return Collapse;
+    }
+
+    // Vertex를 NewPosition으로 옮겼을 때 Other와 공유하지 않는 삼각형이 뒤집히거나 찌그러지면 true
+    bool FlipsFaces(const TArray<FVector>& Positions, const TArray<FQEMFace>& Faces, const FQEMVertex& Vertex, uint32 VertexIndex, uint32 Other, const FVector& NewPosition)
+    {
+        for (uint32 FaceIndex : Vertex.Faces)
+        {
+            const FQEMFace& Face = Faces[FaceIndex];
+            if (Face.bRemoved || Face.V[0] == Other || Face.V[1] == Other || Face.V[2] == Other)
+                continue;
+
+            FVector Moved[3];
+            for (int32 i = 0; i < 3; ++i)
+                Moved[i] = Face.V[i] == VertexIndex ? NewPosition : Positions[Face.V[i]];
+
+            const FVector OldNormal = ComputeFaceNormal(Positions[Face.V[0]], Positions[Face.V[1]], Positions[Face.V[2]]);
+            const FVector NewNormal = ComputeFaceNormal(Moved[0], Moved[1], Moved[2]);
+            if (OldNormal.Dot(NewNormal) <= 0.0f)
+                return true;
+        }
+        return false;
+    }
+
+    // 공유 삼각형에서 (Keep 쪽 속성, Remove 쪽 속성) 쌍을 모아 엣지 위 보간값을 새 속성으로 추가하고 두 정점 코너를 그 값으로 바꿈
+    template <typename AttributeType, typename LerpFunc>
+    void MergeCornerAttribute(TArray<AttributeType>& Attributes, TArray<FQEMFace>& Faces, const FQEMVertex& KeepVertex, const FQEMVertex& RemoveVertex,
+                              uint32 Keep, uint32 Remove, uint32 (FQEMFace::*Corners)[3], float T, LerpFunc Lerp)
+    {
+        struct FRemap { uint32 KeepAttribute, RemoveAttribute, NewAttribute; };
+        FRemap Remaps[8];
+        int32 NumRemaps = 0;
+
+        for (uint32 FaceIndex : KeepVertex.Faces)
+        {
+            const FQEMFace& Face = Faces[FaceIndex];
+            if (Face.bRemoved)
+                continue;
+            int32 KeepCorner = -1, RemoveCorner = -1;
+            for (int32 i = 0; i < 3; ++i)
+            {
+                if (Face.V[i] == Keep) KeepCorner = i;
+                else if (Face.V[i] == Remove) RemoveCorner = i;
+            }
+            if (RemoveCorner < 0)
+                continue;
+
+            const uint32 KeepAttribute = (Face.*Corners)[KeepCorner];
+            const uint32 RemoveAttribute = (Face.*Corners)[RemoveCorner];
+            if (KeepAttribute >= static_cast<uint32>(Attributes.Num()) || RemoveAttribute >= static_cast<uint32>(Attributes.Num()))
+                continue;
+
+            bool bFound = false;
+            for (int32 i = 0; i < NumRemaps; ++i)
+                bFound |= Remaps[i].KeepAttribute == KeepAttribute && Remaps[i].RemoveAttribute == RemoveAttribute;
+            if (bFound || NumRemaps == 8)
+                continue;
+
+            // Add 중에 배열이 재할당될 수 있으므로 값으로 복사
+            const AttributeType NewValue = Lerp(AttributeType(Attributes[KeepAttribute]), AttributeType(Attributes[RemoveAttribute]), T);
+            Remaps[NumRemaps++] = {KeepAttribute, RemoveAttribute, static_cast<uint32>(Attributes.Add(NewValue))};
+        }
+
+        auto ApplyRemaps = [&](const FQEMVertex& Vertex, uint32 VertexIndex, bool bKeepSide)
+        {
+            for (uint32 FaceIndex : Vertex.Faces)
+            {
+                FQEMFace& Face = Faces[FaceIndex];
+                if (Face.bRemoved)
+                    continue;
+                for (int32 Corner = 0; Corner < 3; ++Corner)
+                {
+                    if (Face.V[Corner] != VertexIndex)
+                        continue;
+                    uint32& Attribute = (Face.*Corners)[Corner];
+                    for (int32 i = 0; i < NumRemaps; ++i)
+                    {
+                        if (Attribute == (bKeepSide ? Remaps[i].KeepAttribute : Remaps[i].RemoveAttribute))
+                        {
+                            Attribute = Remaps[i].NewAttribute;
+                            break;
+                        }
+                    }
+                }
+            }
+        };
+        ApplyRemaps(KeepVertex, Keep, true);
+        ApplyRemaps(RemoveVertex, Remove, false);
+    }
+}
+
+void QEMSimplifier::Simplify(FObjInfo& obj, int targetVertexCount, float maxError)
+{
+    const int32 NumVertices = obj.Vertices.Num();
+    const int32 NumFaces = obj.VertexIndices.Num() / 3;
+    const TArray<FVector>& Positions = obj.Vertices;
+
+    TArray<FQEMVertex> Vertices;
+    Vertices.SetNum(NumVertices);
+    TArray<FQEMFace> Faces;
+    Faces.SetNum(NumFaces);
+
+    // 1. 삼각형 평면의 이차식을 세 정점에 누적하고 정점 -> 삼각형 인접 목록 구성
+    for (int32 FaceIndex = 0; FaceIndex < NumFaces; ++FaceIndex)
+    {
+        FQEMFace& Face = Faces[FaceIndex];
+        for (int32 i = 0; i < 3; ++i)
+        {
+            Face.V[i] = obj.VertexIndices[FaceIndex * 3 + i];
+            Face.N[i] = obj.NormalIndices[FaceIndex * 3 + i];
+            Face.T[i] = obj.TextureIndices[FaceIndex * 3 + i];
+            Vertices[Face.V[i]].Faces.Add(FaceIndex);
+        }
+
+        const FVector Normal = ComputeFaceNormal(Positions[Face.V[0]], Positions[Face.V[1]], Positions[Face.V[2]]).Normalize();
+        const Quadric Q = Quadric::FromPlane(Normal, -Normal.Dot(Positions[Face.V[0]]), 1.0);
+        for (int32 i = 0; i < 3; ++i)
+            Vertices[Face.V[i]].Q.Add(Q);
+    }
+
+    // 2. 엣지 목록. 삼각형 하나에만 속한 경계 엣지와 양쪽 UV가 다른 이음매 엣지는 수직 평면으로 붙잡음
+    struct FEdgeInfo
+    {
+        uint32 Face;
+        int32 Count;
+        uint32 T0, T1;  // 작은 인덱스 정점, 큰 인덱스 정점 쪽 UV
+        bool bSeam;
+    };
+    std::unordered_map<uint64, FEdgeInfo> Edges;
+    Edges.reserve(NumFaces * 2);
+    for (int32 FaceIndex = 0; FaceIndex < NumFaces; ++FaceIndex)
+    {
+        const FQEMFace& Face = Faces[FaceIndex];
+        for (int32 i = 0; i < 3; ++i)
+        {
+            const int32 j = (i + 1) % 3;
+            const bool bSwap = Face.V[i] > Face.V[j];
+            const uint32 T0 = bSwap ? Face.T[j] : Face.T[i];
+            const uint32 T1 = bSwap ? Face.T[i] : Face.T[j];
+            auto [It, bInserted] = Edges.try_emplace(MakeEdgeKey(Face.V[i], Face.V[j]), FEdgeInfo{static_cast<uint32>(FaceIndex), 0, T0, T1, false});
+            It->second.Count++;
+            if (!bInserted)
+                It->second.bSeam |= It->second.T0 != T0 || It->second.T1 != T1;
+        }
+    }
+
+    std::priority_queue<FQEMCollapse, std::vector<FQEMCollapse>, std::greater<FQEMCollapse>> CollapseQueue;
+    {
+        std::vector<FQEMCollapse> Initial;
+        Initial.reserve(Edges.size());
+        for (const auto& [Key, Edge] : Edges)
+        {
+            const uint32 A = static_cast<uint32>(Key >> 32);
+            const uint32 B = static_cast<uint32>(Key & 0xffffffff);
+            if (Edge.Count == 1 || Edge.bSeam)
+            {
+                const FQEMFace& Face = Faces[Edge.Face];
+                const FVector FaceNormal = ComputeFaceNormal(Positions[Face.V[0]], Positions[Face.V[1]], Positions[Face.V[2]]);
+                const FVector Normal = (Positions[B] - Positions[A]).Cross(FaceNormal).Normalize();
+                const Quadric Q = Quadric::FromPlane(Normal, -Normal.Dot(Positions[A]), BoundaryWeight);
+                Vertices[A].Q.Add(Q);
+                Vertices[B].Q.Add(Q);
+            }
+        }
+        for (const auto& Edge : Edges)
+        {
+            Initial.push_back(ComputeCollapse(Positions, Vertices, static_cast<uint32>(Edge.first >> 32), static_cast<uint32>(Edge.first & 0xffffffff)));
+        }
+        CollapseQueue = decltype(CollapseQueue)(std::greater<FQEMCollapse>(), std::move(Initial));
+    }
+
+    // 3. 가장 싼 엣지부터 축소. 바뀐 정점 주변 엣지만 다시 계산해 큐에 넣음
+    int32 LiveVertices = NumVertices;
+    TArray<uint32> Neighbors;
+    while (LiveVertices > targetVertexCount && !CollapseQueue.empty())
+    {
+        const FQEMCollapse Collapse = CollapseQueue.top();
+        if (Collapse.Cost > maxError)
+            break;
+        CollapseQueue.pop();
+
+        FQEMVertex& KeepVertex = Vertices[Collapse.Keep];
+        FQEMVertex& RemoveVertex = Vertices[Collapse.Remove];
+        if (KeepVertex.bRemoved || RemoveVertex.bRemoved || KeepVertex.Stamp != Collapse.KeepStamp || RemoveVertex.Stamp != Collapse.RemoveStamp)
+            continue;
+        // 뒤집히는 후보는 버림. 주변이 바뀌면 그때 다시 큐에 들어옴
+        if (FlipsFaces(Positions, Faces, KeepVertex, Collapse.Keep, Collapse.Remove, Collapse.Position) ||
+            FlipsFaces(Positions, Faces, RemoveVertex, Collapse.Remove, Collapse.Keep, Collapse.Position))
+            continue;
+
+        // 속성은 새 위치를 엣지에 투영한 비율로 보간
+        const FVector Edge = obj.Vertices[Collapse.Remove] - obj.Vertices[Collapse.Keep];
+        const float EdgeLengthSquared = Edge.Dot(Edge);
+        const float T = EdgeLengthSquared > 0.0f ? FMath::Clamp((Collapse.Position - obj.Vertices[Collapse.Keep]).Dot(Edge) / EdgeLengthSquared, 0.0f, 1.0f) : 0.0f;
+        MergeCornerAttribute(obj.UVs, Faces, KeepVertex, RemoveVertex, Collapse.Keep, Collapse.Remove, &FQEMFace::T, T,
+            [](const FVector2D& A, const FVector2D& B, float Alpha) { return A + (B - A) * Alpha; });
+        MergeCornerAttribute(obj.Normals, Faces, KeepVertex, RemoveVertex, Collapse.Keep, Collapse.Remove, &FQEMFace::N, T,
+            [](const FVector& A, const FVector& B, float Alpha) { return (A + (B - A) * Alpha).Normalize(); });
+
+        // Remove를 Keep으로 합침. 두 정점을 모두 쓰던 삼각형은 사라짐
+        for (uint32 FaceIndex : RemoveVertex.Faces)
+        {
+            FQEMFace& Face = Faces[FaceIndex];
+            if (Face.bRemoved)
+                continue;
+            if (Face.V[0] == Collapse.Keep || Face.V[1] == Collapse.Keep || Face.V[2] == Collapse.Keep)
+            {
+                Face.bRemoved = true;
+                continue;
+            }
+            for (int32 i = 0; i < 3; ++i)
+            {
+                if (Face.V[i] == Collapse.Remove)
+                    Face.V[i] = Collapse.Keep;
+            }
+            KeepVertex.Faces.Add(FaceIndex);
+        }
+        KeepVertex.Faces.RemoveAll([&Faces](uint32 FaceIndex) { return Faces[FaceIndex].bRemoved; });
+
+        obj.Vertices[Collapse.Keep] = Collapse.Position;
+        KeepVertex.Q.Add(RemoveVertex.Q);
+        KeepVertex.Stamp++;
+        RemoveVertex.bRemoved = true;
+        RemoveVertex.Faces.Empty();
+        --LiveVertices;
+
+        Neighbors.Empty();
+        for (uint32 FaceIndex : KeepVertex.Faces)
+        {
+            for (uint32 V : Faces[FaceIndex].V)
+            {
+                if (V != Collapse.Keep)
+                    Neighbors.Add(V);
+            }
+        }
+        std::sort(Neighbors.begin(), Neighbors.end());
+        Neighbors.SetNum(static_cast<int32>(std::unique(Neighbors.begin(), Neighbors.end()) - Neighbors.begin()));
+        for (uint32 Neighbor : Neighbors)
+        {
+            CollapseQueue.push(ComputeCollapse(Positions, Vertices, Collapse.Keep, Neighbor));
+        }
+    }
+
+    // 4. 남은 정점과 삼각형으로 압축
+    TArray<uint32> Remap;
+    Remap.SetNum(NumVertices);
+    TArray<FVector> NewVertices;
+    NewVertices.Reserve(LiveVertices);
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        if (!Vertices[i].bRemoved)
+            Remap[i] = NewVertices.Add(obj.Vertices[i]);
+    }
+    obj.Vertices = std::move(NewVertices);
+
+    obj.VertexIndices.Empty();
+    obj.NormalIndices.Empty();
+    obj.TextureIndices.Empty();
+    for (const FQEMFace& Face : Faces)
+    {
+        if (Face.bRemoved)
+            continue;
+        for (int32 i = 0; i < 3; ++i)
+        {
+            obj.VertexIndices.Add(Remap[Face.V[i]]);
+            obj.NormalIndices.Add(Face.N[i]);
+            obj.TextureIndices.Add(Face.T[i]);
+        }
+    }
+}
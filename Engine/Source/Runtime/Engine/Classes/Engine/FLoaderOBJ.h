@@ -1,5 +1,6 @@
 #pragma once
 #include <fstream>
+#include <functional>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -12,194 +13,20 @@
 
 class UStaticMesh;
 struct FManagerOBJ;
-struct FLoaderOBJ
-{
-    // Obj Parsing (*.obj to FObjInfo)
-    static bool ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo)
-    {
-        std::ifstream OBJ(ObjFilePath.ToWideString());
-        if (!OBJ)
-        {
-            return false;
-        }
-
-        OutObjInfo.PathName = ObjFilePath.ToWideString().substr(0, ObjFilePath.ToWideString().find_last_of(L"\\/") + 1);
-        OutObjInfo.ObjectName = ObjFilePath.ToWideString().substr(ObjFilePath.ToWideString().find_last_of(L"\\/") + 1);
-        // ObjectName은 wstring 타입이므로, 이를 string으로 변환 (간단한 ASCII 변환의 경우)
-        std::wstring wideName = OutObjInfo.ObjectName;
-        std::string fileName(wideName.begin(), wideName.end());
-
-        // 마지막 '.'을 찾아 확장자를 제거
-        size_t dotPos = fileName.find_last_of('.');
-        if (dotPos != std::string::npos) {
-            OutObjInfo.DisplayName = fileName.substr(0, dotPos);
-        } else {
-            OutObjInfo.DisplayName = fileName;
-        }
-        
-        std::string Line;
 
-        while (std::getline(OBJ, Line))
-        {
-            if (Line.empty() || Line[0] == '#')
-                continue;
-            
-            std::istringstream LineStream(Line);
-            std::string Token;
-            LineStream >> Token;
-
-            if (Token == "mtllib")
-            {
-                LineStream >> Line;
-                OutObjInfo.MatName = Line;
-                continue;
-            }
-
-            if (Token == "usemtl")
-            {
-                LineStream >> Line;
-                FString MatName(Line);
-
-                if (!OutObjInfo.MaterialSubsets.IsEmpty())
-                {
-                    FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
-                    LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
-                }
-                
-                FMaterialSubset MaterialSubset;
-                MaterialSubset.MaterialName = MatName;
-                MaterialSubset.IndexStart = OutObjInfo.VertexIndices.Num();
-                MaterialSubset.IndexCount = 0;
-                OutObjInfo.MaterialSubsets.Add(MaterialSubset);
-            }
-
-            if (Token == "g" || Token == "o")
-            {
-                LineStream >> Line;
-                OutObjInfo.GroupName.Add(Line);
-                OutObjInfo.NumOfGroup++;
-            }
-
-            if (Token == "v") // Vertex
-            {
-                float x, y, z;
-                LineStream >> x >> y >> z;
-                OutObjInfo.Vertices.Add(FVector(x,y,z));
-                continue;
-            }
-
-            if (Token == "vn") // Normal
-            {
-                float nx, ny, nz;
-                LineStream >> nx >> ny >> nz;
-                OutObjInfo.Normals.Add(FVector(nx,ny,nz));
-                continue;
-            }
-
-            if (Token == "vt") // Texture
-            {
-                float u, v;
-                LineStream >> u >> v;
-                OutObjInfo.UVs.Add(FVector2D(u, v));
-                continue;
-            }
+struct FVertexWeldStats
+{
+    int32 NumCorners = 0;  // 면 코너 수 (용접하지 않으면 정점 수)
+    int32 NumVertices = 0; // 용접 후 정점 수
 
-            if (Token == "f")
-            {
-                TArray<uint32> faceVertexIndices;  // 이번 페이스의 정점 인덱스
-                TArray<uint32> faceNormalIndices;  // 이번 페이스의 법선 인덱스
-                TArray<uint32> faceTextureIndices; // 이번 페이스의 텍스처 인덱스
-                
-                while (LineStream >> Token)
-                {
-                    std::istringstream tokenStream(Token);
-                    std::string part;
-                    TArray<std::string> facePieces;
-
-                    // '/'로 분리하여 v/vt/vn 파싱
-                    while (std::getline(tokenStream, part, '/'))
-                    {
-                        facePieces.Add(part);
-                    }
-
-                    // OBJ 인덱스는 1부터 시작하므로 -1로 변환
-                    uint32 vertexIndex = facePieces[0].empty() ? 0 : std::stoi(facePieces[0]) - 1;
-                    uint32 textureIndex = (facePieces.Num() > 1 && !facePieces[1].empty()) ? std::stoi(facePieces[1]) - 1 : UINT32_MAX;
-                    uint32 normalIndex = (facePieces.Num() > 2 && !facePieces[2].empty()) ? std::stoi(facePieces[2]) - 1 : UINT32_MAX;
-
-                    faceVertexIndices.Add(vertexIndex);
-                    faceTextureIndices.Add(textureIndex);
-                    faceNormalIndices.Add(normalIndex);
-                }
-
-                if (faceVertexIndices.Num() == 4) // 쿼드
-                {
-                    // 첫 번째 삼각형: 0-1-2
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-
-                    // 두 번째 삼각형: 0-2-3
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[3]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[3]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[3]);
-                }
-                else if (faceVertexIndices.Num() == 3) // 삼각형
-                {
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-                }
-                // // 삼각형화 (삼각형 팬 방식)
-                // for (int j = 1; j + 1 < faceVertexIndices.Num(); j++)
-                // {
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[j]);
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[j + 1]);
-                //
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[j]);
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[j + 1]);
-                //
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[j]);
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[j + 1]);
-                // }
-            }
-        }
+    float GetCompressionRatio() const { return NumVertices > 0 ? static_cast<float>(NumCorners) / NumVertices : 0.0f; }
+};
 
-        if (!OutObjInfo.MaterialSubsets.IsEmpty())
-        {
-            FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
-            LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
-        }
-        
-        return true;
-    }
+struct FLoaderOBJ
+{
+    // Obj Parsing (*.obj to FObjInfo)
+    // 파일을 메모리 매핑해 직접 훑음. 첫 번째 패스에서 v/vn/vt/f 개수를 세어 배열을 미리 잡고 두 번째 패스에서 채움
+    static bool ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo);
     
     // Material Parsing (*.obj to MaterialInfo)
     static bool ParseMaterial(FObjInfo& OutObjInfo, OBJ::FStaticMeshRenderData& OutFStaticMesh)
@@ -310,86 +137,8 @@ struct FLoaderOBJ
     }
     
     // Convert the Raw data to Cooked data (FStaticMeshRenderData)
-    static bool ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh)
-    {
-        OutStaticMesh.ObjectName = RawData.ObjectName;
-        OutStaticMesh.PathName = RawData.PathName;
-        OutStaticMesh.DisplayName = RawData.DisplayName;
-
-        // 고유 정점을 기반으로 FVertexSimple 배열 생성
-        TMap<std::string, uint32> vertexMap; // 중복 체크용
-
-        for (int32 i = 0; i < RawData.VertexIndices.Num(); i++)
-        {
-            uint32 vIdx = RawData.VertexIndices[i];
-            uint32 tIdx = RawData.TextureIndices[i];
-            uint32 nIdx = RawData.NormalIndices[i];
-
-            // 키 생성 (v/vt/vn 조합)
-            std::string key = std::to_string(vIdx) + "/" + 
-                             std::to_string(tIdx) + "/" + 
-                             std::to_string(nIdx);
-
-            uint32 index;
-            if (vertexMap.Find(key) == nullptr)
-            {
-                FVertexCompact vertex {};
-                vertex.x = RawData.Vertices[vIdx].x;
-                vertex.y = RawData.Vertices[vIdx].y;
-                vertex.z = RawData.Vertices[vIdx].z;
-
-                //vertex.r = 1.0f; vertex.g = 1.0f; vertex.b = 1.0f; vertex.a = 1.0f; // 기본 색상
-
-                if (tIdx != UINT32_MAX && tIdx < RawData.UVs.Num())
-                {
-                    float u = RawData.UVs[tIdx].x;
-                    float v = -RawData.UVs[tIdx].y;
-                    
-                    u = u * 0.5f + 0.5f;
-                    v = v * 0.5f + 0.5f;
-                    vertex.u = static_cast<uint16>(FMath::Clamp(u, 0.0f, 1.0f) * 65535.0f + 0.5f);
-                    vertex.v = static_cast<uint16>(FMath::Clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f);
-
-                    
-                }
-/*
-                if (nIdx != UINT32_MAX && nIdx < RawData.Normals.Num())
-                {
-                    vertex.nx = RawData.Normals[nIdx].x;
-                    vertex.ny = RawData.Normals[nIdx].y;
-                    vertex.nz = RawData.Normals[nIdx].z;
-                }
-*/
-                /*
-                for (int32 j = 0; j < OutStaticMesh.MaterialSubsets.Num(); j++)
-                {
-                    const FMaterialSubset& subset = OutStaticMesh.MaterialSubsets[j];
-                    if ( i >= subset.IndexStart && i < subset.IndexStart + subset.IndexCount)
-                    {
-                        vertex.MaterialIndex = subset.MaterialIndex;
-                        break;
-                    }
-                }
-                */
-                
-                index = OutStaticMesh.Vertices.Num();
-                OutStaticMesh.Vertices.Add(vertex);
-                vertexMap[key] = index;
-            }
-            else
-            {
-                index = vertexMap[key];
-            }
-
-            OutStaticMesh.Indices.Add(index);
-            
-        }
-
-        // Calculate StaticMesh BoundingBox
-        ComputeBoundingBox(OutStaticMesh.Vertices, OutStaticMesh.BoundingBoxMin, OutStaticMesh.BoundingBoxMax);
-        
-        return true;
-    }
+    // 면 코너마다 FVertexCompact를 만들고 값이 같은 정점은 하나로 용접. WeldEpsilon > 0이면 위치가 축마다 WeldEpsilon 이내이고 UV가 같은 정점까지 합침
+    static bool ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh, float WeldEpsilon = 0.0f, FVertexWeldStats* OutStats = nullptr);
 
     static bool CreateTextureFromFile(const FWString& Filename)
     {
@@ -433,321 +182,118 @@ struct FLoaderOBJ
 struct FManagerOBJ
 {
 public:
+    //LOD0을 반환. 단순화 LOD 체인도 함께 만들어 .bin에 캐시
     static OBJ::FStaticMeshRenderData* LoadObjStaticMeshAsset(const FString& PathFileName);
+    //여러 OBJ를 한 번에 불러옴. 파싱/캐시 읽기와 LOD 단순화는 FTaskPool에서 메시, 메시 x LOD 단위로 나눠 실행하고
+    //머티리얼/텍스처 생성만 호출 스레드에서 처리. OnProgress(완료, 전체)는 워커 스레드에서도 불리며 호출끼리는 직렬화됨
+    static void LoadObjStaticMeshAssets(const TArray<FString>& PathFileNames, const std::function<void(int32, int32)>& OnProgress = nullptr);
 
     static void CombineMaterialIndex(OBJ::FStaticMeshRenderData& OutFStaticMesh);
 
-    static bool SaveStaticMeshToBinary(const FWString& FilePath, const OBJ::FStaticMeshRenderData& StaticMesh);
+    //모든 LOD와 생성에 쓴 LODErrorThresholds를 MeshCache 형식(StaticMeshCache.h)으로 기록
+    static bool SaveStaticMeshToBinary(const FWString& FilePath, const TArray<OBJ::FStaticMeshRenderData*>& LODs);
 
-    static bool LoadStaticMeshFromBinary(const FWString& FilePath, OBJ::FStaticMeshRenderData& OutStaticMesh);
+    //매핑해서 읽음. 버전/체크섬이 맞지 않거나 원본 OBJ가 더 새롭거나 LODErrorThresholds, VertexWeldEpsilon이 바뀐 파일이면 false (다시 생성)
+    static bool LoadStaticMeshFromBinary(const FWString& FilePath, TArray<OBJ::FStaticMeshRenderData*>& OutLODs);
 
     static UMaterial* CreateMaterial(FObjMaterialInfo materialInfo);
     static TMap<FString, UMaterial*>& GetMaterials() { return materialMap; }
     static UMaterial* GetMaterial(FString name);
     static int GetMaterialNum() { return materialMap.Num(); }
     static UStaticMesh* CreateStaticMesh(FString filePath);
+    //LoadObjStaticMeshAssets로 함께 불러온 뒤 각각 CreateStaticMesh
+    static void CreateStaticMeshes(const TArray<FString>& FilePaths, const std::function<void(int32, int32)>& OnProgress = nullptr);
     static const TMap<FWString, UStaticMesh*>& GetStaticMeshes() { return staticMeshMap; }
     static UStaticMesh* GetStaticMesh(FWString name);
     static int GetStaticMeshNum() { return staticMeshMap.Num(); }
 
+    //LOD n(1부터)은 원본을 QEM 오차가 (메시 대각선 * LODErrorThresholds[n-1])^2에 닿을 때까지 단순화. 원소 수 + 1이 LOD 수
+    inline static TArray<float> LODErrorThresholds = {0.005f, 0.02f};
+    //임포트 시 모든 LOD에 FMeshOptimizer를 적용할 때 클러스터 단위 오버드로 정렬까지 할지
+    inline static bool bOptimizeOverdraw = true;
+    //ConvertToStaticMesh에 넘기는 용접 거리 (오브젝트 공간). 0이면 위치와 UV가 정확히 같은 정점만 합침
+    inline static float VertexWeldEpsilon = 0.0f;
+    //개발용. 켜면 새로 임포트한 메시마다 정점 레이아웃별 메모리와 양자화 오차를 로그로 남김
+    inline static bool bLogVertexQuantization = false;
+    //불러온 모든 LOD의 정점이 Pos16/Packed8 왕복 오차 한도(바운드 대각선 대비) 안인지 검사하고 결과를 로그로 남김
+    static bool ValidateVertexQuantization();
+
 private:
+    static OBJ::FStaticMeshRenderData* BuildSimplifiedLOD(const FObjInfo& BaseObjInfo, const OBJ::FStaticMeshRenderData& BaseLOD, float MaxError, int32 LODIndex);
+    //텍스처는 로드하지 않고 경로만 모음 (워커 스레드에서 호출)
+    static bool ReadStaticMeshBinary(const FWString& FilePath, TArray<OBJ::FStaticMeshRenderData*>& OutLODs, TArray<FWString>& OutTextures);
+    static void LoadTextures(const TArray<FWString>& Textures);
+
+    inline static TMap<FString, TArray<OBJ::FStaticMeshRenderData*>> ObjStaticMeshLODMap;
     inline static TMap<FString, OBJ::FStaticMeshRenderData*> ObjStaticMeshMap;
     inline static TMap<FWString, UStaticMesh*> staticMeshMap;
     inline static TMap<FString, UMaterial*> materialMap;
 };
 // Quadric 에러 행렬 (대칭행렬의 10개 요소만 저장)
 struct Quadric {
-    float data[10] = {0};
+    double data[10] = {0};
+
+    // 평면 nx + d = 0까지 거리 제곱 * Weight
+    static Quadric FromPlane(const FVector& n, float d, double Weight) {
+        Quadric q;
+        q.data[0] = Weight * n.x * n.x;
+        q.data[1] = Weight * n.x * n.y;
+        q.data[2] = Weight * n.x * n.z;
+        q.data[3] = Weight * n.x * d;
+        q.data[4] = Weight * n.y * n.y;
+        q.data[5] = Weight * n.y * n.z;
+        q.data[6] = Weight * n.y * d;
+        q.data[7] = Weight * n.z * n.z;
+        q.data[8] = Weight * n.z * d;
+        q.data[9] = Weight * d * d;
+        return q;
+    }
 
     void Add(const Quadric& q) {
         for (int i = 0; i < 10; i++) {
             data[i] += q.data[i];
         }
     }
-};
 
-// 엣지 축소 후보 구조체 (operator< 정의로 우선순위 큐에서 낮은 cost 우선)
-struct IndexSet
-{
-    IndexSet(uint32 v, uint32 n, uint32 t) :verIndex(v), norIndex(n), texIndex(t) {}
-    uint32 verIndex, norIndex, texIndex;
-    bool operator<(const IndexSet& other) const {
-            return verIndex < other.verIndex;
+    // p^T * Q * p (p = (x, y, z, 1))
+    double Evaluate(const FVector& p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return data[0] * x * x + 2.0 * data[1] * x * y + 2.0 * data[2] * x * z + 2.0 * data[3] * x +
+               data[4] * y * y + 2.0 * data[5] * y * z + 2.0 * data[6] * y +
+               data[7] * z * z + 2.0 * data[8] * z +
+               data[9];
     }
-};
-struct EdgeCollapse {
-    IndexSet i1, i2;
-    float cost;
-    FVector newPos;
 
-    bool operator<(const EdgeCollapse& other) const {
-        return cost > other.cost; // 최소 힙: 낮은 cost 우선
+    // 오차를 최소로 하는 위치 (상위 3x3 블록의 선형계). 특이 행렬이면 false
+    bool Solve(FVector& OutPosition) const {
+        const double a = data[0], b = data[1], c = data[2];
+        const double e = data[4], f = data[5], h = data[7];
+        const double c00 = e * h - f * f;
+        const double c01 = c * f - b * h;
+        const double c02 = b * f - c * e;
+        const double det = a * c00 + b * c01 + c * c02;
+        const double scale = a * a + e * e + h * h;
+        if (std::abs(det) <= 1e-10 * scale * std::sqrt(scale))
+            return false;
+
+        const double invDet = 1.0 / det;
+        const double c11 = a * h - c * c;
+        const double c12 = b * c - a * f;
+        const double c22 = a * e - b * b;
+        const double bx = -data[3], by = -data[6], bz = -data[8];
+        OutPosition.x = static_cast<float>((c00 * bx + c01 * by + c02 * bz) * invDet);
+        OutPosition.y = static_cast<float>((c01 * bx + c11 * by + c12 * bz) * invDet);
+        OutPosition.z = static_cast<float>((c02 * bx + c12 * by + c22 * bz) * invDet);
+        return true;
     }
 };
 
-
+// 엣지 축소 기반 QEM 단순화 (Garland-Heckbert).
+// 정점 -> 삼각형 인접 목록과 지연 삭제 우선순위 큐로 축소된 정점 주변만 다시 계산
 class QEMSimplifier {
 public:
-    // targetVertexCount까지 단순화 (예제에서는 면 정보를 이용하여 인접 정점만 후보로 처리)
-    static void Simplify(FObjInfo& obj, int targetVertexCount) {
-        int numVertices = obj.Vertices.Num();
-        int numFaces = obj.VertexIndices.Num() / 3;
-
-        // 1. 각 정점에 대한 QEM 행렬 계산 (각 정점에 인접한 삼각형 면들로부터)
-        std::vector<Quadric> quadrics(numVertices);
-        for (int i = 0; i < numFaces; i++) {
-            int v0 = obj.VertexIndices[i * 3 + 0];
-            int v1 = obj.VertexIndices[i * 3 + 1];
-            int v2 = obj.VertexIndices[i * 3 + 2];
-            
-            FVector p0 = obj.Vertices[v0];
-            FVector p1 = obj.Vertices[v1];
-            FVector p2 = obj.Vertices[v2];
-            
-            FVector normal = (p1 - p0).Cross(p2 - p0).Normalize();
-            float d = -normal.Dot(p0);
-            
-            Quadric q;
-            q.data[0] = normal.x * normal.x;
-            q.data[1] = normal.x * normal.y;
-            q.data[2] = normal.x * normal.z;
-            q.data[3] = normal.x * d;
-            q.data[4] = normal.y * normal.y;
-            q.data[5] = normal.y * normal.z;
-            q.data[6] = normal.y * d;
-            q.data[7] = normal.z * normal.z;
-            q.data[8] = normal.z * d;
-            q.data[9] = d * d;
-            
-            quadrics[v0].Add(q);
-            quadrics[v1].Add(q);
-            quadrics[v2].Add(q);
-        }
-
-        // 2. 면 정보로부터 실제로 연결된 엣지 후보 목록을 생성합니다.
-        // 각 면의 엣지 (v0-v1, v1-v2, v2-v0)만 고려합니다.
-        std::set<std::pair<IndexSet, IndexSet>> edgeSet;
-        for (int i = 0; i < numFaces; i++) {
-            uint32 v[3] = { obj.VertexIndices[i * 3 + 0],
-            obj.VertexIndices[i * 3 + 1],
-            obj.VertexIndices[i * 3 + 2] };
-            uint32 n[3]= { obj.NormalIndices[i * 3 + 0],
-            obj.NormalIndices[i * 3 + 1],
-            obj.NormalIndices[i * 3 + 2] };
-            uint32 t[3] = {obj.TextureIndices[i * 3 + 0],
-            obj.TextureIndices[i * 3 + 1],
-            obj.TextureIndices[i * 3 + 2] };
-            // 정렬하여 (min, max) 쌍으로 저장
-            for (int j = 0; j < 3; j++) {
-                uint32 a = v[j], b = v[(j+1)%3];
-                uint32 c = n[j], d = n[(j+1)%3];
-                uint32 e = t[j], f = t[(j+1)%3];
-                if (a > b)
-                {
-                    std::swap(a, b);
-                    std::swap(c, d);
-                    std::swap(e, f);
-                }
-                IndexSet minEdge(a,c,e), maxEdge(b,e,f);
-                edgeSet.insert({minEdge, maxEdge});
-            }
-        }
-        
-        // 3. 후보 엣지들을 우선순위 큐에 추가 (병합 가능한지 검사)
-        std::priority_queue<EdgeCollapse> collapseQueue;
-        for (const auto& edge : edgeSet) {
-            IndexSet minEdge = edge.first, maxEdge = edge.second;
-
-            FVector midpoint = (obj.Vertices[minEdge.verIndex] + obj.Vertices[maxEdge.verIndex]) * 0.5f;
-            float cost = ComputeCollapseCost(quadrics[minEdge.verIndex], quadrics[maxEdge.verIndex], midpoint);
-            collapseQueue.push({minEdge, maxEdge, cost, midpoint});
-        }
-
-        // 4. 목표 정점 개수까지 단순화 수행
-        while (obj.Vertices.Num() > (size_t)targetVertexCount && !collapseQueue.empty()) {
-            EdgeCollapse bestCollapse = collapseQueue.top();
-            collapseQueue.pop();
-            uint32 v1 = bestCollapse.i1.verIndex,v2 = bestCollapse.i2.verIndex;
-            uint32 n1 = bestCollapse.i1.norIndex, n2 = bestCollapse.i2.norIndex;
-            uint32 t1 = bestCollapse.i1.texIndex, t2 = bestCollapse.i2.texIndex;
-            
-            // 병합 전 원래 v1과 v2의 위치와 UV 기록
-            FVector oldPos_v1 = obj.Vertices[v1];
-            FVector oldPos_v2 = obj.Vertices[v2];
-            FVector normal_v1 = obj.Normals[n1];
-            FVector normal_v2 = obj.Normals[n2];
-            FVector2D uv_v1 = obj.UVs[t1];
-            FVector2D uv_v2 = obj.UVs[t2];
-            
-            // obj.Vertices[v1] = (oldPos_v1 + oldPos_v2) * .5f;
-            // obj.Normals[n1] = (normal_v1 + normal_v2) * 0.5f;
-            // obj.Normals[n1] = obj.Normals[n1].Normalize();
-            //
-            //
-            // float totalDist = (oldPos_v2 - oldPos_v1).Magnitude();
-            // float movedDist = (bestCollapse.newPos - oldPos_v1).Magnitude();
-            // float t = (totalDist > 1e-6f) ? (movedDist / totalDist) : 0.5f;
-            // obj.UVs[t1] =  FVector2D::Lerp(uv_v1, uv_v2, t);
-            // obj.UVs[t1] =  uv_v1;
-
-            
-            // 정점 삭제: v2 정점을 제거 (삭제 후 인덱스 재매핑 필요)
-            obj.Vertices.RemoveAt(v2);
-            // obj.Normals.RemoveAt(n2);
-            // obj.UVs.RemoveAt(t2);
-            
-            // 인덱스 재매핑: 삭제된 정점 v2에 해당하는 인덱스는 v1로, v2보다 큰 인덱스는 1씩 감소
-            for (auto& index : obj.VertexIndices) {
-                if (index == v2) index = v1;
-                else if (index > v2) index--;
-            }
-            // for (auto& index : obj.NormalIndices) {
-            //     if (index == n2) index = n1;
-            //     else if (index > n2) index--;
-            // }
-            // for (auto& index : obj.TextureIndices) {
-            //     if (index == t2) index = t1;
-            //     else if (index > t2) index--;
-            // }
-
-
-            edgeSet.clear();
-            quadrics.clear();
-            collapseQueue = std::priority_queue<EdgeCollapse>();
-            std::set<std::pair<IndexSet, IndexSet>> edgeSet;
-            for (int i = 0; i < numFaces; i++) {
-                uint32 v[3] = { obj.VertexIndices[i * 3 + 0],
-                obj.VertexIndices[i * 3 + 1],
-                obj.VertexIndices[i * 3 + 2] };
-                uint32 n[3]= { obj.NormalIndices[i * 3 + 0],
-                obj.NormalIndices[i * 3 + 1],
-                obj.NormalIndices[i * 3 + 2] };
-                uint32 t[3] = {obj.TextureIndices[i * 3 + 0],
-                obj.TextureIndices[i * 3 + 1],
-                obj.TextureIndices[i * 3 + 2] };
-                if ((v[0] == v[1] || v[1] == v[2] || v[2] == v[0]))
-                {
-                    obj.VertexIndices.RemoveAt((i*3+2));
-                    obj.VertexIndices.RemoveAt(i*3+1);
-                    obj.VertexIndices.RemoveAt(i*3);
-                    obj.NormalIndices.RemoveAt((i*3+2));
-                    obj.NormalIndices.RemoveAt(i*3+1);
-                    obj.NormalIndices.RemoveAt(i*3);
-                    obj.TextureIndices.RemoveAt((i*3+2));
-                    obj.TextureIndices.RemoveAt(i*3+1);
-                    obj.TextureIndices.RemoveAt(i*3);
-     
-                    numFaces--;
-                    i--;
-                    continue;
-                }
-                // 정렬하여 (min, max) 쌍으로 저장
-                for (int j = 0; j < 3; j++) {
-                    uint32 a = v[j], b = v[(j+1)%3];
-                    uint32 c = n[j], d = n[(j+1)%3];
-                    uint32 e = t[j], f = t[(j+1)%3];
-                    if (a > b)
-                    {
-                        std::swap(a, b);
-                        std::swap(c, d);
-                        std::swap(e, f);
-                    }
-                    edgeSet.insert({{a,c,e}, {b,d,f}});
-                }
-            }
-            
-            numVertices = obj.Vertices.Num();
-            numFaces = obj.VertexIndices.Num() / 3;
-            quadrics.resize(numVertices);
-            for (int i = 0; i < numFaces; i++) {
-                int v0 = obj.VertexIndices[i * 3 + 0];
-                int v1 = obj.VertexIndices[i * 3 + 1];
-                int v2 = obj.VertexIndices[i * 3 + 2];
-                
-                FVector p0 = obj.Vertices[v0];
-                FVector p1 = obj.Vertices[v1];
-                FVector p2 = obj.Vertices[v2];
-                
-                FVector normal = (p1 - p0).Cross(p2 - p0).Normalize();
-                float d = -normal.Dot(p0);
-                
-                Quadric q;
-                q.data[0] = normal.x * normal.x;
-                q.data[1] = normal.x * normal.y;
-                q.data[2] = normal.x * normal.z;
-                q.data[3] = normal.x * d;
-                q.data[4] = normal.y * normal.y;
-                q.data[5] = normal.y * normal.z;
-                q.data[6] = normal.y * d;
-                q.data[7] = normal.z * normal.z;
-                q.data[8] = normal.z * d;
-                q.data[9] = d * d;
-                
-                quadrics[v0].Add(q);
-                quadrics[v1].Add(q);
-                quadrics[v2].Add(q);
-            }
-            for (const auto& edge : edgeSet) {
-                IndexSet minEdge = edge.first, maxEdge = edge.second;
-                FVector midpoint = (obj.Vertices[minEdge.verIndex] + obj.Vertices[maxEdge.verIndex]) * 0.5f;
-                float cost = ComputeCollapseCost(quadrics[minEdge.verIndex], quadrics[maxEdge.verIndex], midpoint);
-                collapseQueue.push({minEdge, maxEdge, cost, midpoint});
-            }
-        }
-    }
-
-private:
-    // 간단한 엣지 축소 비용 계산 함수
-    // 실제 구현에서는 newPos^T * q * newPos 를 계산하는 방식이 더 정확하지만, 여기서는 q.data[9]를 사용합니다.
-    static float ComputeCollapseCost(const Quadric& q1, const Quadric& q2, FVector& newPos) {
-        Quadric q = q1;
-        q.Add(q2);
-    
-        // 4D 벡터 확장: newPos = (x, y, z, 1)
-        float x = newPos.x;
-        float y = newPos.y;
-        float z = newPos.z;
-    
-        // newPos^T * Q * newPos 계산
-        float cost =
-            q.data[0] * x * x + 2.0f * q.data[1] * x * y + 2.0f * q.data[2] * x * z + 2.0f * q.data[3] * x +  
-            q.data[4] * y * y + 2.0f * q.data[5] * y * z + 2.0f * q.data[6] * y +
-            q.data[7] * z * z + 2.0f * q.data[8] * z +
-            q.data[9];  // d*d 항
-    
-        return cost;
-    }
-    static float ComputeCollapseCost(const Quadric& q1, const Quadric& q2, FVector& newPos, 
-                                   const FVector2D& uv1, const FVector2D& uv2, 
-                                   const FVector& normal1, const FVector& normal2) {
-        Quadric q = q1;
-        q.Add(q2);
-    
-        float x = newPos.x;
-        float y = newPos.y;
-        float z = newPos.z;
-    
-        // 기본 기하학적 비용 계산: newPos^T * Q * newPos
-        float geomCost =
-            q.data[0] * x * x + 2.0f * q.data[1] * x * y + 2.0f * q.data[2] * x * z + 2.0f * q.data[3] * x +
-            q.data[4] * y * y + 2.0f * q.data[5] * y * z + 2.0f * q.data[6] * y +
-            q.data[7] * z * z + 2.0f * q.data[8] * z +
-            q.data[9];
-    
-        // UV 차이에 따른 비용 (단순 예제: 두 UV 사이의 유클리드 거리의 제곱)
-        float du = uv1.x - uv2.x;
-        float dv = uv1.y - uv2.y;
-        float uvCost = du * du + dv * dv;
-    
-        // 노말 차이에 따른 비용 (두 노말의 코사인 유사도 기반, 1 - DotProduct)
-        float normalDiff = 1.0f - normal1.Dot(normal2);
-        float normalCost = normalDiff * normalDiff;
-    
-        // 가중치 인자: alpha와 beta는 조절 가능한 파라미터
-        const float alpha = .1f;  // UV 비용에 대한 가중치
-        const float beta = .1f;   // 노말 비용에 대한 가중치
-    
-        float totalCost = geomCost + alpha * uvCost + beta * normalCost;
-        return totalCost;
-    }
+    // 살아 있는 정점이 targetVertexCount가 될 때까지 단순화.
+    // 가장 싼 축소 비용(평면까지 거리 제곱의 합)이 maxError를 넘으면 목표 전이라도 멈춤.
+    // 경계와 UV 이음매는 가중 평면으로 보존하고 UV/법선은 엣지 위 위치로 보간
+    static void Simplify(FObjInfo& obj, int targetVertexCount, float maxError = FLT_MAX);
 };
\ No newline at end of file
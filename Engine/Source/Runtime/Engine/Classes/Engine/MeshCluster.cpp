@@ -0,0 +1,216 @@
+#include "MeshCluster.h"
+#include "Math/Frustum.h"
+
+namespace
+{
+    // 평균 법선과 이보다 덜 정렬된 삼각형이 있으면 콘이 너무 넓어 백페이스 컬링에 쓰지 않음
+    constexpr float MinConeDot = 0.1f;
+
+    float Determinant3x3(const FMatrix& Matrix)
+    {
+        const float (&M)[4][4] = Matrix.M;
+        return M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1])
+             - M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0])
+             + M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0]);
+    }
+}
+
+void FMeshClusterBuilder::Build(OBJ::FStaticMeshRenderData& Mesh)
+{
+    Mesh.Clusters.Empty();
+    const int32 NumVertices = Mesh.Vertices.Num();
+
+    // 서브셋이 없으면 인덱스 전체를 서브셋 0으로 봄
+    struct FSubsetRange
+    {
+        uint32 IndexStart;
+        uint32 IndexCount;
+    };
+    TArray<FSubsetRange> SubsetRanges;
+    if (Mesh.MaterialSubsets.Num() == 0)
+    {
+        SubsetRanges.Add({0, static_cast<uint32>(Mesh.Indices.Num())});
+    }
+    for (const FMaterialSubset& Subset : Mesh.MaterialSubsets)
+    {
+        SubsetRanges.Add({Subset.IndexStart, Subset.IndexCount});
+    }
+
+    // 정점마다 마지막으로 들어간 클러스터 번호. 새 정점 수를 세는 데 씀
+    TArray<int32> VertexStamp;
+    VertexStamp.Init(-1, NumVertices);
+
+    for (int32 SubsetIndex = 0; SubsetIndex < SubsetRanges.Num(); ++SubsetIndex)
+    {
+        const uint32 Start = SubsetRanges[SubsetIndex].IndexStart;
+        const uint32 End = Start + SubsetRanges[SubsetIndex].IndexCount / 3 * 3;
+        if (End > static_cast<uint32>(Mesh.Indices.Num()))
+            continue;
+
+        FMeshCluster Cluster = {};
+        Cluster.IndexStart = Start;
+        Cluster.SubsetIndex = SubsetIndex;
+        for (uint32 i = Start; i < End; i += 3)
+        {
+            const UINT* Triangle = &Mesh.Indices[i];
+            if (Triangle[0] >= static_cast<UINT>(NumVertices) || Triangle[1] >= static_cast<UINT>(NumVertices) || Triangle[2] >= static_cast<UINT>(NumVertices))
+            {
+                Mesh.Clusters.Empty();
+                return;
+            }
+
+            const int32 ClusterId = Mesh.Clusters.Num();
+            int32 NumNewVertices = 0;
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const bool bDuplicate = (Corner > 0 && Triangle[Corner] == Triangle[0]) || (Corner > 1 && Triangle[Corner] == Triangle[1]);
+                NumNewVertices += (VertexStamp[Triangle[Corner]] != ClusterId && !bDuplicate) ? 1 : 0;
+            }
+
+            if (Cluster.IndexCount > 0 &&
+                (Cluster.NumVertices + NumNewVertices > MaxVertices || Cluster.IndexCount / 3 + 1 > MaxTriangles))
+            {
+                ComputeClusterBounds(Mesh, Cluster);
+                Mesh.Clusters.Add(Cluster);
+                Cluster = {};
+                Cluster.IndexStart = i;
+                Cluster.SubsetIndex = SubsetIndex;
+                NumNewVertices = 3 - (Triangle[1] == Triangle[0]) - (Triangle[2] == Triangle[0] || Triangle[2] == Triangle[1]);
+            }
+
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                VertexStamp[Triangle[Corner]] = Mesh.Clusters.Num();
+            }
+            Cluster.NumVertices += NumNewVertices;
+            Cluster.IndexCount += 3;
+        }
+
+        if (Cluster.IndexCount > 0)
+        {
+            ComputeClusterBounds(Mesh, Cluster);
+            Mesh.Clusters.Add(Cluster);
+        }
+    }
+}
+
+void FMeshClusterBuilder::ComputeClusterBounds(const OBJ::FStaticMeshRenderData& Mesh, FMeshCluster& Cluster)
+{
+    const UINT* Indices = &Mesh.Indices[Cluster.IndexStart];
+
+    FVector Min = Mesh.Vertices[Indices[0]].ToFVector();
+    FVector Max = Min;
+    for (uint32 i = 1; i < Cluster.IndexCount; ++i)
+    {
+        const FVector Position = Mesh.Vertices[Indices[i]].ToFVector();
+        Min = FVector(FMath::Min(Min.x, Position.x), FMath::Min(Min.y, Position.y), FMath::Min(Min.z, Position.z));
+        Max = FVector(FMath::Max(Max.x, Position.x), FMath::Max(Max.y, Position.y), FMath::Max(Max.z, Position.z));
+    }
+    Cluster.BoundsMin = Min;
+    Cluster.BoundsMax = Max;
+
+    Cluster.Center = (Min + Max) * 0.5f;
+    float RadiusSquared = 0.0f;
+    for (uint32 i = 0; i < Cluster.IndexCount; ++i)
+    {
+        const FVector Offset = Mesh.Vertices[Indices[i]].ToFVector() - Cluster.Center;
+        RadiusSquared = FMath::Max(RadiusSquared, Offset.Dot(Offset));
+    }
+    Cluster.Radius = sqrtf(RadiusSquared);
+
+    // 법선 콘: 단위 삼각형 법선의 평균을 축으로, 축과 가장 벌어진 법선까지를 반각으로
+    TArray<FVector> Normals;
+    Normals.Reserve(Cluster.IndexCount / 3);
+    FVector NormalSum(0.0f, 0.0f, 0.0f);
+    for (uint32 i = 0; i < Cluster.IndexCount; i += 3)
+    {
+        const FVector P0 = Mesh.Vertices[Indices[i]].ToFVector();
+        const FVector Normal = (Mesh.Vertices[Indices[i + 1]].ToFVector() - P0).Cross(Mesh.Vertices[Indices[i + 2]].ToFVector() - P0);
+        const float Length = Normal.Magnitude();
+        if (Length <= 0.0f)
+            continue;
+        Normals.Add(Normal / Length);
+        NormalSum = NormalSum + Normals.Last();
+    }
+
+    Cluster.ConeAxis = FVector(0.0f, 0.0f, 0.0f);
+    Cluster.ConeCutoff = 1.0f;
+    const float AxisLength = NormalSum.Magnitude();
+    if (AxisLength <= 0.0f)
+        return;
+
+    const FVector Axis = NormalSum / AxisLength;
+    float MinDot = 1.0f;
+    for (const FVector& Normal : Normals)
+    {
+        MinDot = FMath::Min(MinDot, Normal.Dot(Axis));
+    }
+    Cluster.ConeAxis = Axis;
+    if (MinDot > MinConeDot)
+    {
+        Cluster.ConeCutoff = sqrtf(1.0f - MinDot * MinDot);
+    }
+}
+
+FMeshClusterCullStats FMeshClusterCuller::Cull(const OBJ::FStaticMeshRenderData& Mesh, const FMatrix& Model, const FMatrix& ViewProj, const FVector& CameraLocation,
+                                               const FVector& ViewDirection, bool bOrthographic, TArray<FMeshClusterRange>& OutRanges)
+{
+    FMeshClusterCullStats Stats;
+    Stats.NumClusters = Mesh.Clusters.Num();
+    OutRanges.Empty();
+
+    // 객체 공간에서 검사. 평면의 앞/뒤는 아핀 변환에서 유지되므로 비균등 스케일에서도 백페이스 판정이 같음
+    FFrustum LocalFrustum;
+    LocalFrustum.ConstructFrustum(Model * ViewProj);
+    const FMatrix InverseModel = FMatrix::Inverse(Model);
+    const FVector LocalCamera = InverseModel.TransformPosition(CameraLocation);
+    const FVector LocalViewDirection = FMatrix::TransformVector(ViewDirection, InverseModel).Normalize();
+
+    // 음수 스케일은 래스터라이저에서 와인딩이 뒤집히므로 콘 검사를 하지 않음
+    const bool bBackfaceCulling = Determinant3x3(Model) > 0.0f;
+
+    // 메시 전체가 안쪽이면 클러스터마다 프러스텀 검사를 하지 않음
+    const EFrustumContainment MeshContainment = LocalFrustum.CheckContainment(FBoundingBox(Mesh.BoundingBoxMin, Mesh.BoundingBoxMax));
+    if (MeshContainment == EFrustumContainment::Outside)
+    {
+        Stats.NumFrustumCulled = Stats.NumClusters;
+        return Stats;
+    }
+
+    for (const FMeshCluster& Cluster : Mesh.Clusters)
+    {
+        if (MeshContainment != EFrustumContainment::Contains &&
+            LocalFrustum.CheckContainment(FBoundingBox(Cluster.BoundsMin, Cluster.BoundsMax)) == EFrustumContainment::Outside)
+        {
+            ++Stats.NumFrustumCulled;
+            continue;
+        }
+
+        // 카메라가 클러스터 바운딩 구 전체에 대해 모든 삼각형의 뒤쪽에 있으면 컬링.
+        // 직교 투영은 모든 시선이 LocalViewDirection이므로 그 방향이 콘 안쪽 반대편에 있는지만 봄
+        if (bBackfaceCulling && Cluster.ConeCutoff < 1.0f)
+        {
+            const FVector ToCenter = Cluster.Center - LocalCamera;
+            const bool bBackfacing = bOrthographic
+                ? LocalViewDirection.Dot(Cluster.ConeAxis) >= Cluster.ConeCutoff
+                : ToCenter.Dot(Cluster.ConeAxis) >= Cluster.ConeCutoff * ToCenter.Magnitude() + Cluster.Radius;
+            if (bBackfacing)
+            {
+                ++Stats.NumBackfaceCulled;
+                continue;
+            }
+        }
+
+        Stats.NumVisibleIndices += Cluster.IndexCount;
+        if (OutRanges.Num() > 0 && OutRanges.Last().SubsetIndex == Cluster.SubsetIndex &&
+            OutRanges.Last().IndexStart + OutRanges.Last().IndexCount == Cluster.IndexStart)
+        {
+            OutRanges.Last().IndexCount += Cluster.IndexCount;
+        }
+        else
+        {
+            OutRanges.Add({Cluster.SubsetIndex, Cluster.IndexStart, Cluster.IndexCount});
+        }
+    }
+    return Stats;
+}
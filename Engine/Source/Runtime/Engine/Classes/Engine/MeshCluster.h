@@ -0,0 +1,41 @@
+#pragma once
+#include "Define.h"
+
+// 컬링 후 그릴 인덱스 구간. 같은 서브셋에서 이어지는 클러스터는 하나로 합침
+struct FMeshClusterRange
+{
+    uint32 SubsetIndex;
+    uint32 IndexStart;
+    uint32 IndexCount;
+};
+
+struct FMeshClusterCullStats
+{
+    int32 NumClusters = 0;
+    int32 NumFrustumCulled = 0;
+    int32 NumBackfaceCulled = 0;
+    int32 NumVisibleIndices = 0;
+};
+
+// 임포트 시 메시를 고정 크기 클러스터로 나눔
+struct FMeshClusterBuilder
+{
+    static constexpr int32 MaxVertices = 64;
+    static constexpr int32 MaxTriangles = 124;
+
+    // 서브셋 구간마다 인덱스 순서대로 잘라 Mesh.Clusters를 채움. 인덱스 순서는 바꾸지 않으므로 FMeshOptimizer 다음에 호출
+    static void Build(OBJ::FStaticMeshRenderData& Mesh);
+
+private:
+    static void ComputeClusterBounds(const OBJ::FStaticMeshRenderData& Mesh, FMeshCluster& Cluster);
+};
+
+// 클러스터 단위 CPU 컬링 (프러스텀 + 법선 콘 백페이스)
+struct FMeshClusterCuller
+{
+    // Model * ViewProj로 객체 공간 프러스텀을, CameraLocation(월드)으로 객체 공간 카메라 위치를 만들어 검사.
+    // 직교 투영이면 시선이 모두 평행하므로 콘은 카메라 위치 대신 ViewDirection(월드)과 비교.
+    // 보이는 클러스터를 IndexStart 순으로 OutRanges에 담음
+    static FMeshClusterCullStats Cull(const OBJ::FStaticMeshRenderData& Mesh, const FMatrix& Model, const FMatrix& ViewProj, const FVector& CameraLocation,
+                                      const FVector& ViewDirection, bool bOrthographic, TArray<FMeshClusterRange>& OutRanges);
+};
@@ -0,0 +1,366 @@
+#include "MeshOptimizer.h"
+
+namespace
+{
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation"의 기본 파라미터
+    constexpr int32 ForsythCacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+    constexpr int32 MaxValenceTable = 32;
+
+    // 오버드로 정렬에서 클러스터로 자를 최소 삼각형 수
+    constexpr int32 MinClusterTriangles = 16;
+
+    struct FVertexScoreTable
+    {
+        float CachePosition[ForsythCacheSize];
+        float Valence[MaxValenceTable];
+
+        FVertexScoreTable()
+        {
+            for (int32 i = 0; i < ForsythCacheSize; ++i)
+            {
+                // 방금 그린 삼각형의 세 정점은 고정 점수로, 다음 삼각형이 같은 정점을 바로 쓰는 것을 과하게 선호하지 않게 함
+                CachePosition[i] = i < 3 ? LastTriangleScore : powf(1.0f - static_cast<float>(i - 3) / (ForsythCacheSize - 3), CacheDecayPower);
+            }
+            Valence[0] = 0.0f;
+            for (int32 i = 1; i < MaxValenceTable; ++i)
+            {
+                Valence[i] = ValenceBoostScale * powf(static_cast<float>(i), -ValenceBoostPower);
+            }
+        }
+    };
+
+    // 남은 삼각형이 적은 정점일수록 높은 점수를 줘서 외톨이 삼각형이 남지 않게 함
+    float ComputeVertexScore(int32 CachePosition, int32 RemainingTriangles)
+    {
+        static const FVertexScoreTable Table;
+        if (RemainingTriangles == 0)
+            return -1.0f;
+
+        float Score = CachePosition >= 0 ? Table.CachePosition[CachePosition] : 0.0f;
+        Score += RemainingTriangles < MaxValenceTable ? Table.Valence[RemainingTriangles] : ValenceBoostScale * powf(static_cast<float>(RemainingTriangles), -ValenceBoostPower);
+        return Score;
+    }
+}
+
+FMeshOptimizeStats FMeshOptimizer::Optimize(OBJ::FStaticMeshRenderData& Mesh, bool bOptimizeOverdraw)
+{
+    FMeshOptimizeStats Stats;
+    const int32 NumVertices = Mesh.Vertices.Num();
+    Stats.Before = ComputeCacheStats(Mesh.Indices, NumVertices);
+
+    auto OptimizeRange = [&](uint32 IndexStart, uint32 IndexCount)
+    {
+        IndexCount -= IndexCount % 3;
+        if (IndexStart + IndexCount > static_cast<uint32>(Mesh.Indices.Num()))
+            return;
+        UINT* Indices = Mesh.Indices.GetData() + IndexStart;
+        if (OptimizeVertexCache(Indices, static_cast<int32>(IndexCount), NumVertices) && bOptimizeOverdraw)
+            OptimizeOverdraw(Indices, static_cast<int32>(IndexCount), Mesh.Vertices);
+    };
+
+    if (Mesh.MaterialSubsets.IsEmpty())
+    {
+        OptimizeRange(0, Mesh.Indices.Num());
+    }
+    else
+    {
+        for (const FMaterialSubset& Subset : Mesh.MaterialSubsets)
+        {
+            OptimizeRange(Subset.IndexStart, Subset.IndexCount);
+        }
+    }
+
+    OptimizeVertexFetch(Mesh);
+    Stats.After = ComputeCacheStats(Mesh.Indices, Mesh.Vertices.Num());
+    return Stats;
+}
+
+FVertexCacheStats FMeshOptimizer::ComputeCacheStats(const TArray<UINT>& Indices, int32 NumVertices, int32 CacheSize)
+{
+    FVertexCacheStats Stats;
+    const int32 NumTriangles = Indices.Num() / 3;
+    if (NumTriangles == 0 || NumVertices == 0)
+        return Stats;
+
+    // FIFO: 미스가 날 때만 시각이 흐르고, 들어온 지 CacheSize 미스가 지난 정점은 밀려난 것
+    TArray<int32> InsertTime;
+    InsertTime.Init(INT32_MIN / 2, NumVertices);
+    TArray<uint8> bReferenced;
+    bReferenced.Init(0, NumVertices);
+    int32 Misses = 0;
+    int32 NumReferenced = 0;
+    for (int32 i = 0; i < NumTriangles * 3; ++i)
+    {
+        const UINT Index = Indices[i];
+        if (Index >= static_cast<UINT>(NumVertices))
+            continue;
+        if (Misses - InsertTime[Index] >= CacheSize)
+        {
+            InsertTime[Index] = Misses;
+            ++Misses;
+        }
+        if (!bReferenced[Index])
+        {
+            bReferenced[Index] = 1;
+            ++NumReferenced;
+        }
+    }
+
+    Stats.ACMR = static_cast<float>(Misses) / NumTriangles;
+    Stats.ATVR = NumReferenced > 0 ? static_cast<float>(Misses) / NumReferenced : 0.0f;
+    return Stats;
+}
+
+bool FMeshOptimizer::OptimizeVertexCache(UINT* Indices, int32 NumIndices, int32 NumVertices)
+{
+    const int32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2)
+        return false;
+
+    // 정점 -> 삼각형 인접 목록 (CSR). 그려진 삼각형은 각 정점 목록의 뒤로 밀어내고 RemainingTriangles를 줄임
+    TArray<int32> AdjacencyOffsets;
+    AdjacencyOffsets.Init(0, NumVertices + 1);
+    for (int32 i = 0; i < NumIndices; ++i)
+    {
+        if (Indices[i] >= static_cast<UINT>(NumVertices))
+            return false;
+        AdjacencyOffsets[Indices[i] + 1]++;
+    }
+    for (int32 v = 0; v < NumVertices; ++v)
+    {
+        AdjacencyOffsets[v + 1] += AdjacencyOffsets[v];
+    }
+
+    TArray<int32> RemainingTriangles;
+    RemainingTriangles.Init(0, NumVertices);
+    TArray<int32> Adjacency;
+    Adjacency.SetNum(NumIndices);
+    for (int32 i = 0; i < NumIndices; ++i)
+    {
+        const UINT v = Indices[i];
+        Adjacency[AdjacencyOffsets[v] + RemainingTriangles[v]++] = i / 3;
+    }
+
+    TArray<int32> CachePosition;
+    CachePosition.Init(-1, NumVertices);
+    TArray<float> VertexScore;
+    VertexScore.SetNum(NumVertices);
+    for (int32 v = 0; v < NumVertices; ++v)
+    {
+        VertexScore[v] = ComputeVertexScore(-1, RemainingTriangles[v]);
+    }
+
+    TArray<float> TriangleScore;
+    TriangleScore.SetNum(NumTriangles);
+    TArray<uint8> bEmitted;
+    bEmitted.Init(0, NumTriangles);
+    int32 BestTriangle = 0;
+    for (int32 t = 0; t < NumTriangles; ++t)
+    {
+        TriangleScore[t] = VertexScore[Indices[t * 3]] + VertexScore[Indices[t * 3 + 1]] + VertexScore[Indices[t * 3 + 2]];
+        if (TriangleScore[t] > TriangleScore[BestTriangle])
+            BestTriangle = t;
+    }
+
+    TArray<UINT> Output;
+    Output.Reserve(NumIndices);
+    int32 Cache[ForsythCacheSize + 3];
+    int32 CacheCount = 0;
+    int32 NextCandidate = 0;
+
+    while (Output.Num() < NumTriangles * 3)
+    {
+        // 캐시 주변에 남은 삼각형이 없으면 아직 안 그린 첫 삼각형부터 다시 시작
+        if (BestTriangle < 0)
+        {
+            while (bEmitted[NextCandidate])
+                ++NextCandidate;
+            BestTriangle = NextCandidate;
+        }
+
+        const UINT Triangle[3] = {Indices[BestTriangle * 3], Indices[BestTriangle * 3 + 1], Indices[BestTriangle * 3 + 2]};
+        Output.Add(Triangle[0]);
+        Output.Add(Triangle[1]);
+        Output.Add(Triangle[2]);
+        bEmitted[BestTriangle] = 1;
+
+        for (const UINT v : Triangle)
+        {
+            int32* Begin = Adjacency.GetData() + AdjacencyOffsets[v];
+            int32* Last = Begin + RemainingTriangles[v] - 1;
+            for (int32* It = Begin; It <= Last; ++It)
+            {
+                if (*It == BestTriangle)
+                {
+                    std::swap(*It, *Last);
+                    RemainingTriangles[v]--;
+                    break;
+                }
+            }
+        }
+
+        // LRU 갱신: 새 삼각형의 정점을 앞에, 기존 캐시를 그 뒤에. ForsythCacheSize를 넘은 정점은 캐시에서 빠짐
+        int32 NewCache[ForsythCacheSize + 3];
+        int32 NewCount = 0;
+        for (const UINT v : Triangle)
+        {
+            if (std::find(NewCache, NewCache + NewCount, static_cast<int32>(v)) == NewCache + NewCount)
+                NewCache[NewCount++] = static_cast<int32>(v);
+        }
+        for (int32 i = 0; i < CacheCount; ++i)
+        {
+            if (Cache[i] != static_cast<int32>(Triangle[0]) && Cache[i] != static_cast<int32>(Triangle[1]) && Cache[i] != static_cast<int32>(Triangle[2]))
+                NewCache[NewCount++] = Cache[i];
+        }
+
+        for (int32 i = 0; i < NewCount; ++i)
+        {
+            const int32 v = NewCache[i];
+            CachePosition[v] = i < ForsythCacheSize ? i : -1;
+            VertexScore[v] = ComputeVertexScore(CachePosition[v], RemainingTriangles[v]);
+        }
+
+        // 점수가 바뀐 정점에 붙은 삼각형만 다시 계산해 다음 후보를 고름
+        BestTriangle = -1;
+        float BestScore = -1.0f;
+        for (int32 i = 0; i < NewCount; ++i)
+        {
+            const int32 v = NewCache[i];
+            for (int32 j = 0; j < RemainingTriangles[v]; ++j)
+            {
+                const int32 t = Adjacency[AdjacencyOffsets[v] + j];
+                const float Score = VertexScore[Indices[t * 3]] + VertexScore[Indices[t * 3 + 1]] + VertexScore[Indices[t * 3 + 2]];
+                TriangleScore[t] = Score;
+                if (Score > BestScore)
+                {
+                    BestScore = Score;
+                    BestTriangle = t;
+                }
+            }
+        }
+
+        CacheCount = FMath::Min(NewCount, ForsythCacheSize);
+        std::copy(NewCache, NewCache + CacheCount, Cache);
+    }
+
+    std::copy(Output.begin(), Output.end(), Indices);
+    return true;
+}
+
+void FMeshOptimizer::OptimizeOverdraw(UINT* Indices, int32 NumIndices, const TArray<FVertexCompact>& Vertices)
+{
+    const int32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < MinClusterTriangles * 2)
+        return;
+
+    // 1. 캐시 순서를 유지한 채, 세 정점이 모두 미스인 삼각형(캐시가 새로 시작되는 지점)에서 클러스터를 자름
+    TArray<int32> ClusterStarts;
+    ClusterStarts.Add(0);
+    {
+        TArray<int32> InsertTime;
+        InsertTime.Init(INT32_MIN / 2, Vertices.Num());
+        int32 Misses = 0;
+        for (int32 t = 0; t < NumTriangles; ++t)
+        {
+            int32 TriangleMisses = 0;
+            for (int32 k = 0; k < 3; ++k)
+            {
+                const UINT v = Indices[t * 3 + k];
+                if (Misses - InsertTime[v] >= StatsCacheSize)
+                {
+                    InsertTime[v] = Misses;
+                    ++Misses;
+                    ++TriangleMisses;
+                }
+            }
+            if (TriangleMisses == 3 && t - ClusterStarts.Last() >= MinClusterTriangles)
+                ClusterStarts.Add(t);
+        }
+    }
+    const int32 NumClusters = ClusterStarts.Num();
+    if (NumClusters < 2)
+        return;
+    ClusterStarts.Add(NumTriangles);
+
+    // 2. 클러스터의 면적 가중 중심과 평균 법선. 메시 중심에서 바깥을 향하는 클러스터일수록 가리는 쪽이므로 먼저 그림
+    struct FCluster
+    {
+        int32 Index;
+        FVector Centroid;
+        FVector Normal;
+        float Area;
+        float SortKey;
+    };
+    TArray<FCluster> Clusters;
+    Clusters.SetNum(NumClusters);
+    FVector MeshCentroid(0.0f, 0.0f, 0.0f);
+    float MeshArea = 0.0f;
+    for (int32 c = 0; c < NumClusters; ++c)
+    {
+        FCluster& Cluster = Clusters[c];
+        Cluster.Index = c;
+        Cluster.Centroid = FVector(0.0f, 0.0f, 0.0f);
+        Cluster.Normal = FVector(0.0f, 0.0f, 0.0f);
+        Cluster.Area = 0.0f;
+        for (int32 t = ClusterStarts[c]; t < ClusterStarts[c + 1]; ++t)
+        {
+            const FVector P0 = Vertices[Indices[t * 3]].ToFVector();
+            const FVector P1 = Vertices[Indices[t * 3 + 1]].ToFVector();
+            const FVector P2 = Vertices[Indices[t * 3 + 2]].ToFVector();
+            const FVector Cross = (P1 - P0).Cross(P2 - P0);
+            const float Area = Cross.Magnitude();
+            Cluster.Centroid = Cluster.Centroid + (P0 + P1 + P2) * (Area / 3.0f);
+            Cluster.Normal = Cluster.Normal + Cross;
+            Cluster.Area += Area;
+        }
+        MeshCentroid = MeshCentroid + Cluster.Centroid;
+        MeshArea += Cluster.Area;
+        if (Cluster.Area > 0.0f)
+            Cluster.Centroid = Cluster.Centroid / Cluster.Area;
+    }
+    if (MeshArea <= 0.0f)
+        return;
+    MeshCentroid = MeshCentroid / MeshArea;
+
+    for (FCluster& Cluster : Clusters)
+    {
+        const float NormalLength = Cluster.Normal.Magnitude();
+        Cluster.SortKey = NormalLength > 0.0f ? (Cluster.Centroid - MeshCentroid).Dot(Cluster.Normal / NormalLength) : 0.0f;
+    }
+    std::stable_sort(Clusters.begin(), Clusters.end(), [](const FCluster& A, const FCluster& B) { return A.SortKey > B.SortKey; });
+
+    // 3. 정렬된 순서로 삼각형을 다시 씀
+    TArray<UINT> Sorted;
+    Sorted.Reserve(NumTriangles * 3);
+    for (const FCluster& Cluster : Clusters)
+    {
+        for (int32 i = ClusterStarts[Cluster.Index] * 3; i < ClusterStarts[Cluster.Index + 1] * 3; ++i)
+            Sorted.Add(Indices[i]);
+    }
+    std::copy(Sorted.begin(), Sorted.end(), Indices);
+}
+
+void FMeshOptimizer::OptimizeVertexFetch(OBJ::FStaticMeshRenderData& Mesh)
+{
+    // 인덱스 버퍼에서 처음 등장하는 순서대로 정점을 배치. 참조되지 않는 정점은 버림
+    TArray<int32> Remap;
+    Remap.Init(-1, Mesh.Vertices.Num());
+    TArray<FVertexCompact> NewVertices;
+    NewVertices.Reserve(Mesh.Vertices.Num());
+    for (UINT& Index : Mesh.Indices)
+    {
+        if (Index >= static_cast<UINT>(Remap.Num()))
+            return;
+        if (Remap[Index] < 0)
+            Remap[Index] = NewVertices.Add(Mesh.Vertices[Index]);
+    }
+    for (UINT& Index : Mesh.Indices)
+    {
+        Index = static_cast<UINT>(Remap[Index]);
+    }
+    Mesh.Vertices = std::move(NewVertices);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Define.h"
+
+// FIFO 정점 캐시 시뮬레이션 결과
+struct FVertexCacheStats
+{
+    float ACMR = 0.0f; // 삼각형당 캐시 미스 (0.5 근처가 이상적, 최악 3)
+    float ATVR = 0.0f; // 참조된 정점당 캐시 미스 (1이 최적)
+};
+
+struct FMeshOptimizeStats
+{
+    FVertexCacheStats Before;
+    FVertexCacheStats After;
+};
+
+// 임포트 시 인덱스/정점 순서 최적화.
+// 서브셋 구간 안에서만 삼각형 순서를 바꾸므로 FMaterialSubset의 IndexStart/IndexCount는 그대로 유지됨
+struct FMeshOptimizer
+{
+    // 통계에 쓰는 FIFO 캐시 크기 (post-transform 캐시 근사)
+    static constexpr int32 StatsCacheSize = 16;
+
+    // 1. Forsyth 방식 삼각형 재배치 2. (선택) 클러스터 단위 바깥쪽 우선 정렬로 오버드로 감소 3. 첫 사용 순서로 정점 재배치
+    static FMeshOptimizeStats Optimize(OBJ::FStaticMeshRenderData& Mesh, bool bOptimizeOverdraw);
+
+    static FVertexCacheStats ComputeCacheStats(const TArray<UINT>& Indices, int32 NumVertices, int32 CacheSize = StatsCacheSize);
+
+private:
+    //범위 밖 인덱스가 있거나 삼각형이 2개 미만이면 건드리지 않고 false
+    static bool OptimizeVertexCache(UINT* Indices, int32 NumIndices, int32 NumVertices);
+    static void OptimizeOverdraw(UINT* Indices, int32 NumIndices, const TArray<FVertexCompact>& Vertices);
+    static void OptimizeVertexFetch(OBJ::FStaticMeshRenderData& Mesh);
+};
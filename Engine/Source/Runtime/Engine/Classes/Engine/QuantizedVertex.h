@@ -0,0 +1,201 @@
+#pragma once
+#include "Define.h"
+
+// 위치 양자화 기준 범위 (보통 메시 바운딩 박스)
+struct FVertexQuantizationBounds
+{
+    FVector Min;
+    FVector Extent; // 0인 축은 1로 둬서 0으로 나누지 않게 함
+
+    static FVertexQuantizationBounds FromMinMax(const FVector& InMin, const FVector& InMax)
+    {
+        FVertexQuantizationBounds Bounds;
+        Bounds.Min = InMin;
+        Bounds.Extent = InMax - InMin;
+        Bounds.Extent.x = Bounds.Extent.x > 0.0f ? Bounds.Extent.x : 1.0f;
+        Bounds.Extent.y = Bounds.Extent.y > 0.0f ? Bounds.Extent.y : 1.0f;
+        Bounds.Extent.z = Bounds.Extent.z > 0.0f ? Bounds.Extent.z : 1.0f;
+        return Bounds;
+    }
+
+    // 메시에 저장된 바운딩 박스 기준. 양자화한 정점에서 다시 구하지 않으므로 여러 번 적용해도 같은 기준이 나옴
+    static FVertexQuantizationBounds FromMesh(const OBJ::FStaticMeshRenderData& Mesh)
+    {
+        return FromMinMax(Mesh.BoundingBoxMin, Mesh.BoundingBoxMax);
+    }
+};
+
+namespace VertexQuantization
+{
+    // [Min, Min + Extent]를 [0, MaxValue] 정수로
+    inline uint32 QuantizeUnorm(float Value, float Min, float Extent, uint32 MaxValue)
+    {
+        const float T = FMath::Clamp((Value - Min) / Extent, 0.0f, 1.0f);
+        return static_cast<uint32>(T * static_cast<float>(MaxValue) + 0.5f);
+    }
+
+    inline float DequantizeUnorm(uint32 Quantized, float Min, float Extent, uint32 MaxValue)
+    {
+        return Min + Extent * (static_cast<float>(Quantized) / static_cast<float>(MaxValue));
+    }
+}
+
+// 12 bytes: 바운드 기준 16비트 위치 + FVertexCompact와 같은 16비트 UV. 위치 오차는 축마다 Extent / 131070 이하
+struct FVertexPos16
+{
+    uint16 X, Y, Z;
+    uint16 Pad;
+    uint16 U, V;
+};
+static_assert(sizeof(FVertexPos16) == 12);
+
+// 8 bytes: 바운드 기준 11/11/10비트 위치를 uint32 하나에 묶음 + 16비트 UV. 먼 LOD처럼 오차가 보이지 않는 곳용
+struct FVertexPacked8
+{
+    uint32 Position; // x: 0~10, y: 11~21, z: 22~31
+    uint16 U, V;
+};
+static_assert(sizeof(FVertexPacked8) == 8);
+
+// 레이아웃별 인코더/디코더. FVertexCompact <-> LayoutType
+template <typename LayoutType>
+struct TVertexCodec;
+
+template <>
+struct TVertexCodec<FVertexCompact>
+{
+    static constexpr const char* Name = "Compact";
+    static constexpr float MaxRelativeError = 0.0f;
+
+    static FVertexCompact Encode(const FVertexCompact& Vertex, const FVertexQuantizationBounds&) { return Vertex; }
+    static FVertexCompact Decode(const FVertexCompact& Vertex, const FVertexQuantizationBounds&) { return Vertex; }
+};
+
+template <>
+struct TVertexCodec<FVertexPos16>
+{
+    static constexpr const char* Name = "Pos16";
+    static constexpr uint32 MaxValue = 0xffff;
+    // 축마다 반 칸(Extent / 2MaxValue) 이하이므로 바운드 대각선 대비로도 이 값 이하
+    static constexpr float MaxRelativeError = 0.5f / MaxValue;
+
+    static FVertexPos16 Encode(const FVertexCompact& Vertex, const FVertexQuantizationBounds& Bounds)
+    {
+        FVertexPos16 Out;
+        Out.X = static_cast<uint16>(VertexQuantization::QuantizeUnorm(Vertex.x, Bounds.Min.x, Bounds.Extent.x, MaxValue));
+        Out.Y = static_cast<uint16>(VertexQuantization::QuantizeUnorm(Vertex.y, Bounds.Min.y, Bounds.Extent.y, MaxValue));
+        Out.Z = static_cast<uint16>(VertexQuantization::QuantizeUnorm(Vertex.z, Bounds.Min.z, Bounds.Extent.z, MaxValue));
+        Out.Pad = 0;
+        Out.U = Vertex.u;
+        Out.V = Vertex.v;
+        return Out;
+    }
+
+    static FVertexCompact Decode(const FVertexPos16& Vertex, const FVertexQuantizationBounds& Bounds)
+    {
+        FVertexCompact Out;
+        Out.x = VertexQuantization::DequantizeUnorm(Vertex.X, Bounds.Min.x, Bounds.Extent.x, MaxValue);
+        Out.y = VertexQuantization::DequantizeUnorm(Vertex.Y, Bounds.Min.y, Bounds.Extent.y, MaxValue);
+        Out.z = VertexQuantization::DequantizeUnorm(Vertex.Z, Bounds.Min.z, Bounds.Extent.z, MaxValue);
+        Out.u = Vertex.U;
+        Out.v = Vertex.V;
+        return Out;
+    }
+};
+
+template <>
+struct TVertexCodec<FVertexPacked8>
+{
+    static constexpr const char* Name = "Packed8";
+    static constexpr uint32 MaxXY = (1u << 11) - 1;
+    static constexpr uint32 MaxZ = (1u << 10) - 1;
+    static constexpr float MaxRelativeError = 0.5f / MaxZ;
+
+    static FVertexPacked8 Encode(const FVertexCompact& Vertex, const FVertexQuantizationBounds& Bounds)
+    {
+        const uint32 X = VertexQuantization::QuantizeUnorm(Vertex.x, Bounds.Min.x, Bounds.Extent.x, MaxXY);
+        const uint32 Y = VertexQuantization::QuantizeUnorm(Vertex.y, Bounds.Min.y, Bounds.Extent.y, MaxXY);
+        const uint32 Z = VertexQuantization::QuantizeUnorm(Vertex.z, Bounds.Min.z, Bounds.Extent.z, MaxZ);
+        FVertexPacked8 Out;
+        Out.Position = X | (Y << 11) | (Z << 22);
+        Out.U = Vertex.u;
+        Out.V = Vertex.v;
+        return Out;
+    }
+
+    static FVertexCompact Decode(const FVertexPacked8& Vertex, const FVertexQuantizationBounds& Bounds)
+    {
+        FVertexCompact Out;
+        Out.x = VertexQuantization::DequantizeUnorm(Vertex.Position & MaxXY, Bounds.Min.x, Bounds.Extent.x, MaxXY);
+        Out.y = VertexQuantization::DequantizeUnorm((Vertex.Position >> 11) & MaxXY, Bounds.Min.y, Bounds.Extent.y, MaxXY);
+        Out.z = VertexQuantization::DequantizeUnorm(Vertex.Position >> 22, Bounds.Min.z, Bounds.Extent.z, MaxZ);
+        Out.u = Vertex.U;
+        Out.v = Vertex.V;
+        return Out;
+    }
+};
+
+template <typename LayoutType>
+void EncodeVertices(const FVertexCompact* Vertices, int32 NumVertices, const FVertexQuantizationBounds& Bounds, LayoutType* OutVertices)
+{
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        OutVertices[i] = TVertexCodec<LayoutType>::Encode(Vertices[i], Bounds);
+    }
+}
+
+template <typename LayoutType>
+void DecodeVertices(const LayoutType* Vertices, int32 NumVertices, const FVertexQuantizationBounds& Bounds, FVertexCompact* OutVertices)
+{
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        OutVertices[i] = TVertexCodec<LayoutType>::Decode(Vertices[i], Bounds);
+    }
+}
+
+// 정점을 LayoutType으로 인코딩했다가 다시 디코딩한 값으로 바꿈. 격자 위의 값은 같은 기준으로 다시 인코딩해도 그대로 남음
+template <typename LayoutType>
+void QuantizeVertices(TArray<FVertexCompact>& Vertices, const FVertexQuantizationBounds& Bounds)
+{
+    for (FVertexCompact& Vertex : Vertices)
+    {
+        Vertex = TVertexCodec<LayoutType>::Decode(TVertexCodec<LayoutType>::Encode(Vertex, Bounds), Bounds);
+    }
+}
+
+// 인코딩 -> 디코딩 왕복의 최대 위치 오차 (바운드 대각선에 대한 비율). UV가 달라지면 FLT_MAX
+template <typename LayoutType>
+float MeasureRoundTripError(const TArray<FVertexCompact>& Vertices, const FVertexQuantizationBounds& Bounds)
+{
+    float MaxError = 0.0f;
+    for (const FVertexCompact& Vertex : Vertices)
+    {
+        const FVertexCompact Decoded = TVertexCodec<LayoutType>::Decode(TVertexCodec<LayoutType>::Encode(Vertex, Bounds), Bounds);
+        if (Decoded.u != Vertex.u || Decoded.v != Vertex.v)
+            return FLT_MAX;
+        MaxError = FMath::Max(MaxError, (Decoded.ToFVector() - Vertex.ToFVector()).Magnitude());
+    }
+    return MaxError / Bounds.Extent.Magnitude();
+}
+
+// 왕복 오차가 레이아웃의 이론 한도(반 칸) 안인지. 원점에서 먼 작은 메시는 float 자체의 간격이 칸보다 클 수 있어 그 몫만 더 허용
+template <typename LayoutType>
+bool IsRoundTripErrorWithinTolerance(const TArray<FVertexCompact>& Vertices, const FVertexQuantizationBounds& Bounds)
+{
+    const FVector Max = Bounds.Min + Bounds.Extent;
+    const float MaxAbsCoord = FMath::Max(FMath::Max(FMath::Max(FMath::Abs(Bounds.Min.x), FMath::Abs(Max.x)), FMath::Max(FMath::Abs(Bounds.Min.y), FMath::Abs(Max.y))),
+                                         FMath::Max(FMath::Abs(Bounds.Min.z), FMath::Abs(Max.z)));
+    const float FloatSlack = 4.0f * FLT_EPSILON * MaxAbsCoord / Bounds.Extent.Magnitude();
+    return MeasureRoundTripError<LayoutType>(Vertices, Bounds) <= TVertexCodec<LayoutType>::MaxRelativeError * 1.01f + FloatSlack;
+}
+
+// .bin 캐시에 쓰는 정점 레이아웃. MESH_CACHE_VERTEX_PACKED8을 1로 빌드하면 8바이트 레이아웃 사용
+#ifndef MESH_CACHE_VERTEX_PACKED8
+#define MESH_CACHE_VERTEX_PACKED8 0
+#endif
+
+#if MESH_CACHE_VERTEX_PACKED8
+using FMeshCacheVertex = FVertexPacked8;
+#else
+using FMeshCacheVertex = FVertexPos16;
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstring>
+
+#include "HAL/PlatformType.h"
+#include "QuantizedVertex.h"
+
+// .bin 메시 캐시 레이아웃
+// [FHeader][청크 ...][FChunk 테이블]. 청크는 ChunkAlignment 경계에서 시작하므로 매핑한 뷰에서 바로 정점/인덱스 배열로 읽을 수 있음
+// Magic, Version, VertexStride, 체크섬, 원본 OBJ 타임스탬프 중 하나라도 맞지 않으면 캐시를 버리고 다시 생성
+namespace MeshCache
+{
+    constexpr uint32 Magic = 0x4843534D; // "MSCH"
+    constexpr uint32 Version = 5; // 2: 인덱스/정점을 FMeshOptimizer 순서로 저장, 3: ImportSettings 청크, 4: 양자화 정점 + 16비트 인덱스, 5: Clusters 청크
+    constexpr uint64 ChunkAlignment = 16;
+
+    enum class EChunkType : uint32
+    {
+        LODThresholds,  // float[] : 체인 생성에 쓴 FManagerOBJ::LODErrorThresholds
+        MeshInfo,       // LOD별 이름, 머티리얼, 서브셋, 바운딩 박스
+        Vertices,       // LOD별 FVertexChunkHeader + FMeshCacheVertex[]
+        Indices,        // LOD별 uint16[] 또는 UINT[] (GetIndexStride)
+        ImportSettings, // FImportSettings : 생성에 쓴 용접 설정
+        Clusters,       // LOD별 FMeshCluster[]
+    };
+
+    struct FImportSettings
+    {
+        float VertexWeldEpsilon;
+    };
+
+    // Vertices 청크 앞부분. 뒤따르는 정점 배열이 16바이트 경계에 오도록 32바이트
+    struct FVertexChunkHeader
+    {
+        FVertexQuantizationBounds Bounds;
+        uint32 NumVertices;
+        uint32 Padding;
+    };
+    static_assert(sizeof(FVertexChunkHeader) == 32);
+
+    // 정점이 65536개 이하인 LOD는 인덱스를 uint16으로 저장
+    inline uint32 GetIndexStride(uint64 NumVertices)
+    {
+        return NumVertices <= 0x10000 ? sizeof(uint16) : sizeof(uint32);
+    }
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 VertexStride;     // sizeof(FMeshCacheVertex). 다른 레이아웃으로 빌드한 캐시는 버림
+        uint32 NumLODs;
+        uint64 SourceTimestamp;  // 원본 OBJ의 마지막 수정 시각 (FILETIME)
+        uint64 SourceSize;
+        uint64 ChunkTableOffset;
+        uint32 NumChunks;
+        uint32 Padding;
+        uint64 Checksum;         // 헤더 뒤 파일 전체의 ComputeChecksum
+    };
+    static_assert(sizeof(FHeader) == 56);
+
+    struct FChunk
+    {
+        EChunkType Type;
+        uint32 LODIndex;
+        uint64 Offset;
+        uint64 Size;
+    };
+    static_assert(sizeof(FChunk) == 24);
+
+    // 8바이트 단위 FNV-1a 변형. 손상/잘린 파일 검출용이며 암호학적 해시는 아님
+    inline uint64 ComputeChecksum(const uint8* Data, uint64 Size)
+    {
+        constexpr uint64 Prime = 0x100000001b3ull;
+        uint64 Hash = 0xcbf29ce484222325ull;
+        uint64 i = 0;
+        for (; i + sizeof(uint64) <= Size; i += sizeof(uint64))
+        {
+            uint64 Word;
+            memcpy(&Word, Data + i, sizeof(Word));
+            Hash = (Hash ^ Word) * Prime;
+        }
+        for (; i < Size; ++i)
+        {
+            Hash = (Hash ^ Data[i]) * Prime;
+        }
+        return Hash;
+    }
+}
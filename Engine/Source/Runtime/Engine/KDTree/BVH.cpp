@@ -0,0 +1,536 @@
+#include "BVH.h"
+
+#include <algorithm>
+
+#include "Async/ParallelFor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Math/Ray.h"
+#include "Profiling/PlatformTime.h"
+#include "Profiling/StatRegistry.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+    constexpr int32 NumBins = 16;
+    // 노드 방문 비용 / 프리미티브 교차 비용
+    constexpr float TraversalCost = 1.0f;
+
+    float HalfSurfaceArea(const FVector& Min, const FVector& Max)
+    {
+        const FVector Extent = Max - Min;
+        return Extent.x * Extent.y + Extent.y * Extent.z + Extent.z * Extent.x;
+    }
+
+    float GetAxis(const FVector& V, int32 Axis)
+    {
+        return Axis == 0 ? V.x : (Axis == 1 ? V.y : V.z);
+    }
+}
+
+static uint32 BuildNodesRecursive(TArray<FBVHBuildPrimitive>& Primitives, int32 MaxLeafSize, bool bSplitByCost, TArray<FBVHNode>& Nodes, int32 Start, int32 End)
+{
+    // Add로 재할당될 수 있으므로 노드는 끝까지 인덱스로만 접근
+    const uint32 NodeIndex = static_cast<uint32>(Nodes.Add(FBVHNode()));
+    const int32 Count = End - Start;
+
+    FVector BoundsMin(FLT_MAX, FLT_MAX, FLT_MAX), BoundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    FVector CentroidMin(FLT_MAX, FLT_MAX, FLT_MAX), CentroidMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int32 i = Start; i < End; ++i)
+    {
+        BoundsMin = FVector::Min(BoundsMin, Primitives[i].Min);
+        BoundsMax = FVector::Max(BoundsMax, Primitives[i].Max);
+        CentroidMin = FVector::Min(CentroidMin, Primitives[i].Centroid);
+        CentroidMax = FVector::Max(CentroidMax, Primitives[i].Centroid);
+    }
+    Nodes[NodeIndex].Min = BoundsMin;
+    Nodes[NodeIndex].Max = BoundsMax;
+
+    if (Count == 1 || (!bSplitByCost && Count <= MaxLeafSize))
+    {
+        Nodes[NodeIndex].Offset = static_cast<uint32>(Start);
+        Nodes[NodeIndex].Count = static_cast<uint16>(Count);
+        return NodeIndex;
+    }
+
+    // 세 축 모두 중심점 범위를 NumBins개 구간으로 나눠 구간 경계마다 SAH 비용 계산
+    struct FBin
+    {
+        FVector Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+        FVector Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        int32 Count = 0;
+    };
+
+    float BestCost = FLT_MAX;
+    int32 BestAxis = -1;
+    int32 BestSplit = 0; // 이 구간 인덱스 미만이 왼쪽
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const float AxisMin = GetAxis(CentroidMin, Axis);
+        const float Extent = GetAxis(CentroidMax, Axis) - AxisMin;
+        if (Extent <= 1e-6f) continue;
+
+        const float Scale = NumBins / Extent;
+        FBin Bins[NumBins];
+        for (int32 i = Start; i < End; ++i)
+        {
+            const int32 Bin = FMath::Min(NumBins - 1, static_cast<int32>((GetAxis(Primitives[i].Centroid, Axis) - AxisMin) * Scale));
+            Bins[Bin].Min = FVector::Min(Bins[Bin].Min, Primitives[i].Min);
+            Bins[Bin].Max = FVector::Max(Bins[Bin].Max, Primitives[i].Max);
+            ++Bins[Bin].Count;
+        }
+
+        // 오른쪽에서부터 누적한 면적/개수를 저장해 두고 왼쪽에서 한 번 훑으며 비용 계산
+        float RightArea[NumBins];
+        int32 RightCount[NumBins];
+        FVector AccMin(FLT_MAX, FLT_MAX, FLT_MAX), AccMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        int32 AccCount = 0;
+        for (int32 b = NumBins - 1; b > 0; --b)
+        {
+            AccMin = FVector::Min(AccMin, Bins[b].Min);
+            AccMax = FVector::Max(AccMax, Bins[b].Max);
+            AccCount += Bins[b].Count;
+            RightArea[b] = AccCount > 0 ? HalfSurfaceArea(AccMin, AccMax) : 0.0f;
+            RightCount[b] = AccCount;
+        }
+
+        AccMin = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+        AccMax = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        AccCount = 0;
+        for (int32 b = 0; b < NumBins - 1; ++b)
+        {
+            AccMin = FVector::Min(AccMin, Bins[b].Min);
+            AccMax = FVector::Max(AccMax, Bins[b].Max);
+            AccCount += Bins[b].Count;
+            if (AccCount == 0 || RightCount[b + 1] == 0) continue;
+
+            const float Cost = AccCount * HalfSurfaceArea(AccMin, AccMax) + RightCount[b + 1] * RightArea[b + 1];
+            if (Cost < BestCost)
+            {
+                BestCost = Cost;
+                BestAxis = Axis;
+                BestSplit = b + 1;
+            }
+        }
+    }
+
+    // 분할 비용 = TraversalCost + BestCost / 부모 면적. 부모 면적을 곱해 나눗셈(면적 0) 회피
+    const float ParentArea = HalfSurfaceArea(BoundsMin, BoundsMax);
+    if (Count <= MaxLeafSize && (BestAxis < 0 || Count * ParentArea <= TraversalCost * ParentArea + BestCost))
+    {
+        Nodes[NodeIndex].Offset = static_cast<uint32>(Start);
+        Nodes[NodeIndex].Count = static_cast<uint16>(Count);
+        return NodeIndex;
+    }
+
+    FBVHBuildPrimitive* First = Primitives.GetData() + Start;
+    FBVHBuildPrimitive* Last = Primitives.GetData() + End;
+    int32 Mid;
+    if (BestAxis >= 0)
+    {
+        const float AxisMin = GetAxis(CentroidMin, BestAxis);
+        const float Scale = NumBins / (GetAxis(CentroidMax, BestAxis) - AxisMin);
+        FBVHBuildPrimitive* Split = std::partition(First, Last, [&](const FBVHBuildPrimitive& Prim)
+        {
+            return FMath::Min(NumBins - 1, static_cast<int32>((GetAxis(Prim.Centroid, BestAxis) - AxisMin) * Scale)) < BestSplit;
+        });
+        Mid = Start + static_cast<int32>(Split - First);
+    }
+    else
+    {
+        // 중심점이 모두 겹쳐 구간을 나눌 수 없으면 개수로 반씩
+        BestAxis = 0;
+        Mid = Start + Count / 2;
+    }
+
+    BuildNodesRecursive(Primitives, MaxLeafSize, bSplitByCost, Nodes, Start, Mid); // 왼쪽 자식은 항상 NodeIndex + 1
+    const uint32 RightChild = BuildNodesRecursive(Primitives, MaxLeafSize, bSplitByCost, Nodes, Mid, End);
+    Nodes[NodeIndex].Offset = RightChild;
+    Nodes[NodeIndex].Axis = static_cast<uint8>(BestAxis);
+    return NodeIndex;
+}
+
+void BuildBVHNodes(TArray<FBVHBuildPrimitive>& Primitives, int32 MaxLeafSize, TArray<FBVHNode>& OutNodes, bool bSplitByCost)
+{
+    OutNodes.Empty();
+    if (Primitives.IsEmpty()) return;
+
+    // 리프가 하나 이상의 프리미티브를 가지므로 노드 수는 2N-1을 넘지 않음
+    OutNodes.Reserve(Primitives.Num() * 2 - 1);
+    BuildNodesRecursive(Primitives, MaxLeafSize, bSplitByCost, OutNodes, 0, Primitives.Num());
+    OutNodes.ShrinkToFit();
+}
+
+void FBVH::Build()
+{
+    FScopeCycleCounter Timer("BuildBVH");
+
+    TArray<UStaticMeshComponent*> SceneComponents;
+    for (UStaticMeshComponent* Comp : TObjectRange<UStaticMeshComponent>())
+        SceneComponents.Add(Comp);
+
+    constexpr int32 BoundsChunkSize = 1024;
+    const int32 NumChunks = (SceneComponents.Num() + BoundsChunkSize - 1) / BoundsChunkSize;
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        const int32 End = FMath::Min(SceneComponents.Num(), (Chunk + 1) * BoundsChunkSize);
+        for (int32 i = Chunk * BoundsChunkSize; i < End; ++i)
+            SceneComponents[i]->UpdateWorldAABB();
+    });
+
+    Build(SceneComponents);
+    FStatRegistry::RegisterResult(Timer);
+}
+
+void FBVH::Build(const TArray<UStaticMeshComponent*>& InComponents)
+{
+    Clear();
+    if (InComponents.IsEmpty()) return;
+
+    TArray<FBVHBuildPrimitive> Primitives;
+    Primitives.SetNum(InComponents.Num());
+    for (int32 i = 0; i < InComponents.Num(); ++i)
+    {
+        const FBoundingBox& AABB = InComponents[i]->WorldAABB;
+        Primitives[i] = {AABB.min, AABB.max, (AABB.min + AABB.max) * 0.5f, i};
+    }
+
+    BuildBVHNodes(Primitives, MaxLeafSize, Nodes);
+
+    // 리프가 연속 구간을 가리키도록 빌드가 끝난 순서대로 컴포넌트를 재배열
+    Components.SetNum(Primitives.Num());
+    for (int32 i = 0; i < Primitives.Num(); ++i)
+    {
+        Components[i] = InComponents[Primitives[i].Index];
+        ComponentSlots.Add(Components[i], i);
+    }
+}
+
+void FBVH::Clear()
+{
+    Nodes.Empty();
+    Components.Empty();
+    ComponentSlots.Empty();
+    PendingComponents.Empty();
+    bBoundsDirty = false;
+}
+
+void FBVH::Refit()
+{
+    // 자식 인덱스가 항상 부모보다 크므로 역순으로 한 번 훑으면 아래에서 위로 갱신됨
+    for (int32 Index = Nodes.Num() - 1; Index >= 0; --Index)
+    {
+        FBVHNode& Node = Nodes[Index];
+        if (Node.IsLeaf())
+        {
+            Node.Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+            Node.Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+            {
+                // 모두 빠진 리프는 뒤집힌 경계로 남아 어떤 레이/질의에도 걸리지 않음
+                if (!Components[i]) continue;
+                Node.Min = FVector::Min(Node.Min, Components[i]->WorldAABB.min);
+                Node.Max = FVector::Max(Node.Max, Components[i]->WorldAABB.max);
+            }
+        }
+        else
+        {
+            const FBVHNode& Left = Nodes[Index + 1];
+            const FBVHNode& Right = Nodes[Node.Offset];
+            Node.Min = FVector::Min(Left.Min, Right.Min);
+            Node.Max = FVector::Max(Left.Max, Right.Max);
+        }
+    }
+    bBoundsDirty = false;
+}
+
+void FBVH::AddComponent(UStaticMeshComponent* Component)
+{
+    if (!Component || ComponentSlots.Contains(Component) || PendingComponents.Contains(Component)) return;
+    PendingComponents.Add(Component);
+}
+
+void FBVH::RemoveComponent(UStaticMeshComponent* Component)
+{
+    if (const int32* Slot = ComponentSlots.Find(Component))
+    {
+        Components[*Slot] = nullptr;
+        ComponentSlots.Remove(Component);
+        bBoundsDirty = true;
+        return;
+    }
+    PendingComponents.Remove(Component);
+}
+
+void FBVH::FlushPendingChanges()
+{
+    if (PendingComponents.IsEmpty())
+    {
+        if (bBoundsDirty) Refit();
+        return;
+    }
+
+    // 남아 있는 컴포넌트와 새 컴포넌트로 다시 빌드. 스폰 직후 한 번만 일어남
+    TArray<UStaticMeshComponent*> AllComponents = PendingComponents;
+    for (UStaticMeshComponent* Comp : AllComponents)
+        Comp->UpdateWorldAABB();
+    for (UStaticMeshComponent* Comp : Components)
+    {
+        if (Comp) AllComponents.Add(Comp);
+    }
+    Build(AllComponents);
+}
+
+UStaticMeshComponent* FBVH::Raycast(const FRay& Ray, float& OutDistance)
+{
+    FlushPendingChanges();
+    if (Nodes.IsEmpty()) return nullptr;
+
+    const FBVHRay BVHRay(Ray.Origin, Ray.Direction);
+
+    FRaycastStats Stats;
+    UStaticMeshComponent* Closest = nullptr;
+    float ClosestDistance = OutDistance;
+
+    TraverseBVH(Nodes, BVHRay.bDirNeg, [&](const FBVHNode& Node)
+    {
+        if (!BVHRay.IntersectNode(Node, ClosestDistance))
+            return false;
+
+        ++Stats.NodesVisited;
+        if (!Node.IsLeaf())
+            return true;
+
+        for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+        {
+            if (!Components[i]) continue;
+            ++Stats.PrimitivesTested;
+            float HitDist = FLT_MAX;
+            if (Components[i]->CheckRayIntersection(Ray.Origin, Ray.Direction, HitDist) && HitDist < ClosestDistance)
+            {
+                ClosestDistance = HitDist;
+                Closest = Components[i];
+            }
+        }
+        return false;
+    });
+
+    FStatRegistry::SetCounter("PickNodesVisited", Stats.NodesVisited);
+    FStatRegistry::SetCounter("PickPrimitivesTested", Stats.PrimitivesTested);
+
+    if (Closest)
+        OutDistance = ClosestDistance;
+    return Closest;
+}
+
+int32 FBVH::FindNearest(const FVector& Point, int32 K, FNearestComponent* OutResults, float MaxDistance)
+{
+    FNearestCollector Collector(OutResults, K, MaxDistance);
+    FlushPendingChanges();
+    if (Nodes.IsEmpty() || K <= 0) return 0;
+
+    FRaycastStats Stats;
+
+    // 가장 가까운 노드부터 꺼냄. 큐 저장 공간은 스택 배열
+    using FNodeEntry = TNearestNodeEntry<uint32>;
+    constexpr int32 MaxQueue = 256;
+    FNodeEntry QueueData[MaxQueue];
+    TBoundedHeap<FNodeEntry, std::greater<>> Queue(QueueData, MaxQueue);
+    Queue.Push({0, PointToAABBDistanceSquared(Point, Nodes[0].Min, Nodes[0].Max)});
+
+    while (!Queue.IsEmpty())
+    {
+        const FNodeEntry Entry = Queue.Pop();
+        // 큐에 남은 노드는 모두 이보다 멀다
+        if (Entry.DistanceSquared > Collector.GetBoundSquared())
+            break;
+
+        ++Stats.NodesVisited;
+        const FBVHNode& Node = Nodes[Entry.Node];
+        if (Node.IsLeaf())
+        {
+            for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+            {
+                if (!Components[i]) continue;
+                ++Stats.PrimitivesTested;
+                const FBoundingBox& AABB = Components[i]->WorldAABB;
+                Collector.Add(Components[i], PointToAABBDistanceSquared(Point, AABB.min, AABB.max), false);
+            }
+            continue;
+        }
+
+        const uint32 Children[2] = {Entry.Node + 1, Node.Offset};
+        for (const uint32 Child : Children)
+        {
+            const float ChildDistance = PointToAABBDistanceSquared(Point, Nodes[Child].Min, Nodes[Child].Max);
+            if (ChildDistance > Collector.GetBoundSquared())
+                continue;
+            if (!Queue.Push({Child, ChildDistance}))
+                FindNearestRecursive(Child, Point, Collector, Stats);
+        }
+    }
+
+    FStatRegistry::SetCounter("NearestNodesVisited", Stats.NodesVisited);
+    FStatRegistry::SetCounter("NearestPrimitivesTested", Stats.PrimitivesTested);
+    return Collector.Finish();
+}
+
+void FBVH::FindNearestRecursive(uint32 NodeIndex, const FVector& Point, FNearestCollector& Collector, FRaycastStats& Stats) const
+{
+    ++Stats.NodesVisited;
+    const FBVHNode& Node = Nodes[NodeIndex];
+    if (Node.IsLeaf())
+    {
+        for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+        {
+            if (!Components[i]) continue;
+            ++Stats.PrimitivesTested;
+            const FBoundingBox& AABB = Components[i]->WorldAABB;
+            Collector.Add(Components[i], PointToAABBDistanceSquared(Point, AABB.min, AABB.max), false);
+        }
+        return;
+    }
+
+    // 가까운 자식 먼저. 먼 자식은 그 사이 줄어든 경계로 다시 검사
+    uint32 Near = NodeIndex + 1, Far = Node.Offset;
+    float NearDistance = PointToAABBDistanceSquared(Point, Nodes[Near].Min, Nodes[Near].Max);
+    float FarDistance = PointToAABBDistanceSquared(Point, Nodes[Far].Min, Nodes[Far].Max);
+    if (FarDistance < NearDistance)
+    {
+        std::swap(Near, Far);
+        std::swap(NearDistance, FarDistance);
+    }
+    if (NearDistance <= Collector.GetBoundSquared())
+        FindNearestRecursive(Near, Point, Collector, Stats);
+    if (FarDistance <= Collector.GetBoundSquared())
+        FindNearestRecursive(Far, Point, Collector, Stats);
+}
+
+void FBVH::RaycastPacket(const FRay* Rays, int32 NumRays, UStaticMeshComponent** OutHits, float* InOutDistances)
+{
+    for (int32 i = 0; i < NumRays; ++i)
+        OutHits[i] = nullptr;
+    FlushPendingChanges();
+    if (Nodes.IsEmpty()) return;
+
+    FRaycastStats Stats;
+    for (int32 First = 0; First < NumRays; First += PacketSize)
+    {
+        const int32 Count = FMath::Min(PacketSize, NumRays - First);
+        TracePacket(Rays + First, Count, OutHits + First, InOutDistances + First, Stats);
+    }
+
+    FStatRegistry::SetCounter("PickPacketNodesVisited", Stats.NodesVisited);
+    FStatRegistry::SetCounter("PickPacketPrimitivesTested", Stats.PrimitivesTested);
+}
+
+void FBVH::TracePacket(const FRay* Rays, int32 Count, UStaticMeshComponent** OutHits, float* InOutDistances, FRaycastStats& Stats) const
+{
+    // 레인별 SoA. 빈 레인은 최단 거리를 음수로 두어 어떤 노드와도 교차하지 않게 함
+    alignas(16) float OriginX[PacketSize], OriginY[PacketSize], OriginZ[PacketSize];
+    alignas(16) float InvDirX[PacketSize], InvDirY[PacketSize], InvDirZ[PacketSize];
+    alignas(16) float ClosestDistance[PacketSize];
+    int32 SignVotes[3] = {0, 0, 0};
+    for (int32 Lane = 0; Lane < PacketSize; ++Lane)
+    {
+        const bool bValid = Lane < Count;
+        const FRay& Ray = Rays[bValid ? Lane : Count - 1];
+        const FBVHRay BVHRay(Ray.Origin, Ray.Direction);
+        OriginX[Lane] = BVHRay.Origin[0];
+        OriginY[Lane] = BVHRay.Origin[1];
+        OriginZ[Lane] = BVHRay.Origin[2];
+        InvDirX[Lane] = BVHRay.InvDir[0];
+        InvDirY[Lane] = BVHRay.InvDir[1];
+        InvDirZ[Lane] = BVHRay.InvDir[2];
+        ClosestDistance[Lane] = bValid ? InOutDistances[Lane] : -1.0f;
+        if (!bValid) continue;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+            SignVotes[Axis] += BVHRay.bDirNeg[Axis] ? 1 : -1;
+    }
+
+    // 자식 방문 순서는 레인 방향의 다수결. 일관된 패킷이면 모든 레인에 대해 가까운 쪽이 먼저
+    const bool bDirNeg[3] = {SignVotes[0] > 0, SignVotes[1] > 0, SignVotes[2] > 0};
+
+#if USE_SIMD
+    const __m128 OX = _mm_load_ps(OriginX), OY = _mm_load_ps(OriginY), OZ = _mm_load_ps(OriginZ);
+    const __m128 IX = _mm_load_ps(InvDirX), IY = _mm_load_ps(InvDirY), IZ = _mm_load_ps(InvDirZ);
+#endif
+
+    TraverseBVH(Nodes, bDirNeg, [&](const FBVHNode& Node)
+    {
+        // 네 레인 슬랩 테스트. 레인마다 자기 최단 거리로 tMax를 시작
+#if USE_SIMD
+        __m128 tMin = _mm_setzero_ps();
+        __m128 tMax = _mm_load_ps(ClosestDistance);
+        {
+            const __m128 T1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Min.x), OX), IX);
+            const __m128 T2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Max.x), OX), IX);
+            tMin = _mm_max_ps(tMin, _mm_min_ps(T1, T2));
+            tMax = _mm_min_ps(tMax, _mm_max_ps(T1, T2));
+        }
+        {
+            const __m128 T1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Min.y), OY), IY);
+            const __m128 T2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Max.y), OY), IY);
+            tMin = _mm_max_ps(tMin, _mm_min_ps(T1, T2));
+            tMax = _mm_min_ps(tMax, _mm_max_ps(T1, T2));
+        }
+        {
+            const __m128 T1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Min.z), OZ), IZ);
+            const __m128 T2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.Max.z), OZ), IZ);
+            tMin = _mm_max_ps(tMin, _mm_min_ps(T1, T2));
+            tMax = _mm_min_ps(tMax, _mm_max_ps(T1, T2));
+        }
+        const int32 ActiveMask = _mm_movemask_ps(_mm_cmple_ps(tMin, tMax));
+#else
+        int32 ActiveMask = 0;
+        for (int32 Lane = 0; Lane < PacketSize; ++Lane)
+        {
+            const float Origin[3] = {OriginX[Lane], OriginY[Lane], OriginZ[Lane]};
+            const float InvDir[3] = {InvDirX[Lane], InvDirY[Lane], InvDirZ[Lane]};
+            const float NodeMin[3] = {Node.Min.x, Node.Min.y, Node.Min.z};
+            const float NodeMax[3] = {Node.Max.x, Node.Max.y, Node.Max.z};
+            float tMin = 0.0f;
+            float tMax = ClosestDistance[Lane];
+            for (int32 i = 0; i < 3; ++i)
+            {
+                const float T1 = (NodeMin[i] - Origin[i]) * InvDir[i];
+                const float T2 = (NodeMax[i] - Origin[i]) * InvDir[i];
+                tMin = FMath::Max(tMin, FMath::Min(T1, T2));
+                tMax = FMath::Min(tMax, FMath::Max(T1, T2));
+            }
+            if (tMin <= tMax)
+                ActiveMask |= 1 << Lane;
+        }
+#endif
+        if (ActiveMask == 0)
+            return false;
+
+        ++Stats.NodesVisited;
+        if (!Node.IsLeaf())
+            return true;
+
+        // 컴포넌트 교차는 노드에 들어온 레인만 개별 검사
+        for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+        {
+            if (!Components[i]) continue;
+            for (int32 Lane = 0; Lane < Count; ++Lane)
+            {
+                if (!(ActiveMask & (1 << Lane))) continue;
+
+                ++Stats.PrimitivesTested;
+                float HitDist = FLT_MAX;
+                if (Components[i]->CheckRayIntersection(Rays[Lane].Origin, Rays[Lane].Direction, HitDist) && HitDist < ClosestDistance[Lane])
+                {
+                    ClosestDistance[Lane] = HitDist;
+                    OutHits[Lane] = Components[i];
+                }
+            }
+        }
+        return false;
+    });
+
+    for (int32 Lane = 0; Lane < Count; ++Lane)
+    {
+        if (OutHits[Lane])
+            InOutDistances[Lane] = ClosestDistance[Lane];
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "Define.h"
+#include "Container/Map.h"
+#include "Math/MathUtility.h"
+#include "NearestQuery.h"
+
+struct FRay;
+struct FRaycastStats;
+class UStaticMeshComponent;
+
+// 깊이 우선으로 펼친 BVH 노드 (32바이트).
+// 내부 노드의 왼쪽 자식은 항상 바로 다음 인덱스, 오른쪽 자식은 Offset
+struct FBVHNode
+{
+    FVector Min;
+    uint32 Offset = 0;  // 리프: Components 시작 인덱스, 내부: 오른쪽 자식 노드 인덱스
+    FVector Max;
+    uint16 Count = 0;   // 리프의 컴포넌트 수. 0이면 내부 노드
+    uint8 Axis = 0;     // 분할 축. 레이 방향 부호로 가까운 자식을 먼저 방문
+    uint8 Pad = 0;
+
+    bool IsLeaf() const { return Count > 0; }
+};
+
+struct FBVHBuildPrimitive
+{
+    FVector Min;
+    FVector Max;
+    FVector Centroid;
+    int32 Index;    // 원래 배열에서의 인덱스
+};
+
+//Binned SAH로 OutNodes를 채움. Primitives는 리프 순서로 재배열되며 리프의 Offset/Count는 재배열된 Primitives 구간.
+//bSplitByCost가 false면 MaxLeafSize 이하가 되는 즉시 리프로 만듦 (하위 트리 단위로 묶는 상위 분할용)
+void BuildBVHNodes(TArray<FBVHBuildPrimitive>& Primitives, int32 MaxLeafSize, TArray<FBVHNode>& OutNodes, bool bSplitByCost = true);
+
+// 깊이 우선 순회 스택. 보통은 고정 배열로 충분하고, 더 깊은 트리(Binned SAH는 깊이 상한이 없음)에서는
+// 넘친 부분을 힙 배열에 쌓아 서브트리를 버리지 않는다
+class FBVHTraversalStack
+{
+public:
+    void Push(uint32 Index)
+    {
+        if (Size < InlineCapacity)
+            Inline[Size] = Index;
+        else if (Size - InlineCapacity < Overflow.Num())
+            Overflow[Size - InlineCapacity] = Index;
+        else
+            Overflow.Add(Index);
+        ++Size;
+    }
+
+    uint32 Pop()
+    {
+        --Size;
+        return Size < InlineCapacity ? Inline[Size] : Overflow[Size - InlineCapacity];
+    }
+
+    bool IsEmpty() const { return Size == 0; }
+
+private:
+    static constexpr int32 InlineCapacity = 128;
+    uint32 Inline[InlineCapacity];
+    TArray<uint32> Overflow;
+    int32 Size = 0;
+};
+
+inline uint32 GetBVHRightChild(const FBVHNode& Node) { return Node.Offset; }
+inline int32 GetBVHSplitAxis(const FBVHNode& Node) { return Node.Axis; }
+
+// 깊이 우선으로 펼친 트리(왼쪽 자식 = Index + 1)를 레이 방향 쪽 자식부터 순회.
+// VisitNode(Node)는 경계 검사와 리프 처리를 맡고, 자식으로 내려가야 하는 내부 노드일 때만 true.
+// 노드 타입마다 GetBVHRightChild/GetBVHSplitAxis 오버로드가 필요
+template <typename NodeType, typename VisitNodeFunc>
+void TraverseBVH(const TArray<NodeType>& Nodes, const bool bDirNeg[3], VisitNodeFunc&& VisitNode)
+{
+    if (Nodes.IsEmpty()) return;
+
+    FBVHTraversalStack Stack;
+    Stack.Push(0);
+    while (!Stack.IsEmpty())
+    {
+        const uint32 Index = Stack.Pop();
+        const NodeType& Node = Nodes[Index];
+        if (!VisitNode(Node))
+            continue;
+
+        // 가까운 자식을 나중에 push해서 먼저 꺼냄
+        const uint32 RightChild = static_cast<uint32>(GetBVHRightChild(Node));
+        if (bDirNeg[GetBVHSplitAxis(Node)])
+        {
+            Stack.Push(Index + 1);
+            Stack.Push(RightChild);
+        }
+        else
+        {
+            Stack.Push(RightChild);
+            Stack.Push(Index + 1);
+        }
+    }
+}
+
+// 순회용 레이. 역방향/부호를 미리 구해 두고 노드마다 나눗셈 없이 슬랩 테스트
+struct FBVHRay
+{
+    float Origin[3];
+    float InvDir[3];
+    bool bDirNeg[3];
+
+    FBVHRay(const FVector& InOrigin, const FVector& InDirection)
+    {
+        const float Dir[3] = {InDirection.x, InDirection.y, InDirection.z};
+        Origin[0] = InOrigin.x;
+        Origin[1] = InOrigin.y;
+        Origin[2] = InOrigin.z;
+        for (int32 i = 0; i < 3; ++i)
+        {
+            // 축에 평행한 레이도 같은 슬랩 공식으로 처리되도록 아주 작은 값으로 대체
+            const float SafeDir = FMath::Abs(Dir[i]) < 1e-8f ? (Dir[i] < 0.0f ? -1e-8f : 1e-8f) : Dir[i];
+            InvDir[i] = 1.0f / SafeDir;
+            bDirNeg[i] = InvDir[i] < 0.0f;
+        }
+    }
+
+    //tMax를 MaxDistance로 시작해 그보다 먼 노드는 바로 버림
+    bool IntersectNode(const FBVHNode& Node, float MaxDistance) const
+    {
+        const float NodeMin[3] = {Node.Min.x, Node.Min.y, Node.Min.z};
+        const float NodeMax[3] = {Node.Max.x, Node.Max.y, Node.Max.z};
+        float tMin = 0.0f;
+        float tMax = MaxDistance;
+        for (int32 i = 0; i < 3; ++i)
+        {
+            const float Near = ((bDirNeg[i] ? NodeMax[i] : NodeMin[i]) - Origin[i]) * InvDir[i];
+            const float Far = ((bDirNeg[i] ? NodeMin[i] : NodeMax[i]) - Origin[i]) * InvDir[i];
+            tMin = FMath::Max(tMin, Near);
+            tMax = FMath::Min(tMax, Far);
+        }
+        return tMin <= tMax;
+    }
+};
+
+// Binned SAH로 만든 피킹용 BVH. FKDTree(중앙값 분할, 컴포넌트당 리프, 양쪽 자식 모두 방문)를 대체.
+// 가까운 자식부터 방문하고 이미 찾은 교차보다 먼 노드는 건너뛴다.
+class FBVH
+{
+public:
+    static constexpr int32 MaxLeafSize = 4;
+    static constexpr int32 PacketSize = 4;
+
+    //월드의 모든 StaticMeshComponent로 다시 빌드
+    void Build();
+    void Build(const TArray<UStaticMeshComponent*>& InComponents);
+    void Clear();
+
+    //컴포넌트가 움직였을 때 호출. 다음 Raycast 전에 트리 구조는 그대로 두고 경계만 다시 계산
+    void MarkDirty() { bBoundsDirty = true; }
+    //새로 스폰된 컴포넌트. 모아 두었다가 다음 질의 전에 한 번 다시 빌드 (이미 있으면 무시)
+    void AddComponent(UStaticMeshComponent* Component);
+    //파괴되는 컴포넌트를 뺌. 리프 칸은 nullptr로 비우고 다음 질의 전에 Refit
+    void RemoveComponent(UStaticMeshComponent* Component);
+    void Refit();
+
+    //OutDistance보다 가까운 교차 중 가장 가까운 컴포넌트 반환. 방문 비용은 FOctree::Raycast와 같은 카운터로 기록
+    UStaticMeshComponent* Raycast(const FRay& Ray, float& OutDistance);
+    //이웃한 레이 PacketSize개씩 묶어 순회 스택을 공유하고 노드 경계는 SIMD로 한 번에 검사.
+    //InOutDistances[i]보다 가까운 교차가 있으면 OutHits[i]/InOutDistances[i] 갱신 (없으면 OutHits[i] = nullptr)
+    void RaycastPacket(const FRay* Rays, int32 NumRays, UStaticMeshComponent** OutHits, float* InOutDistances);
+
+    //Point에서 WorldAABB까지 가까운 순으로 최대 K개를 OutResults(K개 이상)에 채우고 개수 반환.
+    //MaxDistance를 주면 반경 질의. 가까운 노드부터 꺼내는 최선 우선 탐색이며 힙 할당 없음
+    int32 FindNearest(const FVector& Point, int32 K, FNearestComponent* OutResults, float MaxDistance = FLT_MAX);
+
+    int32 GetNumNodes() const { return Nodes.Num(); }
+    int32 GetNumComponents() const { return Components.Num(); }
+
+private:
+    //질의 전에 호출. 추가 대기 중인 컴포넌트가 있으면 다시 빌드하고, 아니면 경계가 바뀐 경우만 Refit
+    void FlushPendingChanges();
+    void TracePacket(const FRay* Rays, int32 Count, UStaticMeshComponent** OutHits, float* InOutDistances, FRaycastStats& Stats) const;
+    //FindNearest의 노드 큐가 가득 찼을 때 그 서브트리를 깊이 우선으로 처리
+    void FindNearestRecursive(uint32 NodeIndex, const FVector& Point, FNearestCollector& Collector, FRaycastStats& Stats) const;
+
+    TArray<FBVHNode> Nodes;
+    TArray<UStaticMeshComponent*> Components; // 리프 순서로 정렬됨. RemoveComponent로 뺀 칸은 nullptr
+    TMap<UStaticMeshComponent*, int32> ComponentSlots; // 컴포넌트 -> Components 인덱스
+    TArray<UStaticMeshComponent*> PendingComponents;   // 아직 트리에 없는 새 컴포넌트
+    bool bBoundsDirty = false;
+};
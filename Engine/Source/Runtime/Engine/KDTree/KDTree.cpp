@@ -1,119 +1,103 @@
 #include "KDTree.h"
 
-#include "Components/MeshComponent.h"
-#include "Components/PrimitiveComponent.h"
+#include <algorithm>
+
+#include "BVH.h"
 #include "Components/StaticMeshComponent.h"
 #include "Math/Ray.h"
-#include "UObject/Casts.h"
-#include "UObject/UObjectIterator.h"
+
 FKDTree::FKDTree()
 {
-    Root = nullptr;
 }
+
 FKDTree::~FKDTree()
 {
-	delete Root;
 }
 
-FKDTreeNode::~FKDTreeNode()
+void FKDTree::Build()
 {
-	delete Left;
-	delete Right;
+    Build(PendingComponents);
 }
 
-void FKDTree::Build()
+void FKDTree::Clear()
 {
-	if (!PendingComponents.IsEmpty())
-	{
-		Root = new FKDTreeNode();
-		Root->Build(PendingComponents);
-	}
+    Nodes.Empty();
 }
 
-static bool CompareAxis(UStaticMeshComponent* A, UStaticMeshComponent* B, EKDAxis Axis)
+void FKDTree::Build(const TArray<UStaticMeshComponent*>& InComponents)
 {
-	return A->WorldAABB.GetCenter()[static_cast<int>(Axis)] <
-		   B->WorldAABB.GetCenter()[static_cast<int>(Axis)];
+    Clear();
+
+    // 중심점을 한 번만 계산해 두고 이 배열만 제자리에서 나눔. 레벨마다 정렬/복사하지 않음
+    TArray<FBuildItem> Items;
+    Items.Reserve(InComponents.Num());
+    for (UStaticMeshComponent* Comp : InComponents)
+    {
+        if (Comp)
+            Items.Add({Comp->WorldAABB.GetCenter(), Comp});
+    }
+    if (Items.IsEmpty()) return;
+
+    // 리프가 컴포넌트 하나씩이므로 노드 수는 정확히 2N-1
+    Nodes.Reserve(Items.Num() * 2 - 1);
+    BuildRecursive(Items.GetData(), Items.Num(), 0);
 }
-void FKDTreeNode::Build(TArray<UStaticMeshComponent*>& InComponents, int Depth)
+
+int32 FKDTree::BuildRecursive(FBuildItem* Items, int32 Count, int32 Depth)
 {
-	if (InComponents.Num() == 1)
-	{
-		Component = InComponents[0];
-		Bounds = Component->WorldAABB;
-		bIsLeaf = true;
-		return;
-	}
-
-	SplitAxis = static_cast<EKDAxis>(Depth % 3);
-    InComponents.Sort([this](UStaticMeshComponent* A, UStaticMeshComponent* B) {
-        return CompareAxis(A, B, SplitAxis);
+    // Add로 재할당될 수 있으므로 노드는 끝까지 인덱스로만 접근
+    const int32 NodeIndex = Nodes.Add(FKDTreeNode());
+    if (Count == 1)
+    {
+        Nodes[NodeIndex].Component = Items[0].Component;
+        Nodes[NodeIndex].Bounds = Items[0].Component->WorldAABB;
+        return NodeIndex;
+    }
+
+    // 중앙값만 필요하므로 전체 정렬 대신 선택. 앞쪽 Mid개가 중앙값 이하
+    const int32 Axis = Depth % 3;
+    const int32 Mid = Count / 2;
+    std::nth_element(Items, Items + Mid, Items + Count, [Axis](const FBuildItem& A, const FBuildItem& B)
+    {
+        return A.Center[Axis] < B.Center[Axis];
     });
-	int Mid = InComponents.Num() / 2;
-    TArray<UStaticMeshComponent*> LeftComps  = Slice(InComponents, 0, Mid);                     // 0 ~ Mid-1
-    TArray<UStaticMeshComponent*> RightComps = Slice(InComponents, Mid, InComponents.Num() - Mid); // Mid ~ End
-    
-	Left = new FKDTreeNode();
-	Left->Build(LeftComps, Depth + 1);
+    Nodes[NodeIndex].SplitAxis = static_cast<EKDAxis>(Axis);
+    Nodes[NodeIndex].SplitValue = Items[Mid].Center[Axis];
 
-	Right = new FKDTreeNode();
-	Right->Build(RightComps, Depth + 1);
+    BuildRecursive(Items, Mid, Depth + 1); // 왼쪽 자식은 항상 NodeIndex + 1
+    const int32 RightChild = BuildRecursive(Items + Mid, Count - Mid, Depth + 1);
 
-    Bounds = FBoundingBox::Union(Right->Bounds, Left->Bounds);
+    Nodes[NodeIndex].RightChild = RightChild;
+    Nodes[NodeIndex].Bounds = FBoundingBox::Union(Nodes[NodeIndex + 1].Bounds, Nodes[RightChild].Bounds);
+    return NodeIndex;
 }
 
 UStaticMeshComponent* FKDTree::Raycast(const FRay& Ray, float& OutDistance) const
 {
-	if (!Root) return nullptr;
-	return Root->Raycast(Ray, OutDistance);
-}
+    if (Nodes.IsEmpty()) return nullptr;
 
-UStaticMeshComponent* FKDTreeNode::Raycast(const FRay& Ray, float& OutDistance) const
-{
-	float NodeHitDist;
-	if (!RayIntersectsAABB(Ray, Bounds, NodeHitDist))
-		return nullptr;
-
-	if (bIsLeaf)
-	{
-		float HitDist = 0;
-		if (Component->CheckRayIntersection(Ray.Origin, Ray.Direction, HitDist))
-		{
-			OutDistance = HitDist; 
-			return Component;
-		}
-		return nullptr;
-	}
-
-	UStaticMeshComponent* HitA = nullptr;
-	UStaticMeshComponent* HitB = nullptr;
-	float DistA = FLT_MAX, DistB = FLT_MAX;
-
-	if (Left)  HitA = Left->Raycast(Ray, DistA);
-	if (Right) HitB = Right->Raycast(Ray, DistB);
-
-	if (HitA && HitB)
-	{
-		if (DistA < DistB)
-		{
-			OutDistance = DistA;
-			return HitA;
-		}
-		else
-		{
-			OutDistance = DistB;
-			return HitB;
-		}
-	}
-	else if (HitA)
-	{
-		OutDistance = DistA;
-		return HitA;
-	}
-	else if (HitB)
-	{
-		OutDistance = DistB;
-		return HitB;
-	}
-	return nullptr;
+    UStaticMeshComponent* Closest = nullptr;
+    float ClosestDistance = FLT_MAX;
+
+    const bool bDirNeg[3] = {Ray.Direction.x < 0.0f, Ray.Direction.y < 0.0f, Ray.Direction.z < 0.0f};
+    TraverseBVH(Nodes, bDirNeg, [&](const FKDTreeNode& Node)
+    {
+        float NodeHitDist;
+        if (!RayIntersectsAABB(Ray, Node.Bounds, NodeHitDist) || NodeHitDist > ClosestDistance)
+            return false;
+        if (!Node.IsLeaf())
+            return true;
+
+        float HitDist = FLT_MAX;
+        if (Node.Component->CheckRayIntersection(Ray.Origin, Ray.Direction, HitDist) && HitDist < ClosestDistance)
+        {
+            ClosestDistance = HitDist;
+            Closest = Node.Component;
+        }
+        return false;
+    });
+
+    if (Closest)
+        OutDistance = ClosestDistance;
+    return Closest;
 }
@@ -12,27 +12,24 @@ enum class EKDAxis : uint8
     Z = 2
 };
 
-class FKDTreeNode
+// FKDTree의 노드 풀에 깊이 우선으로 연속 저장. 왼쪽 자식은 항상 바로 다음 인덱스
+struct FKDTreeNode
 {
-public:
     FBoundingBox Bounds;
-    UStaticMeshComponent* Component = nullptr;
+    UStaticMeshComponent* Component = nullptr; // 리프일 때만
+    int32 RightChild = -1;                     // 내부 노드일 때만
     EKDAxis SplitAxis = EKDAxis::X;
-    float SplitValue = 0.0f;
-
-    FKDTreeNode* Left = nullptr;
-    FKDTreeNode* Right = nullptr;
-
-    bool bIsLeaf = false;
+    float SplitValue = 0.0f;                   // 분할 축의 중앙값 (중심점 기준)
 
-    FKDTreeNode() = default;
-    ~FKDTreeNode();
-
-    void Build(TArray<UStaticMeshComponent*>& InComponents, int Depth = 0);
-    UStaticMeshComponent* Raycast(const FRay& Ray, float& OutDistance) const;
-    
+    bool IsLeaf() const { return Component != nullptr; }
 };
 
+// TraverseBVH(BVH.h)에서 쓰는 자식/분할 축 접근
+inline uint32 GetBVHRightChild(const FKDTreeNode& Node) { return static_cast<uint32>(Node.RightChild); }
+inline int32 GetBVHSplitAxis(const FKDTreeNode& Node) { return static_cast<int32>(Node.SplitAxis); }
+
+// 컴포넌트당 리프 하나인 중앙값 분할 KD 트리.
+// 빌드는 작업 배열 하나를 nth_element로 제자리 분할하고 노드는 한 배열(풀)에 연속으로 저장
 class FKDTree
 {
 public:
@@ -40,9 +37,24 @@ public:
     ~FKDTree();
     TArray<UStaticMeshComponent*> PendingComponents; // 각 SubTree에 의해 분배된 컴포넌트
 
+    //PendingComponents로 빌드. 다시 호출하면 이전 트리를 버리고 새로 빌드
     void Build();
+    void Build(const TArray<UStaticMeshComponent*>& InComponents);
+    void Clear();
+    bool IsEmpty() const { return Nodes.IsEmpty(); }
+    int32 GetNumNodes() const { return Nodes.Num(); }
+
+    //가까운 자식부터 방문하고 지금까지 찾은 교차보다 먼 노드는 건너뜀
     UStaticMeshComponent* Raycast(const FRay& Ray, float& OutDistance) const;
 
 private:
-    FKDTreeNode* Root = nullptr;
+    struct FBuildItem
+    {
+        FVector Center;
+        UStaticMeshComponent* Component;
+    };
+
+    int32 BuildRecursive(FBuildItem* Items, int32 Count, int32 Depth);
+
+    TArray<FKDTreeNode> Nodes;
 };
@@ -2,85 +2,153 @@
 #include "UObject/UObjectIterator.h"
 #include "Components/StaticMeshComponent.h"
 #include "Math/Ray.h"
+#include "Profiling/PlatformTime.h"
+#include "Profiling/StatRegistry.h"
 #include "UObject/Casts.h"
 
 FKDTreeSystem::FKDTreeSystem()
 {
-    for (int i = 0; i < TreeCount; ++i)
-        Trees[i] = nullptr;
 }
 
 FKDTreeSystem::~FKDTreeSystem()
 {
-    for (int i = 0; i < TreeCount; ++i)
-        delete Trees[i];
+    Clear();
 }
 
-void FKDTreeSystem::Build(const FBoundingBox& RootBounds)
+void FKDTreeSystem::Clear()
 {
-    FVector Center = (RootBounds.min + RootBounds.max) * 0.5f;
+    for (FSubtree& Subtree : Subtrees)
+        delete Subtree.Tree;
+    Subtrees.Empty();
+    TopNodes.Empty();
+    ComponentSubtrees.Empty();
+    bHasDirtySubtrees = false;
+}
+
+void FKDTreeSystem::Build()
+{
+    FScopeCycleCounter Timer("BuildKDTreeSystem");
+    Clear();
 
-    // 8분할 BoundingBox 생성
-    for (int i = 0; i < TreeCount; ++i)
+    TArray<UStaticMeshComponent*> SceneComponents;
+    for (UStaticMeshComponent* Comp : TObjectRange<UStaticMeshComponent>())
     {
-        FVector Min{
-            (i & 1) ? Center.x : RootBounds.min.x,
-            (i & 2) ? Center.y : RootBounds.min.y,
-            (i & 4) ? Center.z : RootBounds.min.z
-        };
-        FVector Max{
-            (i & 1) ? RootBounds.max.x : Center.x,
-            (i & 2) ? RootBounds.max.y : Center.y,
-            (i & 4) ? RootBounds.max.z : Center.z
-        };
-        SubBounds[i] = FBoundingBox(Min, Max);
-        Trees[i] = new FKDTree();
+        Comp->UpdateWorldAABB();
+        SceneComponents.Add(Comp);
     }
+    if (SceneComponents.IsEmpty()) return;
 
-    // 컴포넌트 분배
-    for (USceneComponent* SceneComp : TObjectRange<USceneComponent>())
+    // 고정 8분할 대신 SAH로 SubtreeSize개 이하 묶음을 만들어 한쪽에 몰린 장면에서도 하위 트리 크기가 고르게
+    TArray<FBVHBuildPrimitive> Primitives;
+    Primitives.SetNum(SceneComponents.Num());
+    for (int32 i = 0; i < SceneComponents.Num(); ++i)
     {
-        UStaticMeshComponent* Comp = Cast<UStaticMeshComponent>(SceneComp);
-        if (!Comp) continue;
+        const FBoundingBox& AABB = SceneComponents[i]->WorldAABB;
+        Primitives[i] = {AABB.min, AABB.max, (AABB.min + AABB.max) * 0.5f, i};
+    }
+    BuildBVHNodes(Primitives, SubtreeSize, TopNodes, false);
 
-        Comp->UpdateWorldAABB();
+    for (FBVHNode& Node : TopNodes)
+    {
+        if (!Node.IsLeaf()) continue;
 
-        for (int i = 0; i < 8; ++i)
+        const int32 SubtreeIndex = Subtrees.Num();
+        FSubtree& Subtree = Subtrees[Subtrees.Add(FSubtree())];
+        Subtree.Tree = new FKDTree();
+        for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
         {
-            if (SubBounds[i].Contains(Comp->WorldAABB.GetCenter()))
-            {
-                Trees[i]->PendingComponents.Add(Comp);
-                break;
-            }
+            UStaticMeshComponent* Comp = SceneComponents[Primitives[i].Index];
+            Subtree.Tree->PendingComponents.Add(Comp);
+            ComponentSubtrees[Comp] = SubtreeIndex;
         }
+        Subtree.Tree->Build();
+        Node.Offset = static_cast<uint32>(SubtreeIndex);
     }
+    FStatRegistry::RegisterResult(Timer);
+}
+
+void FKDTreeSystem::UpdateComponent(UStaticMeshComponent* Component)
+{
+    const int32* SubtreeIndex = ComponentSubtrees.Find(Component);
+    if (!SubtreeIndex) return;
+
+    Subtrees[*SubtreeIndex].bDirty = true;
+    bHasDirtySubtrees = true;
+}
 
-    // 트리 빌드
-    for (int i = 0; i < 8; ++i)
+void FKDTreeSystem::RemoveComponent(UStaticMeshComponent* Component)
+{
+    const int32* SubtreeIndex = ComponentSubtrees.Find(Component);
+    if (!SubtreeIndex) return;
+
+    FSubtree& Subtree = Subtrees[*SubtreeIndex];
+    Subtree.Tree->PendingComponents.Remove(Component);
+    Subtree.bDirty = true;
+    bHasDirtySubtrees = true;
+    ComponentSubtrees.Remove(Component);
+}
+
+void FKDTreeSystem::FlushDirtySubtrees()
+{
+    // 자식 인덱스가 항상 부모보다 크므로 역순으로 한 번 훑으면 아래에서 위로 갱신됨
+    for (int32 Index = TopNodes.Num() - 1; Index >= 0; --Index)
     {
-        Trees[i]->Build();
+        FBVHNode& Node = TopNodes[Index];
+        if (Node.IsLeaf())
+        {
+            FSubtree& Subtree = Subtrees[Node.Offset];
+            if (!Subtree.bDirty) continue;
+
+            Node.Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+            Node.Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for (UStaticMeshComponent* Comp : Subtree.Tree->PendingComponents)
+            {
+                Node.Min = FVector::Min(Node.Min, Comp->WorldAABB.min);
+                Node.Max = FVector::Max(Node.Max, Comp->WorldAABB.max);
+            }
+            Subtree.Tree->Build();
+            Subtree.bDirty = false;
+        }
+        else
+        {
+            const FBVHNode& Left = TopNodes[Index + 1];
+            const FBVHNode& Right = TopNodes[Node.Offset];
+            Node.Min = FVector::Min(Left.Min, Right.Min);
+            Node.Max = FVector::Max(Left.Max, Right.Max);
+        }
     }
+    bHasDirtySubtrees = false;
 }
 
-UStaticMeshComponent* FKDTreeSystem::Raycast(const FRay& Ray, float& OutDistance) const
+UStaticMeshComponent* FKDTreeSystem::Raycast(const FRay& Ray, float& OutDistance)
 {
+    if (TopNodes.IsEmpty()) return nullptr;
+    if (bHasDirtySubtrees) FlushDirtySubtrees();
+
+    const FBVHRay BVHRay(Ray.Origin, Ray.Direction);
     UStaticMeshComponent* Closest = nullptr;
-    float MinDistance = FLT_MAX;
+    float ClosestDistance = OutDistance;
 
-    for (int i = 0; i < TreeCount; ++i)
+    // 하위 트리 경계가 서로 겹칠 수 있으므로 하나만 고르지 않고 걸치는 하위 트리를 가까운 쪽부터 모두 검사.
+    // 지금까지 찾은 교차보다 먼 노드는 IntersectNode에서 걸러짐
+    TraverseBVH(TopNodes, BVHRay.bDirNeg, [&](const FBVHNode& Node)
     {
-        float Dist;
-        if (!RayIntersectsAABB(Ray, SubBounds[i], Dist))
-            continue;
+        if (!BVHRay.IntersectNode(Node, ClosestDistance))
+            return false;
+        if (!Node.IsLeaf())
+            return true;
 
-        UStaticMeshComponent* Hit = Trees[i]->Raycast(Ray, Dist);
-        if (Hit && Dist < MinDistance)
+        float HitDist = FLT_MAX;
+        UStaticMeshComponent* Hit = Subtrees[Node.Offset].Tree->Raycast(Ray, HitDist);
+        if (Hit && HitDist < ClosestDistance)
         {
+            ClosestDistance = HitDist;
             Closest = Hit;
-            MinDistance = Dist;
         }
-    }
+        return false;
+    });
 
-    OutDistance = MinDistance;
+    if (Closest)
+        OutDistance = ClosestDistance;
     return Closest;
 }
@@ -1,20 +1,42 @@
 #pragma once
 
+#include "BVH.h"
 #include "KDTree.h"
+#include "Container/Map.h"
 
+// 컴포넌트들을 SubtreeSize개 이하의 묶음으로 나눈 상위 BVH(TLAS). 각 리프가 FKDTree 하나를 가짐.
+// 묶음은 Binned SAH로 장면 분포에 맞게 나뉘고, 레이는 걸치는 하위 트리를 가까운 순으로 모두 순회
 class FKDTreeSystem
 {
 public:
+    static constexpr int32 SubtreeSize = 1024;
+
     FKDTreeSystem();
     ~FKDTreeSystem();
 
-    void Build(const FBoundingBox& RootBounds);
-    UStaticMeshComponent* Raycast(const FRay& Ray, float& OutDistance) const;
+    //월드의 모든 StaticMeshComponent로 다시 빌드
+    void Build();
+    //Transform이 바뀐 컴포넌트가 속한 하위 트리만 다음 Raycast 전에 다시 빌드
+    void UpdateComponent(UStaticMeshComponent* Component);
+    //파괴되는 컴포넌트를 하위 트리에서 빼고, 그 하위 트리는 다음 Raycast 전에 다시 빌드
+    void RemoveComponent(UStaticMeshComponent* Component);
+    UStaticMeshComponent* Raycast(const FRay& Ray, float& OutDistance);
+
+    int32 GetNumSubtrees() const { return Subtrees.Num(); }
 
 private:
-    static constexpr int TreeCount = 8;
-    FKDTree* Trees[TreeCount];
-    FBoundingBox SubBounds[TreeCount];
+    struct FSubtree
+    {
+        FKDTree* Tree = nullptr;
+        bool bDirty = false;
+    };
+
+    void Clear();
+    //더러운 하위 트리를 다시 빌드하고 상위 노드 경계를 아래에서 위로 갱신
+    void FlushDirtySubtrees();
 
-    int GetRayTargetTreeIndex(const FRay& Ray) const;
+    TArray<FBVHNode> TopNodes;      // 리프의 Offset은 Subtrees 인덱스
+    TArray<FSubtree> Subtrees;
+    TMap<UStaticMeshComponent*, int32> ComponentSubtrees;
+    bool bHasDirtySubtrees = false;
 };
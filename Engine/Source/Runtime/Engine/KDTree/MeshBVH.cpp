@@ -0,0 +1,89 @@
+#include "MeshBVH.h"
+
+void FMeshBVH::Build(const TArray<FVertexCompact>& Vertices, const TArray<UINT>& Indices)
+{
+    Clear();
+
+    const int32 NumTriangles = Indices.Num() / 3;
+    if (NumTriangles == 0) return;
+
+    TArray<FBVHBuildPrimitive> Primitives;
+    Primitives.SetNum(NumTriangles);
+    for (int32 i = 0; i < NumTriangles; ++i)
+    {
+        const FVector V0 = Vertices[Indices[i * 3 + 0]].ToFVector();
+        const FVector V1 = Vertices[Indices[i * 3 + 1]].ToFVector();
+        const FVector V2 = Vertices[Indices[i * 3 + 2]].ToFVector();
+
+        FBVHBuildPrimitive& Prim = Primitives[i];
+        Prim.Min = FVector::Min(V0, FVector::Min(V1, V2));
+        Prim.Max = FVector::Max(V0, FVector::Max(V1, V2));
+        Prim.Centroid = (Prim.Min + Prim.Max) * 0.5f;
+        Prim.Index = i;
+    }
+
+    BuildBVHNodes(Primitives, MaxLeafSize, Nodes);
+
+    Triangles.SetNum(NumTriangles);
+    for (int32 i = 0; i < NumTriangles; ++i)
+    {
+        const int32 Source = Primitives[i].Index;
+        const FVector V0 = Vertices[Indices[Source * 3 + 0]].ToFVector();
+        const FVector V1 = Vertices[Indices[Source * 3 + 1]].ToFVector();
+        const FVector V2 = Vertices[Indices[Source * 3 + 2]].ToFVector();
+        Triangles[i] = {V0, V1 - V0, V2 - V0};
+    }
+}
+
+void FMeshBVH::Clear()
+{
+    Nodes.Empty();
+    Triangles.Empty();
+}
+
+bool FMeshBVH::Raycast(const FVector& LocalOrigin, const FVector& LocalDirection, float& InOutDistance) const
+{
+    if (Nodes.IsEmpty()) return false;
+
+    const FBVHRay BVHRay(LocalOrigin, LocalDirection);
+    bool bHit = false;
+
+    TraverseBVH(Nodes, BVHRay.bDirNeg, [&](const FBVHNode& Node)
+    {
+        if (!BVHRay.IntersectNode(Node, InOutDistance))
+            return false;
+        if (!Node.IsLeaf())
+            return true;
+
+        for (uint32 i = Node.Offset; i < Node.Offset + Node.Count; ++i)
+        {
+            // 양면 Moller-Trumbore
+            const FTriangle& Tri = Triangles[i];
+            const FVector P = LocalDirection.Cross(Tri.Edge2);
+            const float Det = Tri.Edge1.Dot(P);
+            if (FMath::Abs(Det) < 1e-12f)
+                continue;
+
+            const float InvDet = 1.0f / Det;
+            const FVector S = LocalOrigin - Tri.V0;
+            const float U = S.Dot(P) * InvDet;
+            if (U < 0.0f || U > 1.0f)
+                continue;
+
+            const FVector Q = S.Cross(Tri.Edge1);
+            const float V = LocalDirection.Dot(Q) * InvDet;
+            if (V < 0.0f || U + V > 1.0f)
+                continue;
+
+            const float T = Tri.Edge2.Dot(Q) * InvDet;
+            if (T > 0.0f && T < InOutDistance)
+            {
+                InOutDistance = T;
+                bHit = true;
+            }
+        }
+        return false;
+    });
+
+    return bHit;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "BVH.h"
+
+// UStaticMesh 하나의 로컬 공간 삼각형 BVH. 로드할 때 한 번 만들고 같은 메시를 쓰는 모든 인스턴스가 공유
+class FMeshBVH
+{
+public:
+    static constexpr int32 MaxLeafSize = 4;
+
+    void Build(const TArray<FVertexCompact>& Vertices, const TArray<UINT>& Indices);
+    void Clear();
+    bool IsEmpty() const { return Nodes.IsEmpty(); }
+
+    //로컬 공간 레이와 가장 가까운 삼각형 교차. Direction은 정규화하지 않아도 되며 t는 Direction 길이 단위.
+    //InOutDistance보다 가까운 교차가 있으면 갱신하고 true
+    bool Raycast(const FVector& LocalOrigin, const FVector& LocalDirection, float& InOutDistance) const;
+
+    int32 GetNumNodes() const { return Nodes.Num(); }
+    int32 GetNumTriangles() const { return Triangles.Num(); }
+
+private:
+    // 교차 검사(Moller-Trumbore)에 바로 쓰도록 변 벡터를 미리 계산. 리프 순서로 정렬됨
+    struct FTriangle
+    {
+        FVector V0;
+        FVector Edge1;
+        FVector Edge2;
+    };
+
+    TArray<FBVHNode> Nodes;
+    TArray<FTriangle> Triangles;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Define.h"
+#include "Container/BoundedHeap.h"
+#include "Math/MathUtility.h"
+
+class UPrimitiveComponent;
+
+// k-NN/반경 질의 결과 한 개
+struct FNearestComponent
+{
+    UPrimitiveComponent* Component = nullptr;
+    float Distance = 0.0f; // 질의 점에서 WorldAABB까지 거리. AABB 안이면 0
+
+    bool operator<(const FNearestComponent& Other) const { return Distance < Other.Distance; }
+};
+
+// 점과 AABB 사이 거리 제곱. 안에 있으면 0
+inline float PointToAABBDistanceSquared(const FVector& Point, const FVector& Min, const FVector& Max)
+{
+    const float DX = FMath::Max(FMath::Max(Min.x - Point.x, Point.x - Max.x), 0.0f);
+    const float DY = FMath::Max(FMath::Max(Min.y - Point.y, Point.y - Max.y), 0.0f);
+    const float DZ = FMath::Max(FMath::Max(Min.z - Point.z, Point.z - Max.z), 0.0f);
+    return DX * DX + DY * DY + DZ * DZ;
+}
+
+// 가까운 K개를 호출자 결과 배열 위의 최대 힙(가장 먼 결과가 Top)으로 모음.
+// 탐색 중 Distance에는 거리 제곱을 두고 Finish에서 정렬 + 제곱근
+class FNearestCollector
+{
+public:
+    FNearestCollector(FNearestComponent* OutResults, int32 K, float MaxDistance)
+        : Heap(OutResults, FMath::Max(K, 0))
+        , MaxDistanceSquared(MaxDistance < FLT_MAX ? MaxDistance * MaxDistance : FLT_MAX)
+    {
+    }
+
+    // 이 거리 제곱 이상인 노드/컴포넌트는 결과를 바꿀 수 없음
+    float GetBoundSquared() const
+    {
+        return Heap.IsFull() && Heap.Num() > 0 ? FMath::Min(Heap.Top().Distance, MaxDistanceSquared) : MaxDistanceSquared;
+    }
+
+    //bCheckDuplicate: 한 컴포넌트가 여러 노드에서 나올 수 있을 때 (일반 옥트리의 OverlappingComponents)
+    void Add(UPrimitiveComponent* Component, float DistanceSquared, bool bCheckDuplicate)
+    {
+        if (DistanceSquared > MaxDistanceSquared)
+            return;
+        if (Heap.IsFull() && DistanceSquared >= Heap.Top().Distance)
+            return;
+        if (bCheckDuplicate)
+        {
+            // 같은 컴포넌트는 거리도 같으므로 이미 있으면 그대로 둠
+            const FNearestComponent* Data = Heap.GetData();
+            for (int32 i = 0; i < Heap.Num(); ++i)
+            {
+                if (Data[i].Component == Component)
+                    return;
+            }
+        }
+        Heap.PushBounded({Component, DistanceSquared});
+    }
+
+    //가까운 순으로 정렬하고 찾은 개수 반환
+    int32 Finish()
+    {
+        Heap.Sort();
+        FNearestComponent* Data = Heap.GetData();
+        for (int32 i = 0; i < Heap.Num(); ++i)
+            Data[i].Distance = FMath::Sqrt(Data[i].Distance);
+        return Heap.Num();
+    }
+
+private:
+    TBoundedHeap<FNearestComponent> Heap;
+    float MaxDistanceSquared;
+};
+
+// 최선 우선 탐색용 노드 큐 원소. 가장 가까운 노드가 Top
+template <typename NodeType>
+struct TNearestNodeEntry
+{
+    NodeType Node;
+    float DistanceSquared;
+
+    bool operator>(const TNearestNodeEntry& Other) const { return DistanceSquared > Other.DistanceSquared; }
+};
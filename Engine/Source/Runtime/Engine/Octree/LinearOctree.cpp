@@ -0,0 +1,177 @@
+// LinearOctree.cpp
+#include "LinearOctree.h"
+
+#include <bit>
+
+#include "Octree.h"
+#include "OcclusionQuerySystem.h"
+#include "SoftwareOcclusion.h"
+#include "Math/Frustum.h"
+
+// 컬링은 LooseBounds 기준 (Loose 모드가 아니면 Bounds와 같음)
+static FLinearOctreeHotNode MakeHotNode(const FOctreeNode* Node)
+{
+    FLinearOctreeHotNode HotNode;
+    HotNode.Min = Node->LooseBounds.min;
+    HotNode.Max = Node->LooseBounds.max;
+    HotNode.Depth = static_cast<uint8>(Node->Depth);
+    HotNode.bHasOwnComponents = Node->Components.IsEmpty() ? 0 : 1;
+    return HotNode;
+}
+
+void FLinearOctree::Build(FOctreeNode* Root)
+{
+    Clear();
+    if (!Root) return;
+
+    // 너비 우선으로 펼침. 노드 i를 처리하는 시점에 자식들을 배열 끝에 연속으로 붙이므로
+    // 처리 순서 == 인덱스 순서가 되어 별도 큐가 필요 없다.
+    HotNodes.Add(MakeHotNode(Root));
+    ColdNodes.Add({Root});
+
+    for (int32 Index = 0; Index < HotNodes.Num(); ++Index)
+    {
+        FOctreeNode* Source = ColdNodes[Index].SourceNode;
+
+        uint8 ChildMask = 0;
+        const uint32 FirstChild = static_cast<uint32>(HotNodes.Num());
+
+        // 자식 인덱스 i는 (x, y, z) = (bit0, bit1, bit2)이므로 0~7 순서가 곧 Morton 순서
+        for (int i = 0; i < 8; ++i)
+        {
+            FOctreeNode* Child = Source->Children[i];
+            if (!Child) continue;
+
+            ChildMask |= static_cast<uint8>(1 << i);
+            HotNodes.Add(MakeHotNode(Child));
+            ColdNodes.Add({Child});
+        }
+
+        // Add로 배열이 재할당될 수 있으므로 인덱스로 다시 접근
+        HotNodes[Index].FirstChild = ChildMask ? FirstChild : 0;
+        HotNodes[Index].ChildMask = ChildMask;
+    }
+
+    HotNodes.ShrinkToFit();
+    ColdNodes.ShrinkToFit();
+    LastOutsidePlanes.Init(FFrustum::NoPlane, HotNodes.Num());
+}
+
+void FLinearOctree::Clear()
+{
+    HotNodes.Empty();
+    ColdNodes.Empty();
+    LastOutsidePlanes.Empty();
+}
+
+void FLinearOctree::CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes) const
+{
+    if (HotNodes.IsEmpty()) return;
+
+    // 재귀 대신 고정 크기 스택. 깊이 D에서 최대 7*D+1개가 쌓임
+    // 자식들은 부모를 꺼낼 때 한 번에 컬링하므로 결과와 아직 걸친 평면 마스크를 같이 쌓아둔다
+    constexpr int32 MaxStack = 256;
+    uint32 Stack[MaxStack];
+    EFrustumContainment ContainmentStack[MaxStack];
+    uint8 PlaneMaskStack[MaxStack];
+    int32 StackSize = 0;
+
+    uint8 RootPlaneMask = FFrustum::AllPlanesMask;
+    Stack[StackSize] = 0;
+    ContainmentStack[StackSize] = Frustum.CheckContainment(FBoundingBox(HotNodes[0].Min, HotNodes[0].Max), RootPlaneMask, LastOutsidePlanes[0]);
+    PlaneMaskStack[StackSize++] = RootPlaneMask;
+
+    while (StackSize > 0)
+    {
+        --StackSize;
+        const uint32 Index = Stack[StackSize];
+        const EFrustumContainment Containment = ContainmentStack[StackSize];
+        const uint8 PlaneMask = PlaneMaskStack[StackSize];
+        const FLinearOctreeHotNode& Node = HotNodes[Index];
+
+        if (Containment == EFrustumContainment::Contains ||
+            (Containment == EFrustumContainment::Intersects && Node.Depth == GRenderDepthMax))
+        {
+            FOctreeNode* Source = ColdNodes[Index].SourceNode;
+            if (!IsOctreeRegionVisible(Source->NodeId, FBoundingBox(Node.Min, Node.Max)))
+                continue;
+
+            if (Node.Depth >= GRenderDepthMin)
+            {
+                OutNodes.Add(Source);
+                continue;
+            }
+        }
+        if (Containment == EFrustumContainment::Outside || Node.Depth == GRenderDepthMax)
+            continue;
+
+        // 자식으로 내려가는 경우 자기 구간은 따로 그려야 함
+        if (OutOwnNodes && Node.bHasOwnComponents)
+            OutOwnNodes->Add(ColdNodes[Index].SourceNode);
+
+        if (!Node.ChildMask)
+            continue;
+
+        const int32 ChildCount = std::popcount(Node.ChildMask);
+        if (StackSize + ChildCount > MaxStack)
+            continue;
+
+        EFrustumContainment ChildContainments[8];
+        uint8 ChildPlaneMasks[8];
+        if (PlaneMask == 0)
+        {
+            // 부모가 완전히 포함되면 자식도 포함
+            for (int32 c = 0; c < ChildCount; ++c)
+            {
+                ChildContainments[c] = EFrustumContainment::Contains;
+                ChildPlaneMasks[c] = 0;
+            }
+        }
+        else
+        {
+            // 지난 프레임에 거부한 평면 하나로 먼저 거르고, 나머지 자식은 SIMD로 한 번에 컬링
+            FBoundingBox ChildBounds[8];
+            int32 ChildSlots[8];
+            int32 TestCount = 0;
+            for (int32 c = 0; c < ChildCount; ++c)
+            {
+                const uint32 ChildIndex = Node.FirstChild + c;
+                const FLinearOctreeHotNode& Child = HotNodes[ChildIndex];
+                const FBoundingBox Bounds(Child.Min, Child.Max);
+
+                ChildContainments[c] = EFrustumContainment::Outside;
+                ChildPlaneMasks[c] = 0;
+
+                const uint8 Plane = LastOutsidePlanes[ChildIndex];
+                if (Plane != FFrustum::NoPlane && (PlaneMask & (1 << Plane)) && Frustum.IsOutsidePlane(Bounds, Plane))
+                    continue;
+
+                ChildBounds[TestCount] = Bounds;
+                ChildSlots[TestCount++] = c;
+            }
+
+            EFrustumContainment Results[8];
+            uint8 PlaneMasks[8];
+            uint8 OutsidePlanes[8];
+            if (TestCount > 0)
+                Frustum.CheckContainmentBatch(ChildBounds, TestCount, Results, PlaneMask, PlaneMasks, OutsidePlanes);
+            for (int32 t = 0; t < TestCount; ++t)
+            {
+                const int32 c = ChildSlots[t];
+                ChildContainments[c] = Results[t];
+                ChildPlaneMasks[c] = PlaneMasks[t];
+                LastOutsidePlanes[Node.FirstChild + c] = OutsidePlanes[t];
+            }
+        }
+
+        // 재귀 버전과 같은 방문 순서를 위해 역순으로 push
+        for (int32 c = ChildCount - 1; c >= 0; --c)
+        {
+            if (ChildContainments[c] == EFrustumContainment::Outside)
+                continue;
+            Stack[StackSize] = Node.FirstChild + c;
+            ContainmentStack[StackSize] = ChildContainments[c];
+            PlaneMaskStack[StackSize++] = ChildPlaneMasks[c];
+        }
+    }
+}
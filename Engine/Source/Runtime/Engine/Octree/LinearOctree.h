@@ -0,0 +1,50 @@
+// LinearOctree.h
+#pragma once
+
+#include "Define.h"
+
+class FOctreeNode;
+class FFrustum;
+
+// 프러스텀 순회 때마다 읽는 데이터만 담은 노드 (32바이트 → 캐시라인 하나에 2개)
+struct FLinearOctreeHotNode
+{
+    FVector Min;
+    uint32 FirstChild = 0;  // 자식 노드 시작 오프셋. 자식들은 배열에서 연속으로 저장됨
+    FVector Max;
+    uint8 ChildMask = 0;    // 존재하는 자식 비트 (bit i = 자식 i). 0이면 리프
+    uint8 Depth = 0;
+    uint8 bHasOwnComponents = 0; // Loose 모드에서 내부 노드도 Components를 가질 수 있음
+    uint8 Pad = 0;
+};
+
+static_assert(sizeof(FLinearOctreeHotNode) == 32);
+
+// 노드가 렌더 대상으로 선택된 뒤에만 접근하는 데이터
+struct FLinearOctreeColdNode
+{
+    FOctreeNode* SourceNode = nullptr; // CachedBatchNodeData를 가진 원본 노드
+};
+
+// FOctreeNode 트리를 너비 우선으로 펼쳐 만든 포인터 없는 옥트리.
+// 같은 부모의 자식은 연속 저장되고, 한 레벨 안에서는 Morton 순서를 따른다.
+class FLinearOctree
+{
+public:
+    //원본 트리를 펼쳐서 배열을 새로 구성. 원본 트리보다 오래 살아있으면 안 됨
+    void Build(FOctreeNode* Root);
+    void Clear();
+
+    //FOctreeNode::CollectRenderNodes와 같은 규칙/순서로 렌더할 노드를 수집
+    void CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes = nullptr) const;
+
+    int32 Num() const { return HotNodes.Num(); }
+    const FLinearOctreeHotNode& GetHotNode(uint32 Index) const { return HotNodes[Index]; }
+    const FLinearOctreeColdNode& GetColdNode(uint32 Index) const { return ColdNodes[Index]; }
+
+private:
+    TArray<FLinearOctreeHotNode> HotNodes;
+    TArray<FLinearOctreeColdNode> ColdNodes;
+    //노드별로 지난 프레임에 거부한 프러스텀 평면 (FFrustum::NoPlane이면 없음). 다음 프레임에 먼저 검사
+    mutable TArray<uint8> LastOutsidePlanes;
+};
@@ -4,6 +4,10 @@
 
 #include <sstream>
 
+#include "LinearOctree.h"
+
+#include "Async/ParallelFor.h"
+
 #include "Components/PrimitiveComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "KDTree/KDTree.h"
@@ -18,41 +22,94 @@
 #include "UObject/Casts.h"
 #include "UObject/UObjectIterator.h"
 #include "OcclusionQuerySystem.h"
+#include "SoftwareOcclusion.h"
 
 int GCurrentFrame = 0;
 
+static uint32 WriteSubsetVertices(const OBJ::FStaticMeshRenderData* RenderData, const FSubsetVertexRemap& Remap,
+                                  const FMatrix& ModelMatrix, TArray<FVertexCompact>& Vertices, uint32 VertexStart,
+                                  UINT* OutIndices);
+
 void FOctree::BuildFull()
 {
     FScopeCycleCounter Timer("BuildFullOctree");
 
-    FVector MinBound(FLT_MAX, FLT_MAX, FLT_MAX);
-    FVector MaxBound(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    const bool bSingleThread = !bParallelBuild;
 
-    // Step 1. 전체 Bounds 계산
-    for (const auto* SceneComp : TObjectRange<USceneComponent>())
+    // Step 1. 전체 Bounds 계산. 순서를 지키기 위해 수집은 직렬, AABB 갱신과 min/max 축소는 구간별 병렬
+    TArray<UPrimitiveComponent*> Primitives;
+    TArray<uint8> IsMesh;
+    for (USceneComponent* SceneComp : TObjectRange<USceneComponent>())
     {
-        if (const auto* MeshComp = Cast<UMeshComponent>(SceneComp))
+        if (auto* PrimComp = Cast<UPrimitiveComponent>(SceneComp))
         {
-            auto* PrimComp = Cast<UPrimitiveComponent>(MeshComp);
-            PrimComp->UpdateWorldAABB();
-            const FBoundingBox& AABB = MeshComp->WorldAABB;
+            Primitives.Add(PrimComp);
+            IsMesh.Add(Cast<UMeshComponent>(SceneComp) ? 1 : 0);
+        }
+    }
 
-            MinBound = FVector::Min(MinBound, AABB.min);
-            MaxBound = FVector::Max(MaxBound, AABB.max);
+    constexpr int32 BoundsChunkSize = 1024;
+    const int32 NumChunks = (Primitives.Num() + BoundsChunkSize - 1) / BoundsChunkSize;
+    TArray<FVector> ChunkMin;
+    TArray<FVector> ChunkMax;
+    ChunkMin.Init(FVector(FLT_MAX, FLT_MAX, FLT_MAX), NumChunks);
+    ChunkMax.Init(FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX), NumChunks);
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        const int32 End = FMath::Min(Primitives.Num(), (Chunk + 1) * BoundsChunkSize);
+        for (int32 i = Chunk * BoundsChunkSize; i < End; ++i)
+        {
+            Primitives[i]->UpdateWorldAABB();
+            if (!IsMesh[i]) continue;
+            ChunkMin[Chunk] = FVector::Min(ChunkMin[Chunk], Primitives[i]->WorldAABB.min);
+            ChunkMax[Chunk] = FVector::Max(ChunkMax[Chunk], Primitives[i]->WorldAABB.max);
         }
+    }, bSingleThread);
+
+    FVector MinBound(FLT_MAX, FLT_MAX, FLT_MAX);
+    FVector MaxBound(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+    {
+        MinBound = FVector::Min(MinBound, ChunkMin[Chunk]);
+        MaxBound = FVector::Max(MaxBound, ChunkMax[Chunk]);
     }
 
     delete Root;
-    Root = new FOctreeNode(FBoundingBox(MinBound, MaxBound), 0);
+    Root = new FOctreeNode(FBoundingBox(MinBound, MaxBound), 0, Looseness);
+    DirtyKDNodes.Empty();
+    bVisibilityCacheValid = false;
 
     // Step 2. 노드 삽입
-    Build();
+    InsertComponents(Primitives);
 
-    // Step 3. KDTree 및 렌더링 데이터 구축
-    Root->BuildKDTreeRecursive();
-    Root->BuildBatchRenderData();
+    // Step 3. KDTree 및 렌더링 데이터 구축. Loose 모드는 노드별 Components를 직접 검사하므로 KDTree 생략
+    if (!Root->IsLoose())
+        Root->BuildKDTreeRecursive();
+
+    // 직렬 순회로 구간을 먼저 정하고, 겹치지 않는 구간에 서브셋별로 병렬 기록
+    FBatchBuildContext BatchContext;
+    Root->BuildBatchRenderData(BatchContext);
+    ParallelFor(BatchContext.Jobs.Num(), [&](int32 JobIndex)
+    {
+        const FBatchWriteJob& Job = BatchContext.Jobs[JobIndex];
+        FRenderBatchRootData* RootBatch = Root->CachedBatchRootData.Find(Job.MatName);
+        TArray<FVertexCompact>* Vertices = RootBatch->Vertices.Find(Job.LOD);
+        TArray<UINT>* Indices = RootBatch->Indices.Find(Job.LOD);
+
+        const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(
+            Job.Component->GetWorldLocation(),
+            Job.Component->GetWorldRotation(),
+            Job.Component->GetWorldScale()
+        );
+        WriteSubsetVertices(Job.RenderData, *Job.Remap, ModelMatrix, *Vertices, Job.VertexStart, Indices->GetData() + Job.IndexStart);
+    }, bSingleThread);
     Root->AssignAllDrawRangesLODWrapped();
     Root->BuildBatchBuffers(FEngineLoop::renderer);
+
+    // Step 4. 프러스텀 순회용 Linear 옥트리
+    if (!LinearTree)
+        LinearTree = new FLinearOctree();
+    LinearTree->Build(Root);
     //Root->BuildBatchBuffers(FEngineLoop::renderer);
     //Root->ClearBatchDatas();
     //Root->ClearKDDatas(MaxDepthKD);
@@ -61,15 +118,25 @@ void FOctree::BuildFull()
 }
 
 
-FOctreeNode::FOctreeNode(const FBoundingBox& InBounds, int InDepth)
+static FBoundingBox MakeLooseBounds(const FBoundingBox& InBounds, float InLooseness)
+{
+    const FVector Center = (InBounds.min + InBounds.max) * 0.5f;
+    const FVector HalfExtent = (InBounds.max - InBounds.min) * (0.5f * InLooseness);
+    return FBoundingBox(Center - HalfExtent, Center + HalfExtent);
+}
+
+FOctreeNode::FOctreeNode(const FBoundingBox& InBounds, int InDepth, float InLooseness)
     : Bounds(InBounds)
+    , Looseness(InLooseness)
     , Depth(InDepth)
 {
+    LooseBounds = IsLoose() ? MakeLooseBounds(Bounds, Looseness) : Bounds;
     BoundingSphere = Bounds.GetBoundingSphere(true);
 }
 
 FOctree::~FOctree()
 {
+    delete LinearTree;
     delete Root;
 }
 
@@ -123,41 +190,75 @@ FOctreeNode::~FOctreeNode()
 }
 
 
-void FOctreeNode::Insert(UPrimitiveComponent* Component, int MaxDepth)
+FBoundingBox FOctreeNode::GetChildBounds(int InChildIndex) const
+{
+    const FVector Center = (Bounds.min + Bounds.max) * 0.5f;
+    const FVector Min = {
+        (InChildIndex & 1) ? Center.x : Bounds.min.x,
+        (InChildIndex & 2) ? Center.y : Bounds.min.y,
+        (InChildIndex & 4) ? Center.z : Bounds.min.z
+    };
+    const FVector Max = {
+        (InChildIndex & 1) ? Bounds.max.x : Center.x,
+        (InChildIndex & 2) ? Bounds.max.y : Center.y,
+        (InChildIndex & 4) ? Bounds.max.z : Center.z
+    };
+    return FBoundingBox(Min, Max);
+}
+
+void FOctreeNode::Split()
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        // 정확히 잘린 조각이므로 보정(Epsilon)은 오히려 왜곡을 일으킬 수 있음
+        Children[i] = new FOctreeNode(GetChildBounds(i), Depth + 1, Looseness);
+        Children[i]->Parent = this;
+        Children[i]->ChildIndex = i;
+    }
+    bIsLeaf = false;
+}
+
+FOctreeNode* FOctreeNode::Insert(UPrimitiveComponent* Component, int MaxDepth, FOctreeNode** OutSplitNode)
 {
     if (Depth >= MaxDepth)
     {
         Components.Add(Component);
-        return;
+        return this;
     }
 
-    if (bIsLeaf)
+    if (IsLoose())
     {
-        FVector Center = (Bounds.min + Bounds.max) * 0.5f;
-        for (int i = 0; i < 8; ++i)
+        // 중심이 속한 자식의 느슨한 경계에 AABB 전체가 들어갈 때만 내려감. 아니면 이 노드가 소유
+        const FVector Center = (Bounds.min + Bounds.max) * 0.5f;
+        const FVector CompCenter = Component->WorldAABB.GetCenter();
+        const int i = (CompCenter.x > Center.x ? 1 : 0) | (CompCenter.y > Center.y ? 2 : 0) | (CompCenter.z > Center.z ? 4 : 0);
+
+        if (!MakeLooseBounds(GetChildBounds(i), Looseness).Contains(Component->WorldAABB))
         {
-            FVector Min = {
-                (i & 1) ? Center.x : Bounds.min.x,
-                (i & 2) ? Center.y : Bounds.min.y,
-                (i & 4) ? Center.z : Bounds.min.z
-            };
-            FVector Max = {
-                (i & 1) ? Bounds.max.x : Center.x,
-                (i & 2) ? Bounds.max.y : Center.y,
-                (i & 4) ? Bounds.max.z : Center.z
-            };
+            Components.Add(Component);
+            return this;
+        }
 
-            // 정확히 잘린 조각이므로 보정(Epsilon)은 오히려 왜곡을 일으킬 수 있음
-            Children[i] = new FOctreeNode(FBoundingBox(Min, Max), Depth + 1);
-            Children[i]->Parent = this;
-            Children[i]->ChildIndex = i;
+        if (bIsLeaf)
+        {
+            Split();
+            if (OutSplitNode && !*OutSplitNode)
+                *OutSplitNode = this;
         }
-        bIsLeaf = false;
+        return Children[i]->Insert(Component, MaxDepth, OutSplitNode);
+    }
 
-        for (UPrimitiveComponent* Comp : Components)
-            Insert(Comp, MaxDepth);
+    if (bIsLeaf)
+    {
+        Split();
+        if (OutSplitNode && !*OutSplitNode)
+            *OutSplitNode = this;
 
+        // 순회 중인 배열에 다시 추가되지 않도록 옮겨 놓고 재삽입
+        TArray<UPrimitiveComponent*> Pending = std::move(Components);
         Components.Empty();
+        for (UPrimitiveComponent* Comp : Pending)
+            Insert(Comp, MaxDepth, OutSplitNode);
     }
 
     for (int i = 0; i < 8; ++i)
@@ -166,12 +267,12 @@ void FOctreeNode::Insert(UPrimitiveComponent* Component, int MaxDepth)
         //if (Children[i]->Bounds.Overlaps(Component->AABB))
         if (Children[i]->Bounds.Contains(Component->WorldAABB.GetCenter()))
         {
-            Children[i]->Insert(Component, MaxDepth);
-            return;
+            return Children[i]->Insert(Component, MaxDepth, OutSplitNode);
         }
     }
 
     Components.Add(Component);
+    return this;
 }
 
 void FOctreeNode::BuildOverlappingRecursive(UPrimitiveComponent* Component)
@@ -200,7 +301,7 @@ void FOctreeNode::BuildKDTreeRecursive()
         }
         if (!StaticMeshComps.IsEmpty())
         {
-            KDTree = new FKDTreeNode();
+            KDTree = new FKDTree();
             KDTree->Build(StaticMeshComps);
         }
     }
@@ -220,131 +321,500 @@ FOctree::FOctree(const FBoundingBox& InBounds)
 
 void FOctree::Build()
 {
-    for (const auto* SceneComp : TObjectRange<USceneComponent>())
+    TArray<UPrimitiveComponent*> Primitives;
+    for (USceneComponent* SceneComp : TObjectRange<USceneComponent>())
     {
         if (auto* PrimComp = Cast<UPrimitiveComponent>(SceneComp))
+            Primitives.Add(PrimComp);
+    }
+    ParallelFor(Primitives.Num(), [&](int32 i) { Primitives[i]->UpdateWorldAABB(); }, !bParallelBuild);
+    InsertComponents(Primitives);
+}
+
+// FOctreeNode::Insert가 루트에서 고를 자식. -1이면 루트가 소유
+static int GetRootInsertChild(const FOctreeNode* Node, const UPrimitiveComponent* Component)
+{
+    if (Node->IsLoose())
+    {
+        const FVector Center = (Node->Bounds.min + Node->Bounds.max) * 0.5f;
+        const FVector CompCenter = Component->WorldAABB.GetCenter();
+        const int i = (CompCenter.x > Center.x ? 1 : 0) | (CompCenter.y > Center.y ? 2 : 0) | (CompCenter.z > Center.z ? 4 : 0);
+        return MakeLooseBounds(Node->GetChildBounds(i), Node->Looseness).Contains(Component->WorldAABB) ? i : -1;
+    }
+
+    for (int i = 0; i < 8; ++i)
+    {
+        if (Node->GetChildBounds(i).Contains(Component->WorldAABB.GetCenter()))
+            return i;
+    }
+    return -1;
+}
+
+void FOctree::InsertComponents(const TArray<UPrimitiveComponent*>& Primitives)
+{
+    const bool bLoose = Root->IsLoose();
+
+    if (!bParallelBuild || Primitives.Num() == 0)
+    {
+        for (UPrimitiveComponent* PrimComp : Primitives)
         {
-            PrimComp->UpdateWorldAABB();
             Root->Insert(PrimComp);
-            Root->BuildOverlappingRecursive(PrimComp);
+            // Loose 옥트리는 소유 노드가 AABB를 완전히 포함하므로 중복 등록이 필요 없음
+            if (!bLoose)
+                Root->BuildOverlappingRecursive(PrimComp);
         }
+        return;
+    }
+
+    // 루트 자식별로 나누면 서브트리끼리는 공유하는 노드가 없음.
+    // 각 자식 안에서는 원래 순서대로 삽입하므로 직렬 삽입과 같은 트리가 나온다
+    TArray<UPrimitiveComponent*> ChildComponents[8];
+    for (UPrimitiveComponent* PrimComp : Primitives)
+    {
+        const int Child = GetRootInsertChild(Root, PrimComp);
+        if (Child < 0)
+            Root->Components.Add(PrimComp);
+        else
+            ChildComponents[Child].Add(PrimComp);
+    }
+
+    // 중심 기준 옥트리는 첫 삽입에서 바로 분할, Loose는 자식으로 내려가는 컴포넌트가 있을 때만 분할
+    bool bNeedSplit = !bLoose;
+    for (const TArray<UPrimitiveComponent*>& Bucket : ChildComponents)
+        bNeedSplit |= !Bucket.IsEmpty();
+    if (bNeedSplit && Root->bIsLeaf)
+        Root->Split();
+
+    if (!Root->bIsLeaf)
+    {
+        ParallelFor(8, [&](int32 Child)
+        {
+            for (UPrimitiveComponent* PrimComp : ChildComponents[Child])
+                Root->Children[Child]->Insert(PrimComp);
+        });
+    }
+
+    if (bLoose)
+        return;
+
+    // OverlappingComponents도 루트만 직렬로 채우고 자식 서브트리는 병렬
+    TArray<UPrimitiveComponent*> RootOverlaps;
+    for (UPrimitiveComponent* PrimComp : Primitives)
+    {
+        if (!Root->Bounds.Overlaps(PrimComp->WorldAABB)) continue;
+        Root->OverlappingComponents.Add(PrimComp);
+        RootOverlaps.Add(PrimComp);
+    }
+    if (!Root->bIsLeaf)
+    {
+        ParallelFor(8, [&](int32 Child)
+        {
+            for (UPrimitiveComponent* PrimComp : RootOverlaps)
+                Root->Children[Child]->BuildOverlappingRecursive(PrimComp);
+        });
+    }
+}
+
+void FOctree::CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes, bool bAllowReuse)
+{
+    if (!Root) return;
+
+    const bool bLinear = bUseLinearOctree && LinearTree && LinearTree->Num() > 0;
+
+    // 카메라가 그대로인 프레임은 순회 없이 지난 결과 재사용
+    if (bAllowReuse && bTemporalCoherence && bVisibilityCacheValid &&
+        CachedDepthMin == GRenderDepthMin && CachedDepthMax == GRenderDepthMax &&
+        bCachedLinearOctree == bLinear && CachedFrustum.IsSameAs(Frustum))
+    {
+        OutNodes.Append(CachedRenderNodes);
+        if (OutOwnNodes)
+            OutOwnNodes->Append(CachedOwnRenderNodes);
+        return;
     }
+
+    CachedRenderNodes.Empty();
+    CachedOwnRenderNodes.Empty();
+    if (bLinear)
+        LinearTree->CollectRenderNodes(Frustum, CachedRenderNodes, &CachedOwnRenderNodes);
+    else
+        Root->CollectRenderNodes(Frustum, CachedRenderNodes, &CachedOwnRenderNodes);
+
+    OutNodes.Append(CachedRenderNodes);
+    if (OutOwnNodes)
+        OutOwnNodes->Append(CachedOwnRenderNodes);
+
+    // 오클루전 결과가 섞인 목록은 다음 프레임에 그대로 쓸 수 없음
+    bVisibilityCacheValid = bAllowReuse;
+    CachedFrustum = Frustum;
+    CachedDepthMin = GRenderDepthMin;
+    CachedDepthMax = GRenderDepthMax;
+    bCachedLinearOctree = bLinear;
 }
 
-UPrimitiveComponent* FOctree::Raycast(const FRay& Ray, float& OutHitDistance) const
+UPrimitiveComponent* FOctree::Raycast(const FRay& Ray, float& OutHitDistance)
 {
     if (!Root) return nullptr;
-    if (bUseKD) return Root->RaycastWithKD(Ray, OutHitDistance, MaxDepthKD);
-    else return Root->Raycast(Ray, OutHitDistance);
+
+    const bool bLoose = Root->IsLoose();
+    if (bUseKD && !bLoose)
+        FlushDirtyKDTrees();
+
+    FRaycastStats Stats;
+    UPrimitiveComponent* HitComp = nullptr;
+    float RootHitDist;
+    if (RayIntersectsAABB(Ray, bLoose ? Root->LooseBounds : Root->Bounds, RootHitDist) && RootHitDist <= OutHitDistance)
+    {
+        if (bLoose)
+            HitComp = Root->RaycastLoose(Ray, OutHitDistance, Stats);
+        else if (bUseKD)
+            HitComp = Root->RaycastWithKD(Ray, OutHitDistance, MaxDepthKD, Stats);
+        else
+            HitComp = Root->Raycast(Ray, OutHitDistance, Stats);
+    }
+
+    FStatRegistry::SetCounter("PickNodesVisited", Stats.NodesVisited);
+    FStatRegistry::SetCounter("PickPrimitivesTested", Stats.PrimitivesTested);
+    return HitComp;
 }
 
-//불용
-UPrimitiveComponent* FOctreeNode::Raycast(const FRay& Ray, float& OutDistance) const
+struct FRayChildEntry
+{
+    const FOctreeNode* Node;
+    float EntryDistance;
+};
+
+// 레이가 MaxDistance 안에서 들어가는 자식만 진입 거리 순으로 정렬해 개수 반환. bLoose면 LooseBounds 기준
+static int32 SortChildrenByEntry(const FOctreeNode* Parent, const FRay& Ray, float MaxDistance, bool bLoose, FRayChildEntry OutEntries[8])
 {
-    float NodeHitDist;
-    if (!RayIntersectsAABB(Ray, Bounds, NodeHitDist)) return nullptr;
-    //if (!IntersectRaySphere(Ray.Origin, Ray.Direction, BoundingSphere, NodeHitDist)) return nullptr;
+    int32 Count = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        const FOctreeNode* Child = Parent->Children[i];
+        if (!Child) continue;
+
+        float EntryDistance;
+        if (!RayIntersectsAABB(Ray, bLoose ? Child->LooseBounds : Child->Bounds, EntryDistance) || EntryDistance > MaxDistance)
+            continue;
 
+        // 최대 8개라 삽입 정렬
+        int32 Slot = Count++;
+        while (Slot > 0 && OutEntries[Slot - 1].EntryDistance > EntryDistance)
+        {
+            OutEntries[Slot] = OutEntries[Slot - 1];
+            --Slot;
+        }
+        OutEntries[Slot] = {Child, EntryDistance};
+    }
+    return Count;
+}
+
+UPrimitiveComponent* FOctreeNode::Raycast(const FRay& Ray, float& InOutDistance, FRaycastStats& Stats) const
+{
+    ++Stats.NodesVisited;
     UPrimitiveComponent* ClosestComponent = nullptr;
-    float ClosestDistance = FLT_MAX;
 
     // 1. Leaf Node → OverlappingComponents 검사
     if (bIsLeaf)
     {
         for (UPrimitiveComponent* Comp : OverlappingComponents)
         {
-            float HitDist = 0.0f;
-            if (IntersectRaySphere(Ray.Origin, Ray.Direction, Comp->BoundingSphere, HitDist))
+            ++Stats.PrimitivesTested;
+            float HitDist = FLT_MAX;
+            if (Comp->CheckRayIntersection(Ray.Origin, Ray.Direction, HitDist) && HitDist < InOutDistance)
             {
-                if (HitDist < ClosestDistance)
-                {
-                    ClosestDistance = HitDist;
-                    ClosestComponent = Comp;
-                }
+                InOutDistance = HitDist;
+                ClosestComponent = Comp;
             }
         }
+        return ClosestComponent;
     }
-    else
+
+    // 2. 가까운 자식부터. 교차점은 그 점을 포함하는 리프에서 반드시 발견되므로
+    //    진입 거리가 지금까지의 최단 교차보다 먼 자식(과 그 뒤 자식 전부)은 볼 필요가 없음
+    FRayChildEntry Entries[8];
+    const int32 Count = SortChildrenByEntry(this, Ray, InOutDistance, false, Entries);
+    for (int32 i = 0; i < Count && Entries[i].EntryDistance <= InOutDistance; ++i)
     {
-        for (int i = 0; i < 8; ++i)
+        if (UPrimitiveComponent* HitComp = Entries[i].Node->Raycast(Ray, InOutDistance, Stats))
+            ClosestComponent = HitComp;
+    }
+    return ClosestComponent;
+}
+
+UPrimitiveComponent* FOctreeNode::RaycastWithKD(const FRay& Ray, float& InOutDistance, int MaxDepthKD, FRaycastStats& Stats) const
+{
+    ++Stats.NodesVisited;
+
+    // 리프 노드: KD 트리 사용
+    if (Depth == MaxDepthKD)
+    {
+        if (!KDTree) return nullptr;
+
+        float HitDist = FLT_MAX;
+        UPrimitiveComponent* KDHit = KDTree->Raycast(Ray, HitDist);
+        if (KDHit && HitDist < InOutDistance)
         {
-            if (Children[i])
-            {
-                float ChildHitDist = FLT_MAX;
-                UPrimitiveComponent* HitComp = Children[i]->Raycast(Ray, ChildHitDist);
-                if (HitComp && ChildHitDist < ClosestDistance)
-                {
-                    ClosestComponent = HitComp;
-                    ClosestDistance = ChildHitDist;
-                }
-            }
+            InOutDistance = HitDist;
+            return KDHit;
         }
+        return nullptr;
     }
 
-    OutDistance = ClosestDistance;
+    // 내부 노드: 진입 거리순으로 검사. 앞 자식에서 찾은 교차보다 늦게 들어가는 자식에서 멈춤
+    UPrimitiveComponent* ClosestComponent = nullptr;
+    FRayChildEntry Entries[8];
+    const int32 Count = SortChildrenByEntry(this, Ray, InOutDistance, false, Entries);
+    for (int32 i = 0; i < Count && Entries[i].EntryDistance <= InOutDistance; ++i)
+    {
+        if (UPrimitiveComponent* HitComp = Entries[i].Node->RaycastWithKD(Ray, InOutDistance, MaxDepthKD, Stats))
+            ClosestComponent = HitComp;
+    }
     return ClosestComponent;
 }
 
-UPrimitiveComponent* FOctreeNode::RaycastWithKD(const FRay& Ray, float& OutDistance, int MaxDepthKD) const
+
+UPrimitiveComponent* FOctreeNode::RaycastLoose(const FRay& Ray, float& InOutDistance, FRaycastStats& Stats) const
 {
-    float NodeHitDist;
-    if (!RayIntersectsAABB(Ray, Bounds, NodeHitDist))
-        return nullptr;
+    ++Stats.NodesVisited;
 
-    // 리프 노드: KD 트리 사용
-    if (Depth == MaxDepthKD)
+    UPrimitiveComponent* ClosestComponent = nullptr;
+    for (UPrimitiveComponent* Comp : Components)
     {
-        if (KDTree)
+        ++Stats.PrimitivesTested;
+        float HitDist = FLT_MAX;
+        if (Comp->CheckRayIntersection(Ray.Origin, Ray.Direction, HitDist) && HitDist < InOutDistance)
         {
-            float HitDist = FLT_MAX;
-            UPrimitiveComponent* KDHit = KDTree->Raycast(Ray, HitDist);
-            if (KDHit)
-            {
-                OutDistance = HitDist;
-                return KDHit; // ✅ 바로 종료
-            }
+            InOutDistance = HitDist;
+            ClosestComponent = Comp;
         }
+    }
 
-        return nullptr;
+    // 자식의 LooseBounds가 하위 컴포넌트를 모두 포함하므로 InOutDistance로 가지치기해도 정확함
+    FRayChildEntry Entries[8];
+    const int32 Count = SortChildrenByEntry(this, Ray, InOutDistance, true, Entries);
+    for (int32 i = 0; i < Count && Entries[i].EntryDistance <= InOutDistance; ++i)
+    {
+        if (UPrimitiveComponent* HitComp = Entries[i].Node->RaycastLoose(Ray, InOutDistance, Stats))
+            ClosestComponent = HitComp;
     }
+    return ClosestComponent;
+}
 
-    // 내부 노드: 자식 노드를 정렬하여 거리순으로 검사
-    struct FChildAndDist
+// 영역 질의용 어댑터. Classify는 노드 경계 전체가 영역 안(Contains)/밖(Outside)/걸침(Intersects)인지,
+// Overlaps는 컴포넌트 AABB와 겹치는지 판단
+struct FBoxQueryRegion
+{
+    const FBoundingBox& Box;
+
+    EFrustumContainment Classify(const FBoundingBox& Bounds) const
     {
-        const FOctreeNode* Node;
-        float Dist;
+        if (!Box.Overlaps(Bounds)) return EFrustumContainment::Outside;
+        return Box.Contains(Bounds) ? EFrustumContainment::Contains : EFrustumContainment::Intersects;
+    }
+    bool Overlaps(const FBoundingBox& AABB) const { return Box.Overlaps(AABB); }
+};
 
-        bool operator<(const FChildAndDist& Other) const { return Dist < Other.Dist; }
-    };
+struct FSphereQueryRegion
+{
+    const FSphere& Sphere;
 
-    TArray<FChildAndDist> SortedChildren;
-    for (int i = 0; i < 8; ++i)
+    EFrustumContainment Classify(const FBoundingBox& Bounds) const
     {
-        if (Children[i])
+        if (!Bounds.Overlaps(Sphere)) return EFrustumContainment::Outside;
+
+        // 중심에서 가장 먼 꼭짓점까지 반지름 안이면 전체 포함
+        float FarDistSq = 0.0f;
+        for (int i = 0; i < 3; ++i)
         {
-            const FVector Center = Children[i]->Bounds.GetCenter();
-            float Dist = (Center - Ray.Origin).Magnitude(); // 또는 Dot으로 방향성 포함
-            SortedChildren.Add({Children[i], Dist});
+            const float Far = FMath::Max(FMath::Abs(Sphere.Center[i] - Bounds.min[i]), FMath::Abs(Sphere.Center[i] - Bounds.max[i]));
+            FarDistSq += Far * Far;
         }
+        return FarDistSq <= Sphere.Radius * Sphere.Radius ? EFrustumContainment::Contains : EFrustumContainment::Intersects;
+    }
+    bool Overlaps(const FBoundingBox& AABB) const { return AABB.Overlaps(Sphere); }
+};
+
+struct FFrustumQueryRegion
+{
+    const FFrustum& Frustum;
+
+    EFrustumContainment Classify(const FBoundingBox& Bounds) const { return Frustum.CheckContainment(Bounds); }
+    bool Overlaps(const FBoundingBox& AABB) const { return Frustum.CheckContainment(AABB) != EFrustumContainment::Outside; }
+};
+
+// Loose 모드: 하위 트리의 Components 전부 (LooseBounds가 영역 안이면 검사 없이 추가)
+static void CollectSubtreeComponents(const FOctreeNode* Node, TArray<UPrimitiveComponent*>& OutComponents)
+{
+    OutComponents.Append(Node->Components);
+    for (const FOctreeNode* Child : Node->Children)
+    {
+        if (Child)
+            CollectSubtreeComponents(Child, OutComponents);
+    }
+}
+
+template <typename RegionType>
+static void QueryRegionLoose(const FOctreeNode* Node, const RegionType& Region, TArray<UPrimitiveComponent*>& OutComponents)
+{
+    const EFrustumContainment Containment = Region.Classify(Node->LooseBounds);
+    if (Containment == EFrustumContainment::Outside)
+        return;
+    if (Containment == EFrustumContainment::Contains)
+    {
+        CollectSubtreeComponents(Node, OutComponents);
+        return;
+    }
+
+    for (UPrimitiveComponent* Comp : Node->Components)
+    {
+        if (Region.Overlaps(Comp->WorldAABB))
+            OutComponents.Add(Comp);
+    }
+    for (const FOctreeNode* Child : Node->Children)
+    {
+        if (Child)
+            QueryRegionLoose(Child, Region, OutComponents);
     }
+}
 
-    SortedChildren.Sort();
+// 일반 모드: 노드마다 겹치는 컴포넌트를 모두 가진 OverlappingComponents 사용.
+// 노드가 영역 안이면 그 노드와 겹치는 컴포넌트는 영역과도 겹치므로 더 내려가지 않음. 중복은 호출하는 쪽에서 제거
+template <typename RegionType>
+static void QueryRegionTight(const FOctreeNode* Node, const RegionType& Region, TArray<UPrimitiveComponent*>& OutComponents)
+{
+    const EFrustumContainment Containment = Region.Classify(Node->Bounds);
+    if (Containment == EFrustumContainment::Outside)
+        return;
+    if (Containment == EFrustumContainment::Contains)
+    {
+        OutComponents.Append(Node->OverlappingComponents);
+        return;
+    }
 
-    // 거리순으로 탐색 → 가장 가까운 곳에서 Hit 되면 종료
-    for (const FChildAndDist& Entry : SortedChildren)
+    if (Node->bIsLeaf)
     {
-        float ChildHitDist = FLT_MAX;
-        UPrimitiveComponent* HitComp = Entry.Node->RaycastWithKD(Ray, ChildHitDist, MaxDepthKD);
-        if (HitComp)
+        for (UPrimitiveComponent* Comp : Node->OverlappingComponents)
         {
-            OutDistance = ChildHitDist;
-            return HitComp; // ✅ 가장 가까운 곳에서 Hit되면 바로 반환
+            if (Region.Overlaps(Comp->WorldAABB))
+                OutComponents.Add(Comp);
         }
+        return;
+    }
+    for (const FOctreeNode* Child : Node->Children)
+    {
+        if (Child)
+            QueryRegionTight(Child, Region, OutComponents);
+    }
+}
+
+template <typename RegionType>
+static void QueryRegion(const FOctreeNode* Root, const RegionType& Region, TArray<UPrimitiveComponent*>& OutComponents)
+{
+    if (!Root) return;
+
+    const int32 StartIndex = OutComponents.Num();
+    if (Root->IsLoose())
+    {
+        // 컴포넌트는 한 노드만 소유하므로 중복 없음
+        QueryRegionLoose(Root, Region, OutComponents);
+    }
+    else
+    {
+        // 여러 리프에 걸친 컴포넌트 중복 제거. TSet 삽입은 선형이라 정렬 후 unique
+        QueryRegionTight(Root, Region, OutComponents);
+        auto Begin = OutComponents.begin() + StartIndex;
+        std::sort(Begin, OutComponents.end());
+        OutComponents.SetNum(static_cast<int32>(std::unique(Begin, OutComponents.end()) - OutComponents.begin()));
+    }
+    FStatRegistry::SetCounter("RegionQueryResults", OutComponents.Num() - StartIndex);
+}
+
+void FOctree::QueryAABB(const FBoundingBox& Box, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    QueryRegion(Root, FBoxQueryRegion{Box}, OutComponents);
+}
+
+void FOctree::QuerySphere(const FSphere& Sphere, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    QueryRegion(Root, FSphereQueryRegion{Sphere}, OutComponents);
+}
+
+void FOctree::QueryFrustum(const FFrustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    QueryRegion(Root, FFrustumQueryRegion{Frustum}, OutComponents);
+}
+
+// FindNearest에서 노드 하나 처리. Loose 모드는 자기 Components, 일반 모드는 리프의 OverlappingComponents
+static void CollectNearestInNode(const FOctreeNode* Node, bool bLoose, const FVector& Point, FNearestCollector& Collector, FRaycastStats& Stats)
+{
+    ++Stats.NodesVisited;
+    if (!bLoose && !Node->bIsLeaf)
+        return;
+
+    for (UPrimitiveComponent* Comp : bLoose ? Node->Components : Node->OverlappingComponents)
+    {
+        ++Stats.PrimitivesTested;
+        Collector.Add(Comp, PointToAABBDistanceSquared(Point, Comp->WorldAABB.min, Comp->WorldAABB.max), !bLoose);
     }
+}
+
+static float GetNearestNodeDistance(const FOctreeNode* Node, bool bLoose, const FVector& Point)
+{
+    const FBoundingBox& Bounds = bLoose ? Node->LooseBounds : Node->Bounds;
+    return PointToAABBDistanceSquared(Point, Bounds.min, Bounds.max);
+}
 
-    return nullptr;
+// 노드 큐가 가득 찼을 때 그 서브트리를 깊이 우선으로 처리
+static void FindNearestRecursive(const FOctreeNode* Node, bool bLoose, const FVector& Point, FNearestCollector& Collector, FRaycastStats& Stats)
+{
+    CollectNearestInNode(Node, bLoose, Point, Collector, Stats);
+    for (const FOctreeNode* Child : Node->Children)
+    {
+        if (Child && GetNearestNodeDistance(Child, bLoose, Point) <= Collector.GetBoundSquared())
+            FindNearestRecursive(Child, bLoose, Point, Collector, Stats);
+    }
 }
 
+int32 FOctree::FindNearest(const FVector& Point, int32 K, FNearestComponent* OutResults, float MaxDistance) const
+{
+    FNearestCollector Collector(OutResults, K, MaxDistance);
+    if (!Root || K <= 0) return 0;
+
+    // Loose 모드는 LooseBounds가 하위 컴포넌트 AABB를 모두 포함하고,
+    // 일반 모드는 컴포넌트의 최근접점을 포함하는 리프가 그 컴포넌트를 OverlappingComponents로 가지므로 노드 거리가 하한
+    const bool bLoose = Root->IsLoose();
+    FRaycastStats Stats;
+
+    using FNodeEntry = TNearestNodeEntry<const FOctreeNode*>;
+    constexpr int32 MaxQueue = 256;
+    FNodeEntry QueueData[MaxQueue];
+    TBoundedHeap<FNodeEntry, std::greater<>> Queue(QueueData, MaxQueue);
+    Queue.Push({Root, GetNearestNodeDistance(Root, bLoose, Point)});
+
+    while (!Queue.IsEmpty())
+    {
+        const FNodeEntry Entry = Queue.Pop();
+        // 큐에 남은 노드는 모두 이보다 멀다
+        if (Entry.DistanceSquared > Collector.GetBoundSquared())
+            break;
+
+        CollectNearestInNode(Entry.Node, bLoose, Point, Collector, Stats);
+        for (const FOctreeNode* Child : Entry.Node->Children)
+        {
+            if (!Child) continue;
+
+            const float ChildDistance = GetNearestNodeDistance(Child, bLoose, Point);
+            if (ChildDistance > Collector.GetBoundSquared())
+                continue;
+            if (!Queue.Push({Child, ChildDistance}))
+                FindNearestRecursive(Child, bLoose, Point, Collector, Stats);
+        }
+    }
+
+    FStatRegistry::SetCounter("NearestNodesVisited", Stats.NodesVisited);
+    FStatRegistry::SetCounter("NearestPrimitivesTested", Stats.PrimitivesTested);
+    return Collector.Finish();
+}
 
 void DebugRenderOctreeNode(UPrimitiveBatch* PrimitiveBatch, const FOctreeNode* Node, int MaxDepth)
 {
@@ -364,7 +834,68 @@ void DebugRenderOctreeNode(UPrimitiveBatch* PrimitiveBatch, const FOctreeNode* N
     }
 }
 
-void FOctreeNode::BuildBatchRenderData(FOctreeNode* RootNode)
+// 서브셋 인덱스에서 정점이 처음 등장하는 순서를 계산.
+// 원본 정점 수 크기의 표시 배열은 스레드마다 재사용하고, 건드린 칸(SourceVertices)만 -1로 되돌린다.
+static void BuildSubsetRemap(const OBJ::FStaticMeshRenderData* RenderData, const FMaterialSubset& Subset, FSubsetVertexRemap& OutRemap)
+{
+    thread_local TArray<int32> LocalOfSource;
+    if (LocalOfSource.Num() < RenderData->Vertices.Num())
+        LocalOfSource.Init(-1, RenderData->Vertices.Num());
+
+    OutRemap.SourceVertices.Empty();
+    OutRemap.LocalIndices.SetNum(Subset.IndexCount);
+    for (UINT j = 0; j < Subset.IndexCount; ++j)
+    {
+        const UINT OldIndex = RenderData->Indices[Subset.IndexStart + j];
+        int32& Local = LocalOfSource[OldIndex];
+        if (Local < 0)
+            Local = OutRemap.SourceVertices.Add(OldIndex);
+        OutRemap.LocalIndices[j] = static_cast<UINT>(Local);
+    }
+
+    for (const UINT Source : OutRemap.SourceVertices)
+        LocalOfSource[Source] = -1;
+}
+
+// 처음 등장한 순서대로 정점을 월드 변환해 VertexStart부터 기록.
+// 빌드와 증분 갱신이 같은 순서를 써야 기존 인덱스가 그대로 유효하다.
+static uint32 WriteSubsetVertices(const OBJ::FStaticMeshRenderData* RenderData, const FSubsetVertexRemap& Remap,
+                                  const FMatrix& ModelMatrix, TArray<FVertexCompact>& Vertices, uint32 VertexStart,
+                                  UINT* OutIndices)
+{
+    const uint32 VertexCount = static_cast<uint32>(Remap.SourceVertices.Num());
+    if (VertexStart + VertexCount > (uint32)Vertices.Num())
+        Vertices.SetNum(VertexStart + VertexCount);
+
+    for (uint32 i = 0; i < VertexCount; ++i)
+    {
+        FVertexCompact V = RenderData->Vertices[Remap.SourceVertices[i]];
+        const FVector WorldPos = ModelMatrix.TransformPosition(FVector(V.x, V.y, V.z));
+        V.x = WorldPos.x;
+        V.y = WorldPos.y;
+        V.z = WorldPos.z;
+        Vertices[VertexStart + i] = V;
+    }
+
+    if (OutIndices)
+    {
+        for (int32 j = 0; j < Remap.LocalIndices.Num(); ++j)
+            OutIndices[j] = VertexStart + Remap.LocalIndices[j];
+    }
+    return VertexCount;
+}
+
+// 증분 갱신용. 컴포넌트 하나만 다루므로 순서를 그 자리에서 계산 (스레드별 버퍼 재사용)
+static uint32 WriteSubsetVertices(const OBJ::FStaticMeshRenderData* RenderData, const FMaterialSubset& Subset,
+                                  const FMatrix& ModelMatrix, TArray<FVertexCompact>& Vertices, uint32 VertexStart,
+                                  UINT* OutIndices)
+{
+    thread_local FSubsetVertexRemap Remap;
+    BuildSubsetRemap(RenderData, Subset, Remap);
+    return WriteSubsetVertices(RenderData, Remap, ModelMatrix, Vertices, VertexStart, OutIndices);
+}
+
+void FOctreeNode::BuildBatchRenderData(FBatchBuildContext& Context, FOctreeNode* RootNode)
 {
     if (!RootNode)
         RootNode = this;
@@ -372,72 +903,61 @@ void FOctreeNode::BuildBatchRenderData(FOctreeNode* RootNode)
     VertexBufferSizeInBytes = 0;
     IndexBufferSizeInBytes = 0;
 
-    // LEAF 처리
-    if (bIsLeaf)
+    // 자기 Components 처리 (중심 기준 옥트리에서는 리프만 가짐). 자식보다 먼저 추가해 구간이 [자신][자식]이 되도록 함
+    for (UPrimitiveComponent* Comp : Components)
     {
-        for (UPrimitiveComponent* Comp : Components)
-        {
-            UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Comp);
-            if (!StaticMeshComp || !StaticMeshComp->GetStaticMesh()) continue;
-
-            for (int LOD = (int)ELODLevel::LOD0; LOD <= (int)ELODLevel::LOD2; ++LOD)
-            {
-                ELODLevel LODLevel = static_cast<ELODLevel>(LOD);
-                OBJ::FStaticMeshRenderData* RenderData = nullptr;
-
-                RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(LODLevel);
-                if (!RenderData) continue;
+        FComponentBatchRecord& Record = RootNode->CachedComponentRecords.FindOrAdd(Comp);
+        Record.Leaf = this;
+        Record.AABB = Comp->WorldAABB;
+        Record.Slices.Empty();
 
-                const auto& MeshVertices = RenderData->Vertices;
-                const auto& MeshIndices = RenderData->Indices;
-                const auto& Materials = RenderData->Materials;
-                const auto& Subsets = RenderData->MaterialSubsets;
+        UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Comp);
+        if (!StaticMeshComp || !StaticMeshComp->GetStaticMesh()) continue;
 
-                const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(
-                    StaticMeshComp->GetWorldLocation(),
-                    StaticMeshComp->GetWorldRotation(),
-                    StaticMeshComp->GetWorldScale()
-                );
+        for (int LOD = (int)ELODLevel::LOD0; LOD <= (int)ELODLevel::LOD2; ++LOD)
+        {
+            ELODLevel LODLevel = static_cast<ELODLevel>(LOD);
+            OBJ::FStaticMeshRenderData* RenderData = nullptr;
 
-                for (int i = 0; i < Subsets.Num(); ++i)
-                {
-                    const auto& Subset = Subsets[i];
-                    const auto& MatInfo = Materials[Subset.MaterialIndex];
-                    const FString& MatName = MatInfo.MTLName;
+            RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(LODLevel);
+            if (!RenderData) continue;
 
-                    // 루트에 버퍼 추가
-                    FRenderBatchRootData& RootBatch = RootNode->CachedBatchRootData.FindOrAdd(MatName);
-                    TArray<FVertexCompact>& Vertices = RootBatch.Vertices.FindOrAdd(LODLevel);
-                    TArray<UINT>& Indices = RootBatch.Indices.FindOrAdd(LODLevel);
+            const auto& Materials = RenderData->Materials;
+            const auto& Subsets = RenderData->MaterialSubsets;
 
-                    UINT VertexStart = (UINT)Vertices.Num();
-                    TMap<UINT, UINT> IndexMap;
-
-                    for (UINT j = 0; j < Subset.IndexCount; ++j)
-                    {
-                        UINT oldIndex = MeshIndices[Subset.IndexStart + j];
-                        if (!IndexMap.Contains(oldIndex))
-                        {
-                            FVertexCompact V = MeshVertices[oldIndex];
-                            FVector WorldPos = ModelMatrix.TransformPosition(FVector(V.x, V.y, V.z));
-                            V.x = WorldPos.x;
-                            V.y = WorldPos.y;
-                            V.z = WorldPos.z;
-
-                            Vertices.Add(V);
-                            IndexMap.Add(oldIndex, VertexStart++);
-                        }
-                        Indices.Add(IndexMap[oldIndex]);
-                    }
-
-                    // 이 노드에는 인덱스 수만 기록
-                    FRenderBatchNodeData& NodeData = CachedBatchNodeData.FindOrAdd(MatName);
-                    NodeData.MaterialInfo = MatInfo;
-                    NodeData.OwnerNode = this;
-
-                    FDrawRange& MyRange = NodeData.LODDrawRanges.FindOrAdd(LODLevel);
-                    MyRange.IndexCount += Subset.IndexCount;
-                }
+            for (int i = 0; i < Subsets.Num(); ++i)
+            {
+                const auto& Subset = Subsets[i];
+                const auto& MatInfo = Materials[Subset.MaterialIndex];
+                const FString& MatName = MatInfo.MTLName;
+
+                const bool bHasRemap = Context.SubsetRemaps.Contains(&Subset);
+                FSubsetVertexRemap& Remap = Context.SubsetRemaps.FindOrAdd(&Subset);
+                if (!bHasRemap)
+                    BuildSubsetRemap(RenderData, Subset, Remap);
+                const uint32 VertexCount = static_cast<uint32>(Remap.SourceVertices.Num());
+
+                // 루트 배열에 자리만 잡아두고 기록은 Job으로 미룸
+                FRenderBatchRootData& RootBatch = RootNode->CachedBatchRootData.FindOrAdd(MatName);
+                TArray<FVertexCompact>& Vertices = RootBatch.Vertices.FindOrAdd(LODLevel);
+                TArray<UINT>& Indices = RootBatch.Indices.FindOrAdd(LODLevel);
+
+                const UINT VertexStart = (UINT)Vertices.Num();
+                const UINT IndexStart = (UINT)Indices.Num();
+                Vertices.SetNum(VertexStart + VertexCount);
+                Indices.SetNum(IndexStart + Subset.IndexCount);
+                Context.Jobs.Add({StaticMeshComp, RenderData, i, MatName, LODLevel, VertexStart, IndexStart, &Remap});
+
+                Record.Slices.Add({MatName, LODLevel, i, VertexStart, VertexCount, Subset.IndexCount});
+
+                // 이 노드에는 인덱스 수만 기록
+                FRenderBatchNodeData& NodeData = CachedBatchNodeData.FindOrAdd(MatName);
+                NodeData.MaterialInfo = MatInfo;
+                NodeData.OwnerNode = this;
+
+                FDrawRange& MyRange = NodeData.LODDrawRanges.FindOrAdd(LODLevel);
+                MyRange.IndexCount += Subset.IndexCount;
+                MyRange.OwnIndexCount += Subset.IndexCount;
             }
         }
     }
@@ -446,7 +966,7 @@ void FOctreeNode::BuildBatchRenderData(FOctreeNode* RootNode)
     for (int i = 0; i < 8; ++i)
     {
         if (Children[i])
-            Children[i]->BuildBatchRenderData(RootNode);
+            Children[i]->BuildBatchRenderData(Context, RootNode);
     }
 
     // 자식 인덱스 정보 병합
@@ -489,8 +1009,9 @@ void FOctreeNode::BuildBatchBuffers(FRenderer& Renderer)
 
                 if (!Vertices.IsEmpty())
                 {
+                    // 증분 갱신(UpdateSubresource)을 위해 DEFAULT로 생성
                     ID3D11Buffer* VB = Renderer.CreateVertexBuffer(
-                        Vertices, Vertices.Num() * sizeof(FVertexCompact));
+                        Vertices, Vertices.Num() * sizeof(FVertexCompact), D3D11_USAGE_DEFAULT);
                     RenderData.VertexBuffers.Add(LOD, VB);
                 }
             }
@@ -503,7 +1024,7 @@ void FOctreeNode::BuildBatchBuffers(FRenderer& Renderer)
                 if (!Indices.IsEmpty())
                 {
                     ID3D11Buffer* IB = Renderer.CreateIndexBuffer(
-                        Indices, Indices.Num() * sizeof(UINT));
+                        Indices, Indices.Num() * sizeof(UINT), D3D11_USAGE_DEFAULT);
                     RenderData.IndexBuffers.Add(LOD, IB);
                 }
             }
@@ -530,14 +1051,56 @@ void FOctreeNode::ClearKDDatas(int MaxDepthKD)
     }
 }
 
-void FOctreeNode::CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes)
+void FOctreeNode::CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes)
 {
-    EFrustumContainment Containment = Frustum.CheckContainment(Bounds);
-    if (Containment == EFrustumContainment::Contains ||
-        (Containment == EFrustumContainment::Intersects && Depth == GRenderDepthMax))
-    {
+    uint8 PlaneMask = FFrustum::AllPlanesMask;
+    const EFrustumContainment Containment = Frustum.CheckContainment(LooseBounds, PlaneMask, LastOutsidePlane);
+    CollectRenderNodes(Frustum, Containment, PlaneMask, OutNodes, OutOwnNodes);
+}
+
+void FOctreeNode::CheckChildrenContainment(const FFrustum& Frustum, uint8 PlaneMask, EFrustumContainment OutResults[8], uint8 OutPlaneMasks[8])
+{
+    FBoundingBox ChildBounds[8];
+    int ChildSlots[8];
+    int ChildCount = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        OutResults[i] = EFrustumContainment::Outside;
+        OutPlaneMasks[i] = 0;
+
+        FOctreeNode* Child = Children[i];
+        if (!Child) continue;
+
+        // 지난 프레임에 거부한 평면으로 먼저 거름. 부모가 그 평면 안쪽이면 자식도 밖일 수 없음
+        const uint8 Plane = Child->LastOutsidePlane;
+        if (Plane != FFrustum::NoPlane && (PlaneMask & (1 << Plane)) && Frustum.IsOutsidePlane(Child->LooseBounds, Plane))
+            continue;
+
+        ChildBounds[ChildCount] = Child->LooseBounds;
+        ChildSlots[ChildCount++] = i;
+    }
+    if (ChildCount == 0) return;
+
+    EFrustumContainment Results[8];
+    uint8 PlaneMasks[8];
+    uint8 OutsidePlanes[8];
+    Frustum.CheckContainmentBatch(ChildBounds, ChildCount, Results, PlaneMask, PlaneMasks, OutsidePlanes);
+    for (int c = 0; c < ChildCount; ++c)
+    {
+        const int Slot = ChildSlots[c];
+        OutResults[Slot] = Results[c];
+        OutPlaneMasks[Slot] = PlaneMasks[c];
+        Children[Slot]->LastOutsidePlane = OutsidePlanes[c];
+    }
+}
+
+void FOctreeNode::CollectRenderNodes(const FFrustum& Frustum, EFrustumContainment Containment, uint8 PlaneMask, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes)
+{
+    if (Containment == EFrustumContainment::Contains ||
+        (Containment == EFrustumContainment::Intersects && Depth == GRenderDepthMax))
+    {
         //UE_LOG(LogLevel::Display, "CollectRenderNodes! %d", NodeId);
-        if (!GOcclusionSystem->IsRegionVisible(NodeId))
+        if (!IsOctreeRegionVisible(NodeId, LooseBounds))
         {
             //UE_LOG(LogLevel::Display, "Occlusion Cull %d", NodeId);
             //UE_LOG(LogLevel::Display, "Depth Level %d", Depth);
@@ -551,14 +1114,71 @@ void FOctreeNode::CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode
         }
     }
     if (Containment == EFrustumContainment::Outside || Depth == GRenderDepthMax)return;
+
+    // 통째로 그리지 않고 자식으로 내려가는 경우 자기 구간은 따로 그려야 함
+    if (OutOwnNodes && !Components.IsEmpty())
+        OutOwnNodes->Add(this);
+
+    // 자식 8개를 한 번에 컬링. 걸친 평면이 없으면(부모가 완전히 포함) 자식 LooseBounds도 포함되므로 검사 생략
+    EFrustumContainment ChildContainments[8];
+    uint8 ChildPlaneMasks[8];
+    if (PlaneMask == 0)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            ChildContainments[i] = EFrustumContainment::Contains;
+            ChildPlaneMasks[i] = 0;
+        }
+    }
+    else
+    {
+        CheckChildrenContainment(Frustum, PlaneMask, ChildContainments, ChildPlaneMasks);
+    }
+
     for (int i = 0; i < 8; ++i)
     {
-        if (Children[i])
-            Children[i]->CollectRenderNodes(Frustum, OutNodes);
+        if (Children[i] && ChildContainments[i] != EFrustumContainment::Outside)
+            Children[i]->CollectRenderNodes(Frustum, ChildContainments[i], ChildPlaneMasks[i], OutNodes, OutOwnNodes);
     }
 }
 
-void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray<FOctreeNode*>& RenderNodes, const FOctreeNode* RootNode)
+ELODLevel FOctreeNode::SelectLOD(const FLODSelectionParams& Params)
+{
+    if (LODFrame == GCurrentFrame)
+        return LODLevel;
+
+    // 투영 반지름(픽셀). 카메라가 경계 구 안이면 가장 정밀한 LOD
+    const float Distance = Params.CameraLocation.Distance(BoundingSphere.Center);
+    float ScreenRadius = FLT_MAX;
+    if (Params.bOrthographic)
+        ScreenRadius = BoundingSphere.Radius * Params.ProjectionScale;
+    else if (Distance > BoundingSphere.Radius)
+        ScreenRadius = BoundingSphere.Radius * Params.ProjectionScale / Distance;
+
+    // Scale배 한 임계값 기준으로 몇 단계 거친 LOD인지
+    auto ComputeLOD = [ScreenRadius](float Scale)
+    {
+        return static_cast<int>(ScreenRadius < GLOD1ScreenRadius * Scale) + static_cast<int>(ScreenRadius < GLOD2ScreenRadius * Scale);
+    };
+
+    // 거친 쪽으로는 임계값보다 충분히 작아져야, 정밀한 쪽으로는 충분히 커져야 바꿈
+    const int Current = static_cast<int>(LODLevel);
+    int Target = ComputeLOD(1.0f);
+    if (LODFrame >= 0)
+    {
+        if (Target > Current)
+            Target = FMath::Max(Current, ComputeLOD(1.0f - GLODHysteresis));
+        else if (Target < Current)
+            Target = FMath::Min(Current, ComputeLOD(1.0f + GLODHysteresis));
+    }
+
+    LODLevel = static_cast<ELODLevel>(Target);
+    LODFrame = GCurrentFrame;
+    return LODLevel;
+}
+
+void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray<FOctreeNode*>& RenderNodes,
+                            const TArray<FOctreeNode*>& OwnRenderNodes, const FOctreeNode* RootNode)
 {
     if (!RootNode) return;
 
@@ -568,21 +1188,30 @@ void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray
 
     const TMap<FString, FRenderBatchRootData>& RootBatches = RootNode->CachedBatchRootData;
 
-    FVector CameraPos = GEngineLoop.GetLevelEditor()->GetActiveViewportClient()->ViewTransformPerspective.GetLocation();
+    // LOD 기준은 활성 뷰포트의 카메라와 투영
+    const std::shared_ptr<FEditorViewportClient> ActiveViewport = GEngineLoop.GetLevelEditor()->GetActiveViewportClient();
+    const float ViewportHeight = ActiveViewport->GetD3DViewport().Height;
+    FLODSelectionParams LODParams;
+    LODParams.bOrthographic = ActiveViewport->IsOrtho();
+    if (LODParams.bOrthographic)
+    {
+        // 직교 투영의 M[1][1] = 2 / 화면 세로 월드 길이
+        LODParams.CameraLocation = ActiveViewport->ViewTransformOrthographic.GetLocation();
+        LODParams.ProjectionScale = 0.5f * ViewportHeight * ActiveViewport->GetProjectionMatrix().M[1][1];
+    }
+    else
+    {
+        LODParams.CameraLocation = ActiveViewport->ViewTransformPerspective.GetLocation();
+        LODParams.ProjectionScale = ViewportHeight / (2.0f * FMath::Tan(FMath::DegreesToRadians(ActiveViewport->ViewFOV) * 0.5f));
+    }
 
-    // 1. Material → LOD → Node 리스트로 정리
-    TMap<FString, TMap<ELODLevel, TArray<const FOctreeNode*>>> MaterialLODMap;
+    // 1. Material → LOD → DrawRange 리스트로 정리
+    TMap<FString, TMap<ELODLevel, TArray<FDrawRange>>> MaterialLODMap;
+    TMap<FString, const FObjMaterialInfo*> MaterialInfos;
 
-    for (const FOctreeNode* Node : RenderNodes)
+    auto AddNodeRanges = [&](FOctreeNode* Node, bool bOwnOnly)
     {
-        FVector NodePos = Node->Bounds.GetCenter();
-        float Distance = CameraPos.Distance(NodePos);
-
-        ELODLevel LODLevel = (Distance < GEngineLoop.firstLOD)
-                                 ? ELODLevel::LOD0
-                                 : (Distance < GEngineLoop.firstLOD + GEngineLoop.SecondLOD)
-                                 ? ELODLevel::LOD1
-                                 : ELODLevel::LOD2;
+        const ELODLevel LODLevel = Node->SelectLOD(LODParams);
 
         for (const auto& Pair : Node->CachedBatchNodeData)
         {
@@ -590,12 +1219,23 @@ void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray
             const FRenderBatchNodeData& NodeBatch = Pair.Value;
 
             const FDrawRange* Range = NodeBatch.LODDrawRanges.Find(LODLevel);
-            if (!Range || Range->IndexCount == 0)
+            if (!Range)
                 continue;
 
-            MaterialLODMap.FindOrAdd(MatKey).FindOrAdd(LODLevel).Add(Node);
+            const uint32 Count = bOwnOnly ? Range->OwnIndexCount : Range->IndexCount;
+            if (Count == 0)
+                continue;
+
+            MaterialLODMap.FindOrAdd(MatKey).FindOrAdd(LODLevel).Add(FDrawRange{Range->IndexStart, Count});
+            if (!MaterialInfos.Contains(MatKey))
+                MaterialInfos.Add(MatKey, &NodeBatch.MaterialInfo);
         }
-    }
+    };
+
+    for (FOctreeNode* Node : RenderNodes)
+        AddNodeRanges(Node, false);
+    for (FOctreeNode* Node : OwnRenderNodes)
+        AddNodeRanges(Node, true);
 
     // 2. Material + LOD 단위로 버퍼 설정 1회 → DrawIndexed 반복
     for (const auto& MatPair : MaterialLODMap)
@@ -608,22 +1248,13 @@ void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray
             continue;
 
         // 머티리얼 설정 (첫 노드 기준)
-        const FRenderBatchNodeData* FirstBatch = nullptr;
-        for (const auto& LODPair : LODMap)
-        {
-            if (!LODPair.Value.IsEmpty())
-            {
-                FirstBatch = LODPair.Value[0]->CachedBatchNodeData.Find(MatKey);
-                break;
-            }
-        }
-        if (FirstBatch)
-            Renderer.UpdateMaterial(FirstBatch->MaterialInfo);
+        if (const FObjMaterialInfo* const* MatInfo = MaterialInfos.Find(MatKey))
+            Renderer.UpdateMaterial(**MatInfo);
 
         for (const auto& LODPair : LODMap)
         {
             ELODLevel LOD = LODPair.Key;
-            const TArray<const FOctreeNode*>& Nodes = LODPair.Value;
+            const TArray<FDrawRange>& Ranges = LODPair.Value;
 
             ID3D11Buffer* VB = RootBatch->VertexBuffers.Contains(LOD) ? RootBatch->VertexBuffers[LOD] : nullptr;
             ID3D11Buffer* IB = RootBatch->IndexBuffers.Contains(LOD) ? RootBatch->IndexBuffers[LOD] : nullptr;
@@ -634,16 +1265,9 @@ void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray
             Renderer.Graphics->DeviceContext->IASetVertexBuffers(0, 1, &VB, &Renderer.Stride, &offset);
             Renderer.Graphics->DeviceContext->IASetIndexBuffer(IB, DXGI_FORMAT_R32_UINT, 0);
 
-            for (const FOctreeNode* Node : Nodes)
+            for (const FDrawRange& Range : Ranges)
             {
-                const FRenderBatchNodeData* NodeBatch = Node->CachedBatchNodeData.Find(MatKey);
-                if (!NodeBatch) continue;
-
-                const FDrawRange* Range = NodeBatch->LODDrawRanges.Find(LOD);
-                if (!Range || Range->IndexCount == 0)
-                    continue;
-
-                Renderer.Graphics->DeviceContext->DrawIndexed(Range->IndexCount, Range->IndexStart, 0);
+                Renderer.Graphics->DeviceContext->DrawIndexed(Range.IndexCount, Range.IndexStart, 0);
             }
         }
     }
@@ -771,7 +1395,7 @@ void FOctreeNode::TickBuffers(int CurrentFrame, int FrameThreshold)
 */
 void FOctreeNode::QueryOcclusion(FRenderer& Renderer, ID3D11DeviceContext* Context, const FFrustum& Frustum)
 {
-    EFrustumContainment Containment = Frustum.CheckContainment(Bounds);
+    EFrustumContainment Containment = Frustum.CheckContainment(LooseBounds);
     if (Containment == EFrustumContainment::Contains || Containment == EFrustumContainment::Intersects && Depth == GRenderDepthMax)
     {
         if (Depth > GRenderDepthMax)
@@ -784,7 +1408,7 @@ void FOctreeNode::QueryOcclusion(FRenderer& Renderer, ID3D11DeviceContext* Conte
         //    return;
 
         // Z-Depth 기반 Occlusion Query 등록
-        GOcclusionSystem->QueryRegion(NodeId, Bounds, Context, [&](const FBoundingBox& Box) {
+        GOcclusionSystem->QueryRegion(NodeId, LooseBounds, Context, [&](const FBoundingBox& Box) {
             Renderer.RenderOcclusionBox(Box, 1.1f);
             });
 
@@ -860,58 +1484,51 @@ std::string FOctreeNode::DumpLODRangeRecursive(int MaxDepth, int IndentLevel) co
 
 void FOctreeNode::AssignAllDrawRangesLODWrapped()
 {
+    TArray<FString> MatNames;
     for (const auto& Pair : CachedBatchNodeData)
-    {
-        const FString& MatName = Pair.Key;
-        const FRenderBatchNodeData& Batch = Pair.Value;
+        MatNames.Add(Pair.Key);
 
-        // LOD별로 반복
-        for (const auto& LODPair : Batch.LODDrawRanges)
-        {
-            ELODLevel LOD = LODPair.Key;
-            const FDrawRange& ThisLODRange = LODPair.Value;
+    for (const FString& MatName : MatNames)
+        AssignDrawRangesLODWrapped(MatName);
+}
 
-            // 루트 노드의 시작점은 항상 0
-            FDrawRange MyRange;
-            MyRange.IndexStart = 0;
-            MyRange.IndexCount = ThisLODRange.IndexCount;
+void FOctreeNode::AssignDrawRangesLODWrapped(const FString& MatName)
+{
+    FRenderBatchNodeData* MyBatch = CachedBatchNodeData.Find(MatName);
+    if (!MyBatch) return;
 
-            FRenderBatchNodeData& MyBatch = CachedBatchNodeData[MatName];
-            MyBatch.LODDrawRanges[LOD] = MyRange;
-        }
+    // 루트 노드의 시작점은 항상 0. 자식 구간은 루트 자신의 구간 뒤에서 시작
+    TMap<ELODLevel, uint32> RunningStart;
+    for (auto& LODPair : MyBatch->LODDrawRanges)
+    {
+        LODPair.Value.IndexStart = 0;
+        RunningStart.Add(LODPair.Key, LODPair.Value.OwnIndexCount);
     }
 
     // 자식에게 분배
-    for (const auto& Pair : CachedBatchNodeData)
-    {
-        const FString& MatName = Pair.Key;
-        const FRenderBatchNodeData& Batch = Pair.Value;
-
-        TMap<ELODLevel, uint32> RunningStart;
 
-        for (int i = 0; i < 8; ++i)
-        {
-            if (!Children[i]) continue;
+    for (int i = 0; i < 8; ++i)
+    {
+        if (!Children[i]) continue;
 
-            auto* ChildBatch = Children[i]->CachedBatchNodeData.Find(MatName);
-            if (!ChildBatch) continue;
+        auto* ChildBatch = Children[i]->CachedBatchNodeData.Find(MatName);
+        if (!ChildBatch) continue;
 
-            TMap<ELODLevel, FDrawRange> LODRangeMap;
+        TMap<ELODLevel, FDrawRange> LODRangeMap;
 
-            for (const auto& LODPair : ChildBatch->LODDrawRanges)
-            {
-                ELODLevel LOD = LODPair.Key;
-                uint32 Count = LODPair.Value.IndexCount;
-                if (Count == 0) continue;
-
-                uint32 Start = RunningStart.FindOrAdd(LOD);
-                LODRangeMap.Add(LOD, FDrawRange{Start, Count});
+        for (const auto& LODPair : ChildBatch->LODDrawRanges)
+        {
+            ELODLevel LOD = LODPair.Key;
+            uint32 Count = LODPair.Value.IndexCount;
+            if (Count == 0) continue;
 
-                RunningStart[LOD] += Count;
-            }
+            uint32 Start = RunningStart.FindOrAdd(LOD);
+            LODRangeMap.Add(LOD, FDrawRange{Start, Count});
 
-            Children[i]->ComputeDrawRangesFromParentLODWrapped(MatName, LODRangeMap);
+            RunningStart[LOD] += Count;
         }
+
+        Children[i]->ComputeDrawRangesFromParentLODWrapped(MatName, LODRangeMap);
     }
 }
 
@@ -928,24 +1545,16 @@ void FOctreeNode::ComputeDrawRangesFromParentLODWrapped(
         ELODLevel LOD = LODPair.Key;
         const FDrawRange& ParentRange = LODPair.Value;
 
-        uint32 Count = 0;
-        if (const FDrawRange* Found = MyBatch->LODDrawRanges.Find(LOD))
-        {
-            Count = Found->IndexCount;
-        }
-
-        FDrawRange MyRange;
+        FDrawRange& MyRange = MyBatch->LODDrawRanges.FindOrAdd(LOD);
         MyRange.IndexStart = ParentRange.IndexStart;
-        MyRange.IndexCount = Count;
-
-        MyBatch->LODDrawRanges[LOD] = MyRange;
     }
 
-    // 자식 분배
+    // 자식 분배. 자기 구간 뒤부터 시작
     TMap<ELODLevel, uint32> RunningStart;
     for (const auto& LODPair : InRanges)
     {
-        RunningStart.Add(LODPair.Key, LODPair.Value.IndexStart);
+        const FDrawRange* MyRange = MyBatch->LODDrawRanges.Find(LODPair.Key);
+        RunningStart.Add(LODPair.Key, LODPair.Value.IndexStart + (MyRange ? MyRange->OwnIndexCount : 0));
     }
 
     for (int i = 0; i < 8; ++i)
@@ -993,3 +1602,572 @@ void FOctreeNode::ClearBatchDatas()
         RenderData.Indices.Empty();
     }
 }
+
+
+// ---------------------------------------------------------------------------------
+// 증분 갱신
+// ---------------------------------------------------------------------------------
+
+// 한 (머티리얼, LOD) 배열에서 갱신이 필요한 구간 [Begin, End)
+struct FBatchDirtyRange
+{
+    uint32 Begin = UINT32_MAX;
+    uint32 End = 0;
+
+    void Add(uint32 InBegin, uint32 InEnd)
+    {
+        Begin = FMath::Min(Begin, InBegin);
+        End = FMath::Max(End, InEnd);
+    }
+    bool IsEmpty() const { return Begin >= End; }
+};
+
+using FBatchDirtyMap = TMap<FString, TMap<ELODLevel, FBatchDirtyRange>>;
+
+// 컴포넌트가 한 (머티리얼, LOD) 인덱스 배열에서 차지하는 연속 구간
+struct FComponentRun
+{
+    FString MatName;
+    ELODLevel LOD = ELODLevel::LOD0;
+    uint32 Start = 0;
+    uint32 Count = 0;
+    int32 SliceIndex = 0; // 머티리얼 정보를 얻을 대표 슬라이스
+};
+
+// 같은 (머티리얼, LOD)의 서브셋은 빌드 시 연달아 추가되므로 하나의 구간으로 묶을 수 있음
+static void GatherComponentRuns(const FComponentBatchRecord& Record, TArray<FComponentRun>& OutRuns)
+{
+    for (int32 i = 0; i < Record.Slices.Num(); ++i)
+    {
+        const FComponentBatchSlice& Slice = Record.Slices[i];
+
+        FComponentRun* Found = nullptr;
+        for (FComponentRun& Run : OutRuns)
+        {
+            if (Run.LOD == Slice.LOD && Run.MatName == Slice.MatName)
+            {
+                Found = &Run;
+                break;
+            }
+        }
+        if (Found)
+            Found->Count += Slice.IndexCount;
+        else
+            OutRuns.Add({Slice.MatName, Slice.LOD, 0, Slice.IndexCount, i});
+    }
+}
+
+static uint32 GetRunCount(const FComponentBatchRecord& Record, const FString& MatName, ELODLevel LOD)
+{
+    uint32 Count = 0;
+    for (const FComponentBatchSlice& Slice : Record.Slices)
+    {
+        if (Slice.LOD == LOD && Slice.MatName == MatName)
+            Count += Slice.IndexCount;
+    }
+    return Count;
+}
+
+static const FDrawRange* FindNodeRange(const FOctreeNode* Node, const FString& MatName, ELODLevel LOD)
+{
+    const FRenderBatchNodeData* Data = Node->CachedBatchNodeData.Find(MatName);
+    return Data ? Data->LODDrawRanges.Find(LOD) : nullptr;
+}
+
+static uint32 GetNodeIndexCount(const FOctreeNode* Node, const FString& MatName, ELODLevel LOD)
+{
+    const FDrawRange* Range = FindNodeRange(Node, MatName, LOD);
+    return Range ? Range->IndexCount : 0;
+}
+
+// 현재 노드별 IndexCount 기준으로 Component의 인덱스 구간 시작 위치를 계산.
+// 조상들의 자기 구간 + DFS 순서상 앞선 형제 서브트리 + 같은 노드에서 앞선 컴포넌트들의 합
+static uint32 GetRunStart(const FOctreeNode* RootNode, const FOctreeNode* Leaf, const UPrimitiveComponent* Component,
+                          const FString& MatName, ELODLevel LOD)
+{
+    uint32 Start = 0;
+    for (const FOctreeNode* Node = Leaf; Node->Parent; Node = Node->Parent)
+    {
+        if (const FDrawRange* ParentRange = FindNodeRange(Node->Parent, MatName, LOD))
+            Start += ParentRange->OwnIndexCount;
+
+        for (int i = 0; i < Node->ChildIndex; ++i)
+        {
+            if (const FOctreeNode* Sibling = Node->Parent->Children[i])
+                Start += GetNodeIndexCount(Sibling, MatName, LOD);
+        }
+    }
+
+    for (UPrimitiveComponent* Other : Leaf->Components)
+    {
+        if (Other == Component) break;
+        if (const FComponentBatchRecord* OtherRecord = RootNode->CachedComponentRecords.Find(Other))
+            Start += GetRunCount(*OtherRecord, MatName, LOD);
+    }
+    return Start;
+}
+
+// Leaf부터 루트까지 IndexCount를 Delta만큼 조정. MatInfo가 없으면 기존 데이터만 수정
+static void AddNodeIndexCount(FOctreeNode* Leaf, const FString& MatName, ELODLevel LOD, int64 Delta, const FObjMaterialInfo* MatInfo)
+{
+    for (FOctreeNode* Node = Leaf; Node; Node = Node->Parent)
+    {
+        FRenderBatchNodeData* Data = MatInfo ? &Node->CachedBatchNodeData.FindOrAdd(MatName) : Node->CachedBatchNodeData.Find(MatName);
+        if (!Data) continue;
+        if (MatInfo)
+        {
+            Data->MaterialInfo = *MatInfo;
+            Data->OwnerNode = Node;
+        }
+
+        FDrawRange& Range = Data->LODDrawRanges.FindOrAdd(LOD);
+        Range.IndexCount = static_cast<uint32>(Range.IndexCount + Delta);
+        if (Node == Leaf)
+            Range.OwnIndexCount = static_cast<uint32>(Range.OwnIndexCount + Delta);
+    }
+}
+
+static const FObjMaterialInfo* GetSliceMaterial(UPrimitiveComponent* Component, const FComponentBatchSlice& Slice)
+{
+    UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component);
+    if (!StaticMeshComp || !StaticMeshComp->GetStaticMesh()) return nullptr;
+
+    const OBJ::FStaticMeshRenderData* RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(Slice.LOD);
+    if (!RenderData) return nullptr;
+
+    return &RenderData->Materials[RenderData->MaterialSubsets[Slice.SubsetIndex].MaterialIndex];
+}
+
+// [From, From+Count) 구간을 To 위치(이동 후 기준)로 옮김. 사이의 인덱스만 밀려남
+static void MoveIndexRun(TArray<UINT>& Indices, uint32 From, uint32 Count, uint32 To, FBatchDirtyRange& Dirty)
+{
+    UINT* Data = Indices.GetData();
+    if (To > From)
+    {
+        std::rotate(Data + From, Data + From + Count, Data + To + Count);
+        Dirty.Add(From, To + Count);
+    }
+    else if (To < From)
+    {
+        std::rotate(Data + To, Data + From, Data + From + Count);
+        Dirty.Add(To, From + Count);
+    }
+}
+
+// 이전/현재 AABB 기준으로 OverlappingComponents 갱신. 거친 노드는 KDTree를 다시 빌드해야 함
+static void UpdateOverlappingRecursive(FOctreeNode* Node, UPrimitiveComponent* Component,
+                                       const FBoundingBox* OldAABB, const FBoundingBox* NewAABB,
+                                       TSet<FOctreeNode*>& OutDirtyNodes)
+{
+    const bool bOld = OldAABB && Node->Bounds.Overlaps(*OldAABB);
+    const bool bNew = NewAABB && Node->Bounds.Overlaps(*NewAABB);
+    if (!bOld && !bNew)
+        return;
+
+    if (bOld && !bNew)
+        Node->OverlappingComponents.Remove(Component);
+    else if (!bOld && bNew)
+        Node->OverlappingComponents.Add(Component);
+    OutDirtyNodes.Add(Node);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        if (Node->Children[i])
+            UpdateOverlappingRecursive(Node->Children[i], Component, OldAABB, NewAABB, OutDirtyNodes);
+    }
+}
+
+// 분할로 새로 생긴 자식들은 부모의 OverlappingComponents 중 겹치는 것만 물려받음
+static void InheritOverlappingRecursive(FOctreeNode* Node, TSet<FOctreeNode*>& OutDirtyNodes)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        FOctreeNode* Child = Node->Children[i];
+        if (!Child) continue;
+
+        for (UPrimitiveComponent* Comp : Node->OverlappingComponents)
+        {
+            if (Child->Bounds.Overlaps(Comp->WorldAABB))
+                Child->OverlappingComponents.Add(Comp);
+        }
+        OutDirtyNodes.Add(Child);
+        InheritOverlappingRecursive(Child, OutDirtyNodes);
+    }
+}
+
+static void UploadVertexRegion(FRenderer& Renderer, ID3D11Buffer*& Buffer, const TArray<FVertexCompact>& Vertices, const FBatchDirtyRange& Range)
+{
+    if (Range.IsEmpty() || Vertices.IsEmpty()) return;
+
+    const UINT RequiredBytes = Vertices.Num() * sizeof(FVertexCompact);
+    D3D11_BUFFER_DESC Desc = {};
+    if (Buffer) Buffer->GetDesc(&Desc);
+
+    // 컴포넌트가 추가되어 배열이 커진 경우만 버퍼를 다시 생성
+    if (!Buffer || Desc.ByteWidth < RequiredBytes)
+    {
+        if (Buffer) Buffer->Release();
+        Buffer = Renderer.CreateVertexBuffer(Vertices, RequiredBytes, D3D11_USAGE_DEFAULT);
+        return;
+    }
+
+    const uint32 End = FMath::Min(Range.End, (uint32)Vertices.Num());
+    if (End <= Range.Begin) return;
+    Renderer.UpdateBufferRegion(Buffer, Vertices.GetData() + Range.Begin,
+                                Range.Begin * sizeof(FVertexCompact), (End - Range.Begin) * sizeof(FVertexCompact));
+}
+
+static void UploadIndexRegion(FRenderer& Renderer, ID3D11Buffer*& Buffer, const TArray<UINT>& Indices, const FBatchDirtyRange& Range)
+{
+    if (Range.IsEmpty() || Indices.IsEmpty()) return;
+
+    const UINT RequiredBytes = Indices.Num() * sizeof(UINT);
+    D3D11_BUFFER_DESC Desc = {};
+    if (Buffer) Buffer->GetDesc(&Desc);
+
+    if (!Buffer || Desc.ByteWidth < RequiredBytes)
+    {
+        if (Buffer) Buffer->Release();
+        Buffer = Renderer.CreateIndexBuffer(Indices, RequiredBytes, D3D11_USAGE_DEFAULT);
+        return;
+    }
+
+    // 제거로 배열이 줄어든 경우 버퍼 뒤쪽은 DrawRange 밖이므로 그대로 둠
+    const uint32 End = FMath::Min(Range.End, (uint32)Indices.Num());
+    if (End <= Range.Begin) return;
+    Renderer.UpdateBufferRegion(Buffer, Indices.GetData() + Range.Begin,
+                                Range.Begin * sizeof(UINT), (End - Range.Begin) * sizeof(UINT));
+}
+
+static void UploadDirtyBatchRanges(FRenderer& Renderer, FOctreeNode* RootNode, const FBatchDirtyMap& DirtyVertices, const FBatchDirtyMap& DirtyIndices)
+{
+    for (const auto& MatPair : DirtyVertices)
+    {
+        FRenderBatchRootData* RootBatch = RootNode->CachedBatchRootData.Find(MatPair.Key);
+        if (!RootBatch) continue;
+
+        for (const auto& LODPair : MatPair.Value)
+        {
+            const TArray<FVertexCompact>* Vertices = RootBatch->Vertices.Find(LODPair.Key);
+            if (!Vertices) continue;
+            UploadVertexRegion(Renderer, RootBatch->VertexBuffers.FindOrAdd(LODPair.Key), *Vertices, LODPair.Value);
+        }
+    }
+
+    for (const auto& MatPair : DirtyIndices)
+    {
+        FRenderBatchRootData* RootBatch = RootNode->CachedBatchRootData.Find(MatPair.Key);
+        if (!RootBatch) continue;
+
+        for (const auto& LODPair : MatPair.Value)
+        {
+            const TArray<UINT>* Indices = RootBatch->Indices.Find(LODPair.Key);
+            if (!Indices) continue;
+            UploadIndexRegion(Renderer, RootBatch->IndexBuffers.FindOrAdd(LODPair.Key), *Indices, LODPair.Value);
+        }
+    }
+}
+
+void FOctree::UpdateComponent(UPrimitiveComponent* Component)
+{
+    if (!Root || !Component) return;
+
+    FScopeCycleCounter Timer("UpdateOctreeComponent");
+
+    bVisibilityCacheValid = false;
+    Component->UpdateWorldAABB();
+
+    // 루트 경계를 벗어나면 트리 크기 자체가 바뀌어야 하므로 전체 재빌드
+    const bool bLoose = Root->IsLoose();
+    if (bLoose ? !Root->LooseBounds.Contains(Component->WorldAABB) : !Root->Bounds.Contains(Component->WorldAABB.GetCenter()))
+    {
+        BuildFull();
+        return;
+    }
+
+    FComponentBatchRecord& Record = Root->CachedComponentRecords.FindOrAdd(Component);
+    const bool bNewComponent = (Record.Leaf == nullptr);
+
+    if (!bLoose)
+        UpdateOverlappingRecursive(Root, Component, bNewComponent ? nullptr : &Record.AABB, &Component->WorldAABB, DirtyKDNodes);
+    Record.AABB = Component->WorldAABB;
+
+    bool bLeafChanged = bNewComponent;
+    if (!bNewComponent)
+    {
+        if (bLoose)
+        {
+            // 소유 노드의 느슨한 경계 안에 AABB가 남아 있으면 그대로 둠
+            bLeafChanged = !Record.Leaf->LooseBounds.Contains(Component->WorldAABB);
+        }
+        else
+        {
+            const FBoundingBox& LeafBounds = Record.Leaf->Bounds;
+            const FVector Slack = (LeafBounds.max - LeafBounds.min) * LeafLooseness;
+            const FBoundingBox LooseBounds(LeafBounds.min - Slack, LeafBounds.max + Slack);
+            bLeafChanged = !LooseBounds.Contains(Component->WorldAABB.GetCenter());
+        }
+    }
+
+    if (bLeafChanged)
+    {
+        RelocateComponent(Component, Record);
+    }
+    else
+    {
+        // 같은 리프 → 인덱스/DrawRange는 그대로, 정점 위치만 다시 계산
+        UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component);
+        if (StaticMeshComp && StaticMeshComp->GetStaticMesh())
+        {
+            const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(
+                StaticMeshComp->GetWorldLocation(),
+                StaticMeshComp->GetWorldRotation(),
+                StaticMeshComp->GetWorldScale()
+            );
+
+            FBatchDirtyMap DirtyVertices;
+            for (const FComponentBatchSlice& Slice : Record.Slices)
+            {
+                const OBJ::FStaticMeshRenderData* RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(Slice.LOD);
+                FRenderBatchRootData* RootBatch = Root->CachedBatchRootData.Find(Slice.MatName);
+                if (!RenderData || !RootBatch) continue;
+
+                TArray<FVertexCompact>& Vertices = RootBatch->Vertices.FindOrAdd(Slice.LOD);
+                WriteSubsetVertices(RenderData, RenderData->MaterialSubsets[Slice.SubsetIndex], ModelMatrix, Vertices, Slice.VertexStart, nullptr);
+                DirtyVertices.FindOrAdd(Slice.MatName).FindOrAdd(Slice.LOD).Add(Slice.VertexStart, Slice.VertexStart + Slice.VertexCount);
+            }
+            UploadDirtyBatchRanges(FEngineLoop::renderer, Root, DirtyVertices, FBatchDirtyMap());
+        }
+    }
+
+    FStatRegistry::RegisterResult(Timer);
+}
+
+void FOctree::RelocateComponent(UPrimitiveComponent* Component, FComponentBatchRecord& Record)
+{
+    FBatchDirtyMap DirtyVertices;
+    FBatchDirtyMap DirtyIndices;
+
+    UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component);
+    const bool bHasMesh = StaticMeshComp && StaticMeshComp->GetStaticMesh();
+
+    // Step 1. 현재 인덱스 구간을 찾고 이전 리프 경로에서 IndexCount 차감
+    TArray<FComponentRun> Runs;
+    if (Record.Leaf)
+    {
+        GatherComponentRuns(Record, Runs);
+        for (FComponentRun& Run : Runs)
+        {
+            Run.Start = GetRunStart(Root, Record.Leaf, Component, Run.MatName, Run.LOD);
+            AddNodeIndexCount(Record.Leaf, Run.MatName, Run.LOD, -static_cast<int64>(Run.Count), nullptr);
+        }
+        Record.Leaf->Components.Remove(Component);
+    }
+
+    // Step 2. 정점 갱신. 새 컴포넌트면 배열 끝에 정점/인덱스를 붙이고, 인덱스는 Step 4에서 제자리로 옮김
+    if (bHasMesh)
+    {
+        const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(
+            StaticMeshComp->GetWorldLocation(),
+            StaticMeshComp->GetWorldRotation(),
+            StaticMeshComp->GetWorldScale()
+        );
+
+        if (Record.Leaf)
+        {
+            for (const FComponentBatchSlice& Slice : Record.Slices)
+            {
+                const OBJ::FStaticMeshRenderData* RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(Slice.LOD);
+                FRenderBatchRootData* RootBatch = Root->CachedBatchRootData.Find(Slice.MatName);
+                if (!RenderData || !RootBatch) continue;
+
+                TArray<FVertexCompact>& Vertices = RootBatch->Vertices.FindOrAdd(Slice.LOD);
+                WriteSubsetVertices(RenderData, RenderData->MaterialSubsets[Slice.SubsetIndex], ModelMatrix, Vertices, Slice.VertexStart, nullptr);
+                DirtyVertices.FindOrAdd(Slice.MatName).FindOrAdd(Slice.LOD).Add(Slice.VertexStart, Slice.VertexStart + Slice.VertexCount);
+            }
+        }
+        else
+        {
+            Record.Slices.Empty();
+            for (int LOD = (int)ELODLevel::LOD0; LOD <= (int)ELODLevel::LOD2; ++LOD)
+            {
+                const ELODLevel LODLevel = static_cast<ELODLevel>(LOD);
+                const OBJ::FStaticMeshRenderData* RenderData = StaticMeshComp->GetStaticMesh()->GetRenderData(LODLevel);
+                if (!RenderData) continue;
+
+                for (int i = 0; i < RenderData->MaterialSubsets.Num(); ++i)
+                {
+                    const FMaterialSubset& Subset = RenderData->MaterialSubsets[i];
+                    const FString& MatName = RenderData->Materials[Subset.MaterialIndex].MTLName;
+
+                    FRenderBatchRootData& RootBatch = Root->CachedBatchRootData.FindOrAdd(MatName);
+                    TArray<FVertexCompact>& Vertices = RootBatch.Vertices.FindOrAdd(LODLevel);
+                    TArray<UINT>& Indices = RootBatch.Indices.FindOrAdd(LODLevel);
+
+                    const UINT VertexStart = (UINT)Vertices.Num();
+                    const UINT IndexStart = (UINT)Indices.Num();
+                    Indices.SetNum(IndexStart + Subset.IndexCount);
+                    const uint32 VertexCount = WriteSubsetVertices(RenderData, Subset, ModelMatrix, Vertices, VertexStart, Indices.GetData() + IndexStart);
+                    Record.Slices.Add({MatName, LODLevel, i, VertexStart, VertexCount, Subset.IndexCount});
+
+                    DirtyVertices.FindOrAdd(MatName).FindOrAdd(LODLevel).Add(VertexStart, VertexStart + VertexCount);
+                    DirtyIndices.FindOrAdd(MatName).FindOrAdd(LODLevel).Add(IndexStart, IndexStart + Subset.IndexCount);
+                }
+            }
+
+            GatherComponentRuns(Record, Runs);
+            for (FComponentRun& Run : Runs)
+            {
+                Run.Start = (uint32)Root->CachedBatchRootData[Run.MatName].Indices[Run.LOD].Num() - Run.Count;
+            }
+        }
+    }
+
+    // Step 3. 새 노드에 삽입. 빈 리프가 분할되면 새 노드들이 생기므로 Linear 옥트리도 다시 펼침
+    FOctreeNode* SplitNode = nullptr;
+    FOctreeNode* NewLeaf = Root->Insert(Component, FOctreeNode::MaxInsertDepth, &SplitNode);
+    if (SplitNode && !Root->IsLoose())
+        InheritOverlappingRecursive(SplitNode, DirtyKDNodes);
+    Record.Leaf = NewLeaf;
+
+    // Step 4. 새 리프 경로에 IndexCount를 더하고, 인덱스 구간을 새 위치로 회전 이동
+    TSet<FString> DirtyMaterials;
+    for (const FComponentRun& Run : Runs)
+    {
+        const FObjMaterialInfo* MatInfo = GetSliceMaterial(Component, Record.Slices[Run.SliceIndex]);
+        if (!MatInfo) continue;
+
+        AddNodeIndexCount(NewLeaf, Run.MatName, Run.LOD, Run.Count, MatInfo);
+        const uint32 NewStart = GetRunStart(Root, NewLeaf, Component, Run.MatName, Run.LOD);
+
+        TArray<UINT>& Indices = Root->CachedBatchRootData[Run.MatName].Indices[Run.LOD];
+        MoveIndexRun(Indices, Run.Start, Run.Count, NewStart, DirtyIndices.FindOrAdd(Run.MatName).FindOrAdd(Run.LOD));
+        DirtyMaterials.Add(Run.MatName);
+    }
+
+    // Step 5. 바뀐 머티리얼만 DrawRange 재분배 후 변경 구간 업로드
+    for (const FString& MatName : DirtyMaterials)
+        Root->AssignDrawRangesLODWrapped(MatName);
+
+    UploadDirtyBatchRanges(FEngineLoop::renderer, Root, DirtyVertices, DirtyIndices);
+
+    // Loose 모드는 내부 노드의 Components 유무(bHasOwnComponents)도 바뀔 수 있음
+    if ((SplitNode || Root->IsLoose()) && LinearTree)
+        LinearTree->Build(Root);
+}
+
+void FOctree::RemoveComponent(UPrimitiveComponent* Component)
+{
+    RemoveComponents({Component});
+}
+
+void FOctree::RemoveComponents(const TArray<UPrimitiveComponent*>& Components)
+{
+    if (!Root) return;
+
+    // 트리에 있는 컴포넌트만 추림 (중복 제거)
+    TArray<UPrimitiveComponent*> Removed;
+    for (UPrimitiveComponent* Component : Components)
+    {
+        const FComponentBatchRecord* Record = Component ? Root->CachedComponentRecords.Find(Component) : nullptr;
+        if (Record && Record->Leaf && !Removed.Contains(Component))
+            Removed.Add(Component);
+    }
+    if (Removed.IsEmpty()) return;
+
+    FScopeCycleCounter Timer("RemoveOctreeComponent");
+    bVisibilityCacheValid = false;
+
+    // Step 1. 아무것도 바꾸기 전에 모든 컴포넌트의 인덱스 구간 위치를 구함
+    struct FIndexCut
+    {
+        uint32 Start;
+        uint32 Count;
+    };
+    TMap<FString, TMap<ELODLevel, TArray<FIndexCut>>> Cuts;
+    TArray<TArray<FComponentRun>> ComponentRuns;
+    ComponentRuns.SetNum(Removed.Num());
+    for (int32 i = 0; i < Removed.Num(); ++i)
+    {
+        const FComponentBatchRecord& Record = *Root->CachedComponentRecords.Find(Removed[i]);
+        GatherComponentRuns(Record, ComponentRuns[i]);
+        for (FComponentRun& Run : ComponentRuns[i])
+        {
+            Run.Start = GetRunStart(Root, Record.Leaf, Removed[i], Run.MatName, Run.LOD);
+            Cuts.FindOrAdd(Run.MatName).FindOrAdd(Run.LOD).Add({Run.Start, Run.Count});
+        }
+    }
+
+    // Step 2. (머티리얼, LOD) 배열마다 잘라낼 구간을 한 번에 당겨 붙임. 정점은 참조되지 않는 채로 남고 다음 BuildFull에서 정리됨
+    FBatchDirtyMap DirtyIndices;
+    for (auto& MatPair : Cuts)
+    {
+        FRenderBatchRootData* RootBatch = Root->CachedBatchRootData.Find(MatPair.Key);
+        for (auto& LODPair : MatPair.Value)
+        {
+            TArray<UINT>* Indices = RootBatch ? RootBatch->Indices.Find(LODPair.Key) : nullptr;
+            if (!Indices) continue;
+
+            TArray<FIndexCut>& LODCuts = LODPair.Value;
+            std::sort(LODCuts.begin(), LODCuts.end(), [](const FIndexCut& A, const FIndexCut& B) { return A.Start < B.Start; });
+
+            const uint32 OldNum = static_cast<uint32>(Indices->Num());
+            UINT* Data = Indices->GetData();
+            uint32 Write = LODCuts[0].Start;
+            for (int32 c = 0; c < LODCuts.Num(); ++c)
+            {
+                const uint32 KeepBegin = LODCuts[c].Start + LODCuts[c].Count;
+                const uint32 KeepEnd = c + 1 < LODCuts.Num() ? LODCuts[c + 1].Start : OldNum;
+                memmove(Data + Write, Data + KeepBegin, (KeepEnd - KeepBegin) * sizeof(UINT));
+                Write += KeepEnd - KeepBegin;
+            }
+            Indices->SetNum(static_cast<int32>(Write));
+            DirtyIndices.FindOrAdd(MatPair.Key).FindOrAdd(LODPair.Key).Add(LODCuts[0].Start, OldNum);
+        }
+    }
+
+    // Step 3. 노드별 IndexCount와 리프/레코드 정리
+    for (int32 i = 0; i < Removed.Num(); ++i)
+    {
+        UPrimitiveComponent* Component = Removed[i];
+        FComponentBatchRecord& Record = *Root->CachedComponentRecords.Find(Component);
+        if (!Root->IsLoose())
+            UpdateOverlappingRecursive(Root, Component, &Record.AABB, nullptr, DirtyKDNodes);
+
+        for (const FComponentRun& Run : ComponentRuns[i])
+            AddNodeIndexCount(Record.Leaf, Run.MatName, Run.LOD, -static_cast<int64>(Run.Count), nullptr);
+        Record.Leaf->Components.Remove(Component);
+        Root->CachedComponentRecords.Remove(Component);
+    }
+
+    // Step 4. 배치마다 DrawRange 재계산과 업로드를 한 번씩
+    for (const auto& MatPair : Cuts)
+        Root->AssignDrawRangesLODWrapped(MatPair.Key);
+
+    UploadDirtyBatchRanges(FEngineLoop::renderer, Root, FBatchDirtyMap(), DirtyIndices);
+
+    if (Root->IsLoose() && LinearTree)
+        LinearTree->Build(Root);
+
+    FStatRegistry::RegisterResult(Timer);
+}
+
+void FOctree::FlushDirtyKDTrees()
+{
+    if (DirtyKDNodes.IsEmpty()) return;
+
+    // 피킹에 쓰이는 MaxDepthKD 깊이만 다시 빌드. 나머지는 깊이 설정이 바뀔 때까지 보류
+    TArray<FOctreeNode*> Rebuilt;
+    for (FOctreeNode* Node : DirtyKDNodes)
+    {
+        if (Node->Depth != MaxDepthKD) continue;
+
+        delete Node->KDTree;
+        Node->KDTree = nullptr;
+        Node->BuildKDTreeRecursive();
+        Rebuilt.Add(Node);
+    }
+
+    for (FOctreeNode* Node : Rebuilt)
+        DirtyKDNodes.Remove(Node);
+}
@@ -3,17 +3,21 @@
 
 #include "Define.h"
 #include "../../Core/Container/Map.h"
+#include "Container/Set.h"
 #include "Math.h"
+#include "Math/Frustum.h"
+#include "KDTree/NearestQuery.h"
 
 struct FDrawRange;
 class FOctreeNode;
 class UStaticMeshComponent;
-class FKDTreeNode;
+class FKDTree;
 struct FRay;
+struct FRaycastStats;
 class FRenderer;
 class UPrimitiveBatch;
-class FFrustum;
 class UPrimitiveComponent;
+class FLinearOctree;
 enum class ELODLevel : uint8
 {
     LOD0 = 0,
@@ -49,8 +53,61 @@ struct FDrawRange
 {
     uint32 IndexStart = 0;
     uint32 IndexCount = 0;
+    uint32 OwnIndexCount = 0; // 노드 자신의 Components 몫. 구간은 [자신][자식0..7] 순서
 };
 
+// 컴포넌트 한 서브셋이 루트 배치 배열에서 차지하는 구간
+struct FComponentBatchSlice
+{
+    FString MatName;
+    ELODLevel LOD = ELODLevel::LOD0;
+    int32 SubsetIndex = 0;
+    uint32 VertexStart = 0;  // 정점 구간은 빌드 후 고정
+    uint32 VertexCount = 0;
+    uint32 IndexCount = 0;   // 인덱스 위치는 리프의 DrawRange + 리프 내 앞선 컴포넌트들로부터 계산
+};
+
+// 증분 갱신용 컴포넌트 정보. 루트 노드에만 저장
+struct FComponentBatchRecord
+{
+    FOctreeNode* Leaf = nullptr;  // Components에 이 컴포넌트를 가진 노드
+    FBoundingBox AABB;            // OverlappingComponents에 반영된 WorldAABB
+    TArray<FComponentBatchSlice> Slices;
+};
+
+// 서브셋 인덱스에서 정점이 처음 등장하는 순서. 같은 서브셋을 쓰는 인스턴스끼리 공유
+struct FSubsetVertexRemap
+{
+    TArray<UINT> SourceVertices; // 처음 등장한 순서의 원본 정점 인덱스
+    TArray<UINT> LocalIndices;   // 서브셋 인덱스마다 SourceVertices 안의 위치
+};
+
+// 병렬 빌드: 레이아웃 단계에서 자리를 잡아두고, 이후 병렬로 정점 변환/인덱스 기록할 서브셋 하나
+struct FBatchWriteJob
+{
+    UStaticMeshComponent* Component = nullptr;
+    const OBJ::FStaticMeshRenderData* RenderData = nullptr;
+    int32 SubsetIndex = 0;
+    FString MatName;
+    ELODLevel LOD = ELODLevel::LOD0;
+    uint32 VertexStart = 0;
+    uint32 IndexStart = 0;
+    const FSubsetVertexRemap* Remap = nullptr; // FBatchBuildContext::SubsetRemaps 항목
+};
+
+struct FBatchBuildContext
+{
+    TArray<FBatchWriteJob> Jobs;
+    TMap<const FMaterialSubset*, FSubsetVertexRemap> SubsetRemaps; // 서브셋마다 한 번만 계산 (같은 메시 반복 시)
+};
+
+// 노드 LOD 선택 입력. 프레임마다 활성 뷰포트에서 한 번 만듦
+struct FLODSelectionParams
+{
+    FVector CameraLocation;
+    float ProjectionScale = 1.0f; // 원근: 거리 1에서 월드 길이 1의 픽셀 수 (ViewportHeight / (2 * tan(FOV / 2))). 직교: 월드 1의 픽셀 수
+    bool bOrthographic = false;
+};
 
 class FOctreeNode
 {
@@ -60,7 +117,12 @@ public:
     uint64 VertexBufferSizeInBytes = 0;
     uint64 IndexBufferSizeInBytes = 0;
     FBoundingBox Bounds;
+    FBoundingBox LooseBounds; // Bounds를 Looseness배로 확장. 저장된 컴포넌트 AABB를 모두 포함 (Looseness 1이면 Bounds와 같음)
     FSphere BoundingSphere;
+    float Looseness = 1.0f;
+    uint8 LastOutsidePlane = FFrustum::NoPlane; // 지난 프레임에 이 노드를 거부한 프러스텀 평면
+    ELODLevel LODLevel = ELODLevel::LOD0; // 마지막으로 고른 LOD. 히스테리시스 기준
+    int LODFrame = -1;                    // LODLevel을 고른 프레임
 
     TArray<UPrimitiveComponent*> Components;
     TArray<UPrimitiveComponent*> OverlappingComponents;
@@ -71,33 +133,56 @@ public:
 
     TMap<FString, FRenderBatchRootData> CachedBatchRootData;
     TMap<FString, FRenderBatchNodeData> CachedBatchNodeData;
-    FKDTreeNode* KDTree = nullptr;
+    TMap<UPrimitiveComponent*, FComponentBatchRecord> CachedComponentRecords;
+    FKDTree* KDTree = nullptr;
+
+    static constexpr int MaxInsertDepth = 5;
 
-    FOctreeNode(const FBoundingBox& InBounds, int InDepth);
+    FOctreeNode(const FBoundingBox& InBounds, int InDepth, float InLooseness = 1.0f);
     ~FOctreeNode();
 
-    //각 노드의 CachedBatchData 설정
-    void BuildBatchRenderData(FOctreeNode* RootNode=nullptr);
+    bool IsLoose() const { return Looseness > 1.0f; }
+    FBoundingBox GetChildBounds(int InChildIndex) const;
+    //8개 자식 생성
+    void Split();
+
+    //각 노드의 CachedBatchData 설정. 루트 배열에 자리만 잡고 실제 정점/인덱스 기록은 Context.Jobs로 모음
+    void BuildBatchRenderData(FBatchBuildContext& Context, FOctreeNode* RootNode=nullptr);
     //사용할 노드들의 Vertex,Index 버퍼를 미리 생성
     void BuildBatchBuffers(FRenderer& Renderer);
     //CachedBatchData 전부 할당 해제. 현재 버퍼 생성 후 자동 실행
     //void ClearBatchDatas();
     void ClearKDDatas(int MaxDepthKD);
-    //재귀적으로 Components를 적절한 노드에 추가
-    void Insert(UPrimitiveComponent* Component, int MaxDepth = 5);
+    //재귀적으로 Components를 적절한 노드에 추가. 실제로 추가된 노드를 반환.
+    //Loose 모드에서는 AABB 전체가 들어가는 가장 깊은 노드가 소유. OutSplitNode에는 처음 분할된 노드 기록
+    FOctreeNode* Insert(UPrimitiveComponent* Component, int MaxDepth = MaxInsertDepth, FOctreeNode** OutSplitNode = nullptr);
     void BuildOverlappingRecursive(UPrimitiveComponent* Component);
     void BuildKDTreeRecursive();
 
     //Lazy Segtree에서 사용. FrameThreshold프레임만큼 사용하지 않은 버퍼 할당 해제. 현재 사용 X
     //void TickBuffers(int CurrentFrame, int FrameThreshold);
-    //현재 렌더할 노드를 결정해서 FRenderBatchData를 반환
-    void CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes);
+    //현재 렌더할 노드를 결정해서 FRenderBatchData를 반환.
+    //OutOwnNodes: 자식으로 내려가느라 통째로 그려지지 않는 노드 중 자기 Components가 있는 노드 (Loose 모드)
+    void CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes = nullptr);
+    //부모가 자식들을 한 번에 컬링한 결과(Containment)로 순회. PlaneMask는 아직 걸쳐 있는 평면
+    void CollectRenderNodes(const FFrustum& Frustum, EFrustumContainment Containment, uint8 PlaneMask, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes);
+    //자식 8개의 LooseBounds를 SIMD로 한 번에 검사. 지난 프레임에 거부된 자식은 그 평면 하나로 먼저 거름. 없는 자식은 Outside
+    void CheckChildrenContainment(const FFrustum& Frustum, uint8 PlaneMask, EFrustumContainment OutResults[8], uint8 OutPlaneMasks[8]);
     void QueryOcclusion(FRenderer& Renderer, ID3D11DeviceContext* Context, const FFrustum& Frustum);
+    //경계 구 반지름을 화면에 투영한 픽셀 크기로 LOD 결정. 임계값 근처에서는 GLODHysteresis만큼 지난 LOD를 유지.
+    //같은 프레임에 다시 불리면 저장된 결과 반환
+    ELODLevel SelectLOD(const FLODSelectionParams& Params);
 
     const int MaxQueriesPerFrame = 2000;
-    UPrimitiveComponent* Raycast(const FRay& Ray, float& OutDistance) const;
-    UPrimitiveComponent* RaycastWithKD(const FRay& Ray, float& OutDistance, int MaxDepthKD) const;
+    //자식은 레이 진입 거리순으로 방문하고 InOutDistance(지금까지 최단 교차)보다 늦게 들어가는 자식은 건너뜀.
+    //이 노드 경계 검사는 호출하는 쪽에서 끝낸 상태
+    UPrimitiveComponent* Raycast(const FRay& Ray, float& InOutDistance, FRaycastStats& Stats) const;
+    UPrimitiveComponent* RaycastWithKD(const FRay& Ray, float& InOutDistance, int MaxDepthKD, FRaycastStats& Stats) const;
+    //Loose 모드 전용. 각 노드의 자기 Components만 검사
+    UPrimitiveComponent* RaycastLoose(const FRay& Ray, float& InOutDistance, FRaycastStats& Stats) const;
     void AssignAllDrawRangesLODWrapped();
+    //루트에서 호출. 한 머티리얼의 DrawRange만 다시 분배
+    void AssignDrawRangesLODWrapped(const FString& MatName);
     void ComputeDrawRangesFromParentLODWrapped(
         const FString& MatName,
         const TMap<ELODLevel, FDrawRange>& InRanges);
@@ -110,6 +195,11 @@ public:
     //TMap<FString, FDrawRange> DrawRanges; // 루트 기준 범위 정보 저장
 };
 
+//노드 경계 구의 투영 반지름(픽셀)이 이보다 작으면 LOD1 / LOD2
+inline float GLOD1ScreenRadius = 300.0f;
+inline float GLOD2ScreenRadius = 120.0f;
+inline float GLODHysteresis = 0.15f; // 임계값 대비 비율. LOD가 프레임마다 오가는 것 방지
+
 //현재 (GRenderDepthMax-GRenderDepthMin+1)*2GB만큼의 VRam 사용
 inline int GRenderDepthMin = 1; // 최소 깊이 (이보다 얕으면 스킵)
 inline int GRenderDepthMax = 3; // 최대 깊이 (이보다 깊으면 스킵) 2~3이 적절
@@ -125,12 +215,62 @@ public:
 
     FOctreeNode* GetRoot() { return Root; };
 
-    UPrimitiveComponent* Raycast(const FRay& Ray, float& OutHitDistance) const;
+    //bUseLinearOctree에 따라 Linear 옥트리 또는 Root부터 재귀로 렌더할 노드 수집.
+    //bAllowReuse면 프러스텀/트리/렌더 깊이가 지난 호출과 같을 때 순회 없이 지난 결과를 돌려줌 (오클루전을 쓰면 false)
+    void CollectRenderNodes(const FFrustum& Frustum, TArray<FOctreeNode*>& OutNodes, TArray<FOctreeNode*>* OutOwnNodes = nullptr, bool bAllowReuse = false);
+
+    //피킹 전에 DirtyKDNodes 중 MaxDepthKD 깊이의 KDTree를 다시 빌드.
+    //OutHitDistance보다 가까운 교차만 찾으며 방문한 노드/컴포넌트 수를 FStatRegistry 카운터로 기록
+    UPrimitiveComponent* Raycast(const FRay& Ray, float& OutHitDistance);
+
+    //영역과 겹치는(WorldAABB 기준) 컴포넌트를 한 번의 순회로 OutComponents 뒤에 추가. 중복 없음.
+    //노드 전체가 영역 안이면 하위 노드는 검사 없이 통째로 추가
+    void QueryAABB(const FBoundingBox& Box, TArray<UPrimitiveComponent*>& OutComponents) const;
+    void QuerySphere(const FSphere& Sphere, TArray<UPrimitiveComponent*>& OutComponents) const;
+    //마퀴 선택은 FFrustum::ConstructFrustumFromScreenRect로 만든 부분 프러스텀을 넘김
+    void QueryFrustum(const FFrustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents) const;
+
+    //Point에서 WorldAABB까지 가까운 순으로 최대 K개를 OutResults(K개 이상)에 채우고 개수 반환.
+    //MaxDistance를 주면 반경 질의. 가까운 노드부터 꺼내는 최선 우선 탐색이며 힙 할당 없음
+    int32 FindNearest(const FVector& Point, int32 K, FNearestComponent* OutResults, float MaxDistance = FLT_MAX) const;
+
+    //직렬 Build와 같은 결과를 내도록 단계별로 병렬화 (Bounds 축소, 루트 자식별 삽입, 서브셋별 정점 변환)
+    bool bParallelBuild = true;
+
+    //Transform이 바뀐 컴포넌트 반영. 느슨한 리프 경계 안이면 정점만 갱신하고, 벗어나면 리프를 옮김.
+    //트리에 없는 컴포넌트는 새로 추가. 루트 경계를 벗어나면 BuildFull
+    void UpdateComponent(UPrimitiveComponent* Component);
+    void RemoveComponent(UPrimitiveComponent* Component);
+    //여러 컴포넌트를 한 번에 제거. (머티리얼, LOD) 배치마다 인덱스 압축, DrawRange 계산, 업로드를 한 번만 함
+    void RemoveComponents(const TArray<UPrimitiveComponent*>& Components);
+
     int MaxDepthKD = 4;
     bool bUseKD = true;
+    bool bUseLinearOctree = true;
+    float LeafLooseness = 0.25f; // 리프 크기 대비 여유 비율. 경계 근처에서 리프를 오가는 것 방지
+    //1이면 중심 기준 삽입 + OverlappingComponents. 1보다 크면 Loose 옥트리 (BuildFull 시 적용)
+    float Looseness = 1.0f;
+    bool bTemporalCoherence = true; // CollectRenderNodes 결과 재사용 허용
 
 private:
+    //Components를 순서대로 Root에 삽입. bParallelBuild면 루트 자식별 서브트리를 병렬로 구성
+    void InsertComponents(const TArray<UPrimitiveComponent*>& Primitives);
+    void RelocateComponent(UPrimitiveComponent* Component, FComponentBatchRecord& Record);
+    void FlushDirtyKDTrees();
+
     FOctreeNode* Root;
+    TSet<FOctreeNode*> DirtyKDNodes;
+    //BuildFull에서 Root를 펼쳐 만든 배열 옥트리. 배치 데이터는 Root 트리의 노드를 참조
+    FLinearOctree* LinearTree = nullptr;
+
+    //지난 CollectRenderNodes 결과. 트리가 바뀌면 무효화
+    bool bVisibilityCacheValid = false;
+    FFrustum CachedFrustum;
+    int CachedDepthMin = -1;
+    int CachedDepthMax = -1;
+    bool bCachedLinearOctree = false;
+    TArray<FOctreeNode*> CachedRenderNodes;
+    TArray<FOctreeNode*> CachedOwnRenderNodes;
 };
 
 //각 노드 AABB 출력
@@ -149,5 +289,6 @@ inline int MakeNodeId(const FBoundingBox& Bounds)
     return x * 73856093 ^ y * 19349663 ^ z * 83492791;
 }
 
-//CollectRenderNodes를 통해 선별한 노드의 데이터를 렌더.
-void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray<FOctreeNode*>& RenderNodes, const FOctreeNode* RootNode);
+//CollectRenderNodes를 통해 선별한 노드의 데이터를 렌더. OwnRenderNodes는 자기 구간(OwnIndexCount)만 그림
+void RenderCollectedBatches(FRenderer& Renderer, const FMatrix& VP, const TArray<FOctreeNode*>& RenderNodes,
+                            const TArray<FOctreeNode*>& OwnRenderNodes, const FOctreeNode* RootNode);
@@ -0,0 +1,361 @@
+// SoftwareOcclusion.cpp
+#include "SoftwareOcclusion.h"
+
+#include <algorithm>
+
+#include "OcclusionQuerySystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Math/JungleMath.h"
+#include "Math/MathUtility.h"
+#include "UObject/UObjectIterator.h"
+
+FSoftwareOcclusion* GSoftwareOcclusion = nullptr;
+
+namespace
+{
+    // near 평면 바로 앞까지만 투영. 이보다 가까운 정점이 있으면 오클루더/박스 모두 보수적으로 처리
+    constexpr float MinClipW = 1e-4f;
+
+    struct FScreenVertex
+    {
+        float X, Y, Z;
+        bool bValid;
+    };
+
+    FScreenVertex ProjectToScreen(const FVector& P, const FMatrix& M)
+    {
+        const float ClipX = P.x * M.M[0][0] + P.y * M.M[1][0] + P.z * M.M[2][0] + M.M[3][0];
+        const float ClipY = P.x * M.M[0][1] + P.y * M.M[1][1] + P.z * M.M[2][1] + M.M[3][1];
+        const float ClipZ = P.x * M.M[0][2] + P.y * M.M[1][2] + P.z * M.M[2][2] + M.M[3][2];
+        const float ClipW = P.x * M.M[0][3] + P.y * M.M[1][3] + P.z * M.M[2][3] + M.M[3][3];
+
+        FScreenVertex Out;
+        Out.bValid = ClipW > MinClipW && ClipZ >= 0.0f;
+        if (!Out.bValid)
+        {
+            Out.X = Out.Y = Out.Z = 0.0f;
+            return Out;
+        }
+
+        const float InvW = 1.0f / ClipW;
+        Out.X = (ClipX * InvW * 0.5f + 0.5f) * FSoftwareOcclusion::Width;
+        Out.Y = (0.5f - ClipY * InvW * 0.5f) * FSoftwareOcclusion::Height;
+        Out.Z = ClipZ * InvW;
+        return Out;
+    }
+}
+
+FSoftwareOcclusion::FSoftwareOcclusion()
+{
+    Depth.Init(1.0f, Width * Height);
+    std::fill(std::begin(TileMaxDepth), std::end(TileMaxDepth), 1.0f);
+}
+
+void FSoftwareOcclusion::BeginFrame(const FMatrix& InViewProj)
+{
+    ViewProj = InViewProj;
+    bFrameReady = false;
+    NumOccluders = 0;
+    NumTriangles = 0;
+
+    std::fill(Depth.GetData(), Depth.GetData() + Depth.Num(), 1.0f);
+    std::fill(std::begin(TileMaxDepth), std::end(TileMaxDepth), 1.0f);
+    Triangles.Empty();
+    for (TArray<uint32>& Bin : TileBins)
+        Bin.Empty();
+}
+
+void FSoftwareOcclusion::RenderOccluders(const FVector& CameraPos, float OrthoExtent)
+{
+    struct FCandidate
+    {
+        UStaticMeshComponent* Component;
+        float ScreenSize;
+    };
+    TArray<FCandidate> Candidates;
+
+    for (UStaticMeshComponent* MeshComp : TObjectRange<UStaticMeshComponent>())
+    {
+        if (!MeshComp->GetStaticMesh()) continue;
+
+        const FBoundingBox& AABB = MeshComp->WorldAABB;
+        const float Radius = (AABB.max - AABB.min).Magnitude() * 0.5f;
+        const float Distance = ((AABB.min + AABB.max) * 0.5f - CameraPos).Magnitude();
+
+        // 카메라가 경계 안에 있으면 대부분 near 평면에 걸려 버려지므로 제외
+        if (Distance <= Radius) continue;
+
+        // 직교 뷰에서는 화면 크기가 거리와 무관
+        const float ScreenSize = OrthoExtent > 0.0f ? Radius / OrthoExtent : Radius / Distance;
+        if (ScreenSize < MinOccluderScreenSize) continue;
+
+        Candidates.Add({MeshComp, ScreenSize});
+    }
+
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.ScreenSize > B.ScreenSize; });
+
+    // 오클루더는 원본(LOD0) 메시를 그대로 사용. 단순화된 LOD는 원본 밖으로 나올 수 있어 보수적이지 않음
+    const int32 Count = FMath::Min(MaxOccluders, Candidates.Num());
+    for (int32 i = 0; i < Count && NumTriangles < MaxOccluderTriangles; ++i)
+    {
+        UStaticMeshComponent* MeshComp = Candidates[i].Component;
+        const OBJ::FStaticMeshRenderData* RenderData = MeshComp->GetStaticMesh()->GetRenderData();
+        if (!RenderData) continue;
+
+        const FMatrix ModelMatrix = JungleMath::CreateModelMatrix(
+            MeshComp->GetWorldLocation(),
+            MeshComp->GetWorldRotation(),
+            MeshComp->GetWorldScale()
+        );
+        AddOccluder(RenderData->Vertices, RenderData->Indices, ModelMatrix);
+    }
+
+    EndFrame();
+}
+
+void FSoftwareOcclusion::AddOccluder(const TArray<FVertexCompact>& Vertices, const TArray<UINT>& Indices, const FMatrix& ModelMatrix)
+{
+    const FMatrix MVP = ModelMatrix * ViewProj;
+
+    TArray<FScreenVertex> Screen;
+    Screen.SetNum(Vertices.Num());
+    for (int32 i = 0; i < Vertices.Num(); ++i)
+    {
+        const FVertexCompact& V = Vertices[i];
+        Screen[i] = ProjectToScreen(FVector(V.x, V.y, V.z), MVP);
+    }
+
+    ++NumOccluders;
+    for (int32 i = 0; i + 2 < Indices.Num(); i += 3)
+    {
+        if (NumTriangles >= MaxOccluderTriangles)
+            return;
+
+        const FScreenVertex* V0 = &Screen[Indices[i]];
+        const FScreenVertex* V1 = &Screen[Indices[i + 1]];
+        const FScreenVertex* V2 = &Screen[Indices[i + 2]];
+        if (!V0->bValid || !V1->bValid || !V2->bValid)
+            continue;
+
+        // 앞/뒷면 모두 그림. 항상 면적이 양수가 되도록 정렬
+        float Area = (V1->X - V0->X) * (V2->Y - V0->Y) - (V2->X - V0->X) * (V1->Y - V0->Y);
+        if (Area < 0.0f)
+        {
+            std::swap(V1, V2);
+            Area = -Area;
+        }
+        if (Area < 1e-6f)
+            continue;
+
+        FOccluderTriangle Tri;
+        Tri.MinX = FMath::Max(0, static_cast<int32>(std::floor(FMath::Min(V0->X, FMath::Min(V1->X, V2->X)))));
+        Tri.MinY = FMath::Max(0, static_cast<int32>(std::floor(FMath::Min(V0->Y, FMath::Min(V1->Y, V2->Y)))));
+        Tri.MaxX = FMath::Min(Width - 1, static_cast<int32>(std::ceil(FMath::Max(V0->X, FMath::Max(V1->X, V2->X)))));
+        Tri.MaxY = FMath::Min(Height - 1, static_cast<int32>(std::ceil(FMath::Max(V0->Y, FMath::Max(V1->Y, V2->Y)))));
+        if (Tri.MinX > Tri.MaxX || Tri.MinY > Tri.MaxY)
+            continue;
+
+        // 변 a→b에 대해 E(p) = (b-a) x (p-a)
+        const FScreenVertex* EdgeFrom[3] = {V0, V1, V2};
+        const FScreenVertex* EdgeTo[3] = {V1, V2, V0};
+        for (int e = 0; e < 3; ++e)
+        {
+            Tri.EdgeA[e] = EdgeFrom[e]->Y - EdgeTo[e]->Y;
+            Tri.EdgeB[e] = EdgeTo[e]->X - EdgeFrom[e]->X;
+            Tri.EdgeC[e] = (EdgeTo[e]->Y - EdgeFrom[e]->Y) * EdgeFrom[e]->X - (EdgeTo[e]->X - EdgeFrom[e]->X) * EdgeFrom[e]->Y;
+        }
+
+        // z/w는 화면 공간에서 선형이므로 평면으로 보간
+        const float DzDx = ((V1->Z - V0->Z) * (V2->Y - V0->Y) - (V2->Z - V0->Z) * (V1->Y - V0->Y)) / Area;
+        const float DzDy = ((V1->X - V0->X) * (V2->Z - V0->Z) - (V2->X - V0->X) * (V1->Z - V0->Z)) / Area;
+        Tri.DepthA = DzDx;
+        Tri.DepthB = DzDy;
+        Tri.DepthC = V0->Z - DzDx * V0->X - DzDy * V0->Y;
+
+        const uint32 TriIndex = static_cast<uint32>(Triangles.Add(Tri));
+        ++NumTriangles;
+
+        for (int32 TileY = Tri.MinY / TileHeight; TileY <= Tri.MaxY / TileHeight; ++TileY)
+        {
+            for (int32 TileX = Tri.MinX / TileWidth; TileX <= Tri.MaxX / TileWidth; ++TileX)
+            {
+                TileBins[TileY * TilesX + TileX].Add(TriIndex);
+            }
+        }
+    }
+}
+
+void FSoftwareOcclusion::EndFrame()
+{
+    // 타일끼리는 겹치는 픽셀이 없으므로 타일 단위로 독립적으로 래스터화
+    for (int32 Tile = 0; Tile < TilesX * TilesY; ++Tile)
+    {
+        if (!TileBins[Tile].IsEmpty())
+            RasterizeTile(Tile);
+    }
+    bFrameReady = true;
+}
+
+void FSoftwareOcclusion::RasterizeTile(int32 TileIndex)
+{
+    const int32 TileX0 = (TileIndex % TilesX) * TileWidth;
+    const int32 TileY0 = (TileIndex / TilesX) * TileHeight;
+    float* DepthData = Depth.GetData();
+
+    for (uint32 TriIndex : TileBins[TileIndex])
+    {
+        const FOccluderTriangle& Tri = Triangles[TriIndex];
+
+        // TileWidth가 4의 배수이므로 4픽셀 묶음이 타일을 넘지 않음
+        const int32 X0 = FMath::Max(Tri.MinX, TileX0) & ~3;
+        const int32 X1 = FMath::Min(Tri.MaxX, TileX0 + TileWidth - 1);
+        const int32 Y0 = FMath::Max(Tri.MinY, TileY0);
+        const int32 Y1 = FMath::Min(Tri.MaxY, TileY0 + TileHeight - 1);
+
+#if USE_SIMD
+        const __m128 Zero = _mm_setzero_ps();
+        const __m128 LaneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 A0 = _mm_set1_ps(Tri.EdgeA[0]), A1 = _mm_set1_ps(Tri.EdgeA[1]), A2 = _mm_set1_ps(Tri.EdgeA[2]);
+        const __m128 DA = _mm_set1_ps(Tri.DepthA);
+
+        for (int32 y = Y0; y <= Y1; ++y)
+        {
+            const float PixelY = static_cast<float>(y) + 0.5f;
+            const __m128 Row0 = _mm_set1_ps(Tri.EdgeB[0] * PixelY + Tri.EdgeC[0]);
+            const __m128 Row1 = _mm_set1_ps(Tri.EdgeB[1] * PixelY + Tri.EdgeC[1]);
+            const __m128 Row2 = _mm_set1_ps(Tri.EdgeB[2] * PixelY + Tri.EdgeC[2]);
+            const __m128 RowZ = _mm_set1_ps(Tri.DepthB * PixelY + Tri.DepthC);
+            float* DepthRow = DepthData + y * Width;
+
+            for (int32 x = X0; x <= X1; x += 4)
+            {
+                const __m128 PixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), LaneOffset);
+                const __m128 E0 = _mm_add_ps(_mm_mul_ps(A0, PixelX), Row0);
+                const __m128 E1 = _mm_add_ps(_mm_mul_ps(A1, PixelX), Row1);
+                const __m128 E2 = _mm_add_ps(_mm_mul_ps(A2, PixelX), Row2);
+                const __m128 Inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(E0, Zero), _mm_cmpge_ps(E1, Zero)), _mm_cmpge_ps(E2, Zero));
+                if (_mm_movemask_ps(Inside) == 0)
+                    continue;
+
+                const __m128 Z = _mm_max_ps(_mm_add_ps(_mm_mul_ps(DA, PixelX), RowZ), Zero);
+                const __m128 Old = _mm_loadu_ps(DepthRow + x);
+                const __m128 New = _mm_or_ps(_mm_and_ps(Inside, _mm_min_ps(Old, Z)), _mm_andnot_ps(Inside, Old));
+                _mm_storeu_ps(DepthRow + x, New);
+            }
+        }
+#else
+        for (int32 y = Y0; y <= Y1; ++y)
+        {
+            const float PixelY = static_cast<float>(y) + 0.5f;
+            float* DepthRow = DepthData + y * Width;
+            for (int32 x = X0; x <= X1; ++x)
+            {
+                const float PixelX = static_cast<float>(x) + 0.5f;
+                bool bInside = true;
+                for (int e = 0; e < 3; ++e)
+                    bInside &= Tri.EdgeA[e] * PixelX + Tri.EdgeB[e] * PixelY + Tri.EdgeC[e] >= 0.0f;
+                if (!bInside) continue;
+
+                const float Z = FMath::Max(Tri.DepthA * PixelX + Tri.DepthB * PixelY + Tri.DepthC, 0.0f);
+                DepthRow[x] = FMath::Min(DepthRow[x], Z);
+            }
+        }
+#endif
+    }
+
+    // HiZ: 타일 안에서 가장 먼 깊이
+    float MaxDepth = 0.0f;
+    for (int32 y = TileY0; y < TileY0 + TileHeight; ++y)
+    {
+        const float* DepthRow = DepthData + y * Width;
+        for (int32 x = TileX0; x < TileX0 + TileWidth; ++x)
+            MaxDepth = FMath::Max(MaxDepth, DepthRow[x]);
+    }
+    TileMaxDepth[TileIndex] = MaxDepth;
+}
+
+bool FSoftwareOcclusion::IsBoxVisible(const FBoundingBox& Box) const
+{
+    float MinX = FLT_MAX, MinY = FLT_MAX, MaxX = -FLT_MAX, MaxY = -FLT_MAX;
+    float NearestZ = FLT_MAX;
+    for (int i = 0; i < 8; ++i)
+    {
+        const FVector Corner(
+            (i & 1) ? Box.max.x : Box.min.x,
+            (i & 2) ? Box.max.y : Box.min.y,
+            (i & 4) ? Box.max.z : Box.min.z);
+        const FScreenVertex V = ProjectToScreen(Corner, ViewProj);
+
+        // near 평면에 걸친 박스는 가릴 수 없음
+        if (!V.bValid)
+            return true;
+
+        MinX = FMath::Min(MinX, V.X);
+        MinY = FMath::Min(MinY, V.Y);
+        MaxX = FMath::Max(MaxX, V.X);
+        MaxY = FMath::Max(MaxY, V.Y);
+        NearestZ = FMath::Min(NearestZ, V.Z);
+    }
+
+    // 화면 밖 판정은 프러스텀 컬링 몫
+    const int32 X0 = FMath::Max(0, static_cast<int32>(std::floor(MinX)));
+    const int32 Y0 = FMath::Max(0, static_cast<int32>(std::floor(MinY)));
+    const int32 X1 = FMath::Min(Width - 1, static_cast<int32>(std::floor(MaxX)));
+    const int32 Y1 = FMath::Min(Height - 1, static_cast<int32>(std::floor(MaxY)));
+    if (X0 > X1 || Y0 > Y1)
+        return true;
+
+    const float* DepthData = Depth.GetData();
+    for (int32 TileY = Y0 / TileHeight; TileY <= Y1 / TileHeight; ++TileY)
+    {
+        for (int32 TileX = X0 / TileWidth; TileX <= X1 / TileWidth; ++TileX)
+        {
+            // 타일 전체가 박스보다 가깝게 덮여 있으면 픽셀 검사 생략
+            if (TileMaxDepth[TileY * TilesX + TileX] < NearestZ)
+                continue;
+
+            const int32 PX0 = FMath::Max(X0, TileX * TileWidth);
+            const int32 PX1 = FMath::Min(X1, TileX * TileWidth + TileWidth - 1);
+            const int32 PY0 = FMath::Max(Y0, TileY * TileHeight);
+            const int32 PY1 = FMath::Min(Y1, TileY * TileHeight + TileHeight - 1);
+
+#if USE_SIMD
+            const __m128 BoxZ = _mm_set1_ps(NearestZ);
+            const __m128i LaneIndex = _mm_set_epi32(3, 2, 1, 0);
+            const __m128i LaneMin = _mm_set1_epi32(PX0 - 1);
+            const __m128i LaneMax = _mm_set1_epi32(PX1 + 1);
+            for (int32 y = PY0; y <= PY1; ++y)
+            {
+                const float* DepthRow = DepthData + y * Width;
+                for (int32 x = PX0 & ~3; x <= PX1; x += 4)
+                {
+                    // 사각형 밖 레인은 제외
+                    const __m128i Lanes = _mm_add_epi32(_mm_set1_epi32(x), LaneIndex);
+                    const __m128 InRange = _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(Lanes, LaneMin), _mm_cmplt_epi32(Lanes, LaneMax)));
+                    const __m128 Behind = _mm_cmpge_ps(_mm_loadu_ps(DepthRow + x), BoxZ);
+                    if (_mm_movemask_ps(_mm_and_ps(InRange, Behind)))
+                        return true;
+                }
+            }
+#else
+            for (int32 y = PY0; y <= PY1; ++y)
+            {
+                const float* DepthRow = DepthData + y * Width;
+                for (int32 x = PX0; x <= PX1; ++x)
+                {
+                    if (DepthRow[x] >= NearestZ)
+                        return true;
+                }
+            }
+#endif
+        }
+    }
+    return false;
+}
+
+bool IsOctreeRegionVisible(int NodeId, const FBoundingBox& Bounds)
+{
+    if (GSoftwareOcclusion && GSoftwareOcclusion->IsActive())
+        return GSoftwareOcclusion->IsBoxVisible(Bounds);
+    return GOcclusionSystem->IsRegionVisible(NodeId);
+}
@@ -0,0 +1,67 @@
+// SoftwareOcclusion.h
+#pragma once
+
+#include "Define.h"
+
+class UStaticMeshComponent;
+
+// 오클루더 삼각형 하나의 화면 공간 셋업 결과
+struct FOccluderTriangle
+{
+    float EdgeA[3], EdgeB[3], EdgeC[3]; // 변 함수 E = A*x + B*y + C. 내부는 세 값 모두 0 이상
+    float DepthA, DepthB, DepthC;       // 깊이 평면 z = A*x + B*y + C (z/w, 0이 가까움)
+    int32 MinX, MinY, MaxX, MaxY;       // 픽셀 단위 화면 사각형 (Max 포함)
+};
+
+// CPU에서 저해상도 깊이 버퍼에 오클루더를 그리고 타일별 HiZ로 AABB 가시성을 바로 판정.
+// GPU 쿼리와 달리 같은 프레임에 결과가 나오므로 지연/팝핑이 없다.
+class FSoftwareOcclusion
+{
+public:
+    static constexpr int32 Width = 256;
+    static constexpr int32 Height = 128;
+    static constexpr int32 TileWidth = 32;
+    static constexpr int32 TileHeight = 16;
+    static constexpr int32 TilesX = Width / TileWidth;
+    static constexpr int32 TilesY = Height / TileHeight;
+
+    FSoftwareOcclusion();
+
+    //깊이 버퍼를 비우고 이번 프레임 ViewProjection 설정
+    void BeginFrame(const FMatrix& InViewProj);
+    //화면에서 큰 순서로 오클루더를 골라 Begin~End까지 수행. OrthoExtent는 직교 뷰의 화면 절반 높이(월드 단위), 원근이면 0
+    void RenderOccluders(const FVector& CameraPos, float OrthoExtent = 0.0f);
+
+    //메시 삼각형을 화면 공간으로 셋업해 타일에 분배. near 평면에 걸친 삼각형은 버림 (보수적)
+    void AddOccluder(const TArray<FVertexCompact>& Vertices, const TArray<UINT>& Indices, const FMatrix& ModelMatrix);
+    //타일별로 분배된 삼각형을 래스터화하고 HiZ 갱신
+    void EndFrame();
+
+    //AABB의 가장 가까운 깊이보다 더 가깝게 덮인 픽셀만 있으면 가려진 것
+    bool IsBoxVisible(const FBoundingBox& Box) const;
+    bool IsActive() const { return bEnabled && bFrameReady; }
+
+    bool bEnabled = false;
+    int32 MaxOccluders = 32;
+    int32 MaxOccluderTriangles = 20000;   // 프레임당 래스터화할 최대 삼각형 수
+    float MinOccluderScreenSize = 0.05f;  // 반지름/거리가 이보다 작으면 오클루더로 쓰지 않음
+
+    int32 NumOccluders = 0;
+    int32 NumTriangles = 0;
+
+private:
+    void RasterizeTile(int32 TileIndex);
+
+    FMatrix ViewProj;
+    bool bFrameReady = false;
+
+    TArray<float> Depth;                  // Width*Height, 행 우선. 1이 가장 멂
+    float TileMaxDepth[TilesX * TilesY];  // HiZ: 타일 내 최대 깊이
+    TArray<FOccluderTriangle> Triangles;
+    TArray<uint32> TileBins[TilesX * TilesY];
+};
+
+extern FSoftwareOcclusion* GSoftwareOcclusion;
+
+//GOcclusionSystem->IsRegionVisible 대신 사용. 소프트웨어 오클루전이 켜져 있으면 HiZ로 바로 판정
+bool IsOctreeRegionVisible(int NodeId, const FBoundingBox& Bounds);
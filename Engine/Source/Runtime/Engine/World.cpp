@@ -5,11 +5,13 @@
 #include "Camera/CameraComponent.h"
 #include "LevelEditor/SLevelEditor.h"
 #include "Engine/FLoaderOBJ.h"
+#include "Engine/MeshCluster.h"
 #include "Classes/Components/StaticMeshComponent.h"
 #include "Components/CubeComp.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/SkySphereComponent.h"
 #include "Components/SphereComp.h"
+#include "KDTree/BVH.h"
 #include "KDTree/KDTree.h"
 #include "KDTree/KDTreeSystem.h"
 #include "Octree/Octree.h"
@@ -30,7 +32,9 @@ void UWorld::Initialize()
     CreateBaseObject();
     BuildOctree();
     SceneKDTreeSystem = new FKDTreeSystem();
-    SceneKDTreeSystem->Build(SceneOctree->GetRoot()->Bounds);
+    SceneKDTreeSystem->Build();
+    SceneBVH = new FBVH();
+    SceneBVH->Build();
 }
 
 void UWorld::CreateBaseObject()
@@ -101,6 +105,15 @@ void UWorld::Tick(float DeltaTime)
     for (AActor* Actor : PendingBeginPlayActors)
     {
         Actor->BeginPlay();
+
+        // 마지막 빌드 이후 스폰된 메시도 BVH 피킹에 걸리게 함 (하이라이트 복제본은 제외)
+        if (!SceneBVH) continue;
+        for (UActorComponent* Component : Actor->GetComponents())
+        {
+            UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component);
+            if (MeshComp && MeshComp != HighlightedMeshComp)
+                SceneBVH->AddComponent(MeshComp);
+        }
     }
     PendingBeginPlayActors.Empty();
 
@@ -152,8 +165,31 @@ bool UWorld::DestroyActor(AActor* ThisActor)
     }
 
     TSet<UActorComponent*> Components = ThisActor->GetComponents();
+
+    // 파괴 표시 전에 옥트리(레코드, 리프, 루트 배치)에서 빼서 더 이상 그리지 않게 함. 액터 단위로 한 번에 압축/업로드
+    if (SceneOctree)
+    {
+        TArray<UPrimitiveComponent*> PrimComps;
+        for (UActorComponent* Component : Components)
+        {
+            if (UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(Component))
+                PrimComps.Add(PrimComp);
+        }
+        SceneOctree->RemoveComponents(PrimComps);
+    }
+
     for (UActorComponent* Component : Components)
     {
+        // 피킹 BVH에서도 빼서 해제된 컴포넌트를 반환하지 않게 함
+        UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Component);
+        if (MeshComp && SceneBVH)
+        {
+            SceneBVH->RemoveComponent(MeshComp);
+        }
+        if (MeshComp && SceneKDTreeSystem)
+        {
+            SceneKDTreeSystem->RemoveComponent(MeshComp);
+        }
         Component->DestroyComponent();
     }
 
@@ -188,7 +224,7 @@ void UWorld::SetHighlightedComponent(UStaticMeshComponent* OriginalMeshComp)
     SpawnedActor->SetActorLocation(OriginalMeshComp->GetOwner()->GetActorLocation());
     HighlightedMeshComp=apple;
 }
-void UWorld::RenderHighlightedComponent(FRenderer& Renderer, const FMatrix& VP)
+void UWorld::RenderHighlightedComponent(FRenderer& Renderer, const FMatrix& VP, const FVector& CameraLocation, const FVector& ViewDirection, bool bOrthographic)
 {
     if (!HighlightedMeshComp || !HighlightedMeshComp->GetStaticMesh()) return;
 
@@ -220,14 +256,38 @@ void UWorld::RenderHighlightedComponent(FRenderer& Renderer, const FMatrix& VP)
     FMatrix MVP = ModelMatrix * VP;
     FMatrix NormalMatrix = FMatrix::Transpose(FMatrix::Inverse(ModelMatrix));
     
+    // 클러스터가 있으면 보이는 구간만 그림.
+    // 일반 스태틱 메시는 옥트리 노드별로 월드 공간 정점을 머티리얼 배치에 합쳐 구간 단위로 그리므로
+    // 메시 인덱스 순서와 클러스터 구간이 남아 있지 않음. 그래서 메시 원본 버퍼로 그리는 이 패스에서만 씀
+    TArray<FMeshClusterRange> VisibleRanges;
+    const bool bClusterCulling = Renderer.bClusterCulling && !RenderData->Clusters.IsEmpty();
+    if (bClusterCulling)
+    {
+        FScopeCycleCounter ClusterCullTimer("ClusterCull");
+        FMeshClusterCuller::Cull(*RenderData, ModelMatrix, VP, CameraLocation, ViewDirection, bOrthographic, VisibleRanges);
+        FStatRegistry::RegisterResult(ClusterCullTimer);
+    }
+
     // 서브셋별 렌더링 (여러 머티리얼 처리)
-    for (const FMaterialSubset& Subset : Subsets)
+    for (int32 SubsetIndex = 0; SubsetIndex < Subsets.Num(); ++SubsetIndex)
     {
+        const FMaterialSubset& Subset = Subsets[SubsetIndex];
         const FObjMaterialInfo& MatInfo = Materials[Subset.MaterialIndex];
 
         Renderer.UpdateMaterial(MatInfo);
         Renderer.UpdateConstant(MVP, NormalMatrix, FVector4(0, 0, 0, 0), true); // ⭐ Highlight On
-        Renderer.Graphics->DeviceContext->DrawIndexed(Subset.IndexCount, Subset.IndexStart, 0);
+        if (!bClusterCulling)
+        {
+            Renderer.Graphics->DeviceContext->DrawIndexed(Subset.IndexCount, Subset.IndexStart, 0);
+            continue;
+        }
+        for (const FMeshClusterRange& Range : VisibleRanges)
+        {
+            if (Range.SubsetIndex == static_cast<uint32>(SubsetIndex))
+            {
+                Renderer.Graphics->DeviceContext->DrawIndexed(Range.IndexCount, Range.IndexStart, 0);
+            }
+        }
     }
     Renderer.UpdateConstant(MVP, NormalMatrix, FVector4(0, 0, 0, 0), false);
 
@@ -243,6 +303,23 @@ void UWorld::BuildOctree()
 }
 void UWorld::ClearScene()
 {
+    // 옥트리, BVH, KD 트리 시스템은 ReloadScene에서 새로 빌드하므로 먼저 버려서 액터마다 증분 제거하지 않게 함
+    if (SceneOctree)
+    {
+        delete SceneOctree;
+        SceneOctree = nullptr;
+    }
+    if (SceneBVH)
+    {
+        delete SceneBVH;
+        SceneBVH = nullptr;
+    }
+    if (SceneKDTreeSystem)
+    {
+        delete SceneKDTreeSystem;
+        SceneKDTreeSystem = nullptr;
+    }
+
     // 1. 모든 Actor Destroy
     for (UPrimitiveComponent* Prim : TObjectRange<UPrimitiveComponent>())
     {
@@ -283,5 +360,9 @@ void UWorld::ReloadScene(const FString& FileName)
     }
 
     SceneKDTreeSystem = new FKDTreeSystem();
-    SceneKDTreeSystem->Build(SceneOctree->GetRoot()->Bounds);
+    SceneKDTreeSystem->Build();
+
+    if (!SceneBVH)
+        SceneBVH = new FBVH();
+    SceneBVH->Build();
 }
@@ -6,6 +6,7 @@
 
 class FKDTreeSystem;
 class FKDTree;
+class FBVH;
 class FFrustum;
 class FOctree;
 class FObjectFactory;
@@ -64,6 +65,8 @@ public:
 
     FOctree* SceneOctree;
     FKDTreeSystem* SceneKDTreeSystem;
+    FBVH* SceneBVH = nullptr;
+    bool bUseBVHPicking = true; // 피킹을 옥트리 대신 SAH BVH로
     //FKDTree* SceneKDTree = nullptr;
     void BuildOctree();
     void ClearOctree();
@@ -88,7 +91,7 @@ public:
     void SetPickingGizmo(UObject* Object);
 
     void SetHighlightedComponent(UStaticMeshComponent* OriginalMeshComp);
-    void RenderHighlightedComponent(FRenderer& Renderer, const FMatrix& VP);
+    void RenderHighlightedComponent(FRenderer& Renderer, const FMatrix& VP, const FVector& CameraLocation, const FVector& ViewDirection, bool bOrthographic);
 
     UStaticMeshComponent* HighlightedMeshComp;
     void ClearScene();
@@ -73,6 +73,22 @@ struct FMaterialSubset
     FString MaterialName; // Material Name
 };
 
+// 메시 클러스터: 한 서브셋 안의 연속된 인덱스 구간. 클러스터 컬링 단위 (FMeshClusterBuilder)
+struct FMeshCluster
+{
+    uint32 IndexStart;
+    uint32 IndexCount;
+    uint32 SubsetIndex; // MaterialSubsets 인덱스 (서브셋이 없으면 0)
+    float Radius;       // 바운딩 구 반지름
+    FVector Center;     // 바운딩 구 중심
+    float ConeCutoff;   // 법선 콘 반각의 sin. 1이면 백페이스 컬링 안 함
+    FVector ConeAxis;   // 삼각형 법선 평균 방향
+    uint32 NumVertices;
+    FVector BoundsMin;
+    FVector BoundsMax;
+};
+static_assert(sizeof(FMeshCluster) == 72);
+
 struct FStaticMaterial
 {
     class UMaterial* Material;
@@ -194,6 +210,7 @@ namespace OBJ
 
         TArray<FObjMaterialInfo> Materials;
         TArray<FMaterialSubset> MaterialSubsets;
+        TArray<FMeshCluster> Clusters; // IndexStart 순. 비어 있으면 서브셋 전체를 그림
 
         FVector BoundingBoxMin;
         FVector BoundingBoxMax;
@@ -38,9 +38,6 @@ public:
 
 
     HWND hWnd;
-    
-    float firstLOD = 20.0f;
-    float SecondLOD = 20.0f;
 private:
     UImGuiManager* UIMgr;
     UWorld* GWorld;
@@ -25,6 +25,7 @@
 #include "Profiling/PlatformTime.h"
 #include "Profiling/StatRegistry.h"
 #include "Octree/OcclusionQuerySystem.h"
+#include "Octree/SoftwareOcclusion.h"
 
 void FRenderer::Initialize(FGraphicsDevice* graphics)
 {
@@ -38,6 +39,7 @@ void FRenderer::Initialize(FGraphicsDevice* graphics)
     UpdateLitUnlitConstant(1);
     CreateOcclusion();
     GOcclusionSystem = new OcclusionQuerySystem(Graphics->Device);
+    GSoftwareOcclusion = new FSoftwareOcclusion();
 }
 
 void FRenderer::Release()
@@ -320,11 +322,11 @@ ID3D11Buffer* FRenderer::CreateVertexBuffer(FVertexCompact* vertices, UINT byteW
     return vertexBuffer;
 }
 
-ID3D11Buffer* FRenderer::CreateVertexBuffer(const TArray<FVertexCompact>& vertices, UINT byteWidth)
+ID3D11Buffer* FRenderer::CreateVertexBuffer(const TArray<FVertexCompact>& vertices, UINT byteWidth, D3D11_USAGE Usage)
 {
     D3D11_BUFFER_DESC desc = {};
     desc.ByteWidth = byteWidth;
-    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.Usage = Usage;
     desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 
     D3D11_SUBRESOURCE_DATA initData = {};
@@ -378,10 +380,10 @@ ID3D11Buffer* FRenderer::CreateIndexBuffer(uint32* indices, UINT byteWidth) cons
     return indexBuffer;
 }
 
-ID3D11Buffer* FRenderer::CreateIndexBuffer(const TArray<uint32>& indices, UINT byteWidth) const
+ID3D11Buffer* FRenderer::CreateIndexBuffer(const TArray<uint32>& indices, UINT byteWidth, D3D11_USAGE Usage) const
 {
     D3D11_BUFFER_DESC indexbufferdesc = {}; // buffer�� ����, �뵵 ���� ����
-    indexbufferdesc.Usage = D3D11_USAGE_IMMUTABLE; // immutable: gpu�� �б� �������� ������ �� �ִ�.
+    indexbufferdesc.Usage = Usage; // immutable: gpu�� �б� �������� ������ �� �ִ�.
     indexbufferdesc.BindFlags = D3D11_BIND_INDEX_BUFFER; // index buffer�� ����ϰڴ�.
     indexbufferdesc.ByteWidth = byteWidth; // buffer ũ�� ����
 
@@ -618,6 +620,22 @@ void FRenderer::UpdateTextureConstant(float UOffset, float VOffset)
     }
 }
 
+void FRenderer::UpdateBufferRegion(ID3D11Buffer* Buffer, const void* Data, UINT ByteOffset, UINT ByteWidth) const
+{
+    if (!Buffer || ByteWidth == 0) return;
+
+    // 버퍼(1D)는 left/right만 바이트 단위로 사용
+    D3D11_BOX Box = {};
+    Box.left = ByteOffset;
+    Box.right = ByteOffset + ByteWidth;
+    Box.top = 0;
+    Box.bottom = 1;
+    Box.front = 0;
+    Box.back = 1;
+
+    Graphics->DeviceContext->UpdateSubresource(Buffer, 0, &Box, Data, 0, 0);
+}
+
 void FRenderer::CreateTextureShader()
 {
     ID3DBlob* vertextextureshaderCSO;
@@ -1154,18 +1172,32 @@ void FRenderer::RenderStaticMeshes(UWorld* World, std::shared_ptr<FEditorViewpor
     }
     FStatRegistry::RegisterResult(OcclusionTimer);
 
+    GSoftwareOcclusion->bEnabled = bSoftwareOcclusion;
+    if (bSoftwareOcclusion)
+    {
+        FScopeCycleCounter SoftwareOcclusionTimer("SoftwareOcclusion");
+        GSoftwareOcclusion->BeginFrame(ViewProj);
+        const float OrthoExtent = ActiveViewport->IsOrtho() ? FEditorViewportClient::orthoSize * 0.5f : 0.0f;
+        GSoftwareOcclusion->RenderOccluders(ActiveViewport->GetCameraWorldPosition(), OrthoExtent);
+        FStatRegistry::RegisterResult(SoftwareOcclusionTimer);
+    }
+
     FScopeCycleCounter CollectRender("Collect");
 
     TArray<FOctreeNode*> RenderNodes;
-    World->SceneOctree->GetRoot()->CollectRenderNodes(Frustum, RenderNodes);
+    TArray<FOctreeNode*> OwnRenderNodes;
+    // 오클루전 결과는 프레임마다 바뀌므로 꺼져 있을 때만 지난 프레임 결과 재사용
+    World->SceneOctree->CollectRenderNodes(Frustum, RenderNodes, &OwnRenderNodes, !bOcclusionCulling && !bSoftwareOcclusion);
     FStatRegistry::RegisterResult(CollectRender);
     // 2. 렌더링
     FScopeCycleCounter RenderCollected("RenderCollected");
-    RenderCollectedBatches(*this,View*Proj,RenderNodes,World->SceneOctree->GetRoot());
+    RenderCollectedBatches(*this,View*Proj,RenderNodes,OwnRenderNodes,World->SceneOctree->GetRoot());
     FStatRegistry::RegisterResult(RenderCollected);
     if (World->HighlightedMeshComp)
     {
-        World->RenderHighlightedComponent(*this, View * Proj);
+        // 뷰 행렬의 z축(세 번째 열)이 실제 시선 방향. 직교 뷰는 Pivot을 바라보도록 만들어짐
+        const FVector ViewDirection(View.M[0][2], View.M[1][2], View.M[2][2]);
+        World->RenderHighlightedComponent(*this, View * Proj, ActiveViewport->GetCameraWorldPosition(), ViewDirection, ActiveViewport->IsOrtho());
     }
     if (bDebugOctreeAABB)
         DebugRenderOctreeNode(&UPrimitiveBatch::GetInstance(), World->SceneOctree->GetRoot(), 5);
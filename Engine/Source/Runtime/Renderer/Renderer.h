@@ -74,11 +74,11 @@ public:
     void CreateLitUnlitBuffer();
     ID3D11Buffer* CreateVertexBuffer(FVertexSimple* vertices, UINT byteWidth) const;
     ID3D11Buffer* CreateVertexBuffer(const TArray<FVertexSimple>& vertices, UINT byteWidth) const;
-    ID3D11Buffer* CreateVertexBuffer(const TArray<FVertexCompact>& vertices, UINT byteWidth);
+    ID3D11Buffer* CreateVertexBuffer(const TArray<FVertexCompact>& vertices, UINT byteWidth, D3D11_USAGE Usage = D3D11_USAGE_IMMUTABLE);
     ID3D11Buffer* CreateVertexBuffer(FVertexCompact* vertices, UINT byteWidth) const;
 
     ID3D11Buffer* CreateIndexBuffer(uint32* indices, UINT byteWidth) const;
-    ID3D11Buffer* CreateIndexBuffer(const TArray<uint32>& indices, UINT byteWidth) const;
+    ID3D11Buffer* CreateIndexBuffer(const TArray<uint32>& indices, UINT byteWidth, D3D11_USAGE Usage = D3D11_USAGE_IMMUTABLE) const;
 
     // update
     void UpdateLightBuffer() const;
@@ -87,6 +87,8 @@ public:
     void UpdateLitUnlitConstant(int isLit) const;
     void UpdateSubMeshConstant(bool isSelected) const;
     void UpdateTextureConstant(float UOffset, float VOffset);
+    // D3D11_USAGE_DEFAULT 버퍼의 일부 구간만 갱신
+    void UpdateBufferRegion(ID3D11Buffer* Buffer, const void* Data, UINT ByteOffset, UINT ByteWidth) const;
 
 public://텍스쳐용 기능 추가
     ID3D11VertexShader* VertexTextureShader = nullptr;
@@ -174,6 +176,8 @@ public: // line shader
     bool bMaterialSort = true;
     bool bDebugOctreeAABB=false;
     bool bOcclusionCulling = false;
+    bool bSoftwareOcclusion = false; // CPU 래스터라이저 + HiZ로 같은 프레임에 오클루전 판정
+    bool bClusterCulling = true; // 컴포넌트 단위로 그리는 메시(하이라이트 패스)를 FMeshCluster 단위로 프러스텀/백페이스 컬링. 옥트리 배치 경로는 대상 아님
 
 private:
     TArray<UStaticMeshComponent*> StaticMeshObjs;